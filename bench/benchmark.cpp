@@ -0,0 +1,429 @@
+/* File: benchmark.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: a benchmark harness for the PathFinder. It times loading a vertices/edges pair, then
+ *          answers one random query set with each search mode and reports preprocessing time,
+ *          p50/p99/mean latency, throughput, settled vertices and a weight checksum per mode as
+ *          JSON on standard output, so runs can be compared by a script. Progress goes to stderr.
+ *
+ */
+
+ #include <iostream>
+ #include <fstream>
+ #include <sstream>
+ #include <string>
+ #include <vector>
+ #include <random>
+ #include <chrono>
+ #include <thread>
+ #include <atomic>
+ #include <functional>
+ #include <algorithm>
+ #include <cstdio>
+ #include "graph.h"
+ #include "fastloader.h"
+ #include "pathfinder.h"
+
+ using namespace std;
+
+ // Modes run when none are named
+ const char* const DEFAULT_MODES = "bfs,parallel-bfs,dijkstra-heap,dijkstra-radix,dijkstra-bucket,bibfs,bidijkstra,"
+                                   "bidijkstra-parallel,astar,alt,ch,alternatives,batch,snapshot";
+
+ // Landmarks built for the alt mode, and routes and queries for the alternatives mode
+ const int BENCH_LANDMARKS = 16;
+ const int BENCH_ALTERNATIVES = 4;
+ const size_t BENCH_ALTERNATIVE_QUERIES = 100;
+
+ // Contraction is cheap on road-like graphs but grows steeply on random ones (Erdos-Renyi, R-MAT),
+ // so modes that need a hierarchy give up on it after this long and are reported as skipped
+ const double BENCH_CH_BUDGET_SECONDS = 60.0;
+
+ // File the snapshot mode writes and reads back (removed afterwards)
+ const char* const BENCH_SNAPSHOT_FILE = "benchmark.snapshot";
+
+ // What one mode measured
+ struct ModeResult {
+     string mode;
+     double preprocessSeconds;
+     vector<double> latencies;  // Microseconds per query
+     double wallSeconds;        // Time for the whole query set
+     long long found;           // Queries with a path
+     long long settled;         // Vertices settled over all queries (-1 if the mode cannot count them)
+     long long weightSum;       // Total weight (or hops) of the paths found, to check modes against each other
+     SearchStats stats;         // Search statistics over all queries, when built with PATHFINDER_STATS
+     bool skipped;              // True if the mode's preprocessing ran over its budget, so no queries ran
+ };
+
+ // What the batch mode's threads share
+ struct BatchJob {
+     const vector<pair<string, string> >* queries;
+     atomic<size_t> next;
+     vector<double> latencies;
+     vector<long long> weights; // Path weight per query, -1 if none
+ };
+
+ // Helper to get the seconds since a start time
+ static double secondsSince(chrono::steady_clock::time_point start) {
+     return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+ }
+
+ // Helper to add up the weights along a path
+ static long long pathWeight(const CompactGraph& g, const vector<string>& path) {
+     long long weight = 0;
+     for (size_t i = 0; i + 1 < path.size(); i++) {
+         weight += g.getEdgeWeight(g.getVertexId(path[i]), g.getVertexId(path[i + 1]));
+     }
+     return weight;
+ }
+
+ // Worker of the batch mode: answers queries with Dijkstra on its own finder until none are left
+ static void batchWorker(PathFinder* finder, BatchJob& job) {
+     const CompactGraph& g = finder->getCompact();
+     while (true) {
+         size_t i = job.next.fetch_add(1);
+         if (i >= job.queries->size()) {
+             break;
+         }
+         chrono::steady_clock::time_point start = chrono::steady_clock::now();
+         vector<string> path = finder->findPath((*job.queries)[i].first, (*job.queries)[i].second, ALGORITHM_DIJKSTRA);
+         job.latencies[i] = secondsSince(start) * 1e6;
+         job.weights[i] = path.empty() ? -1 : pathWeight(g, path);
+     }
+ }
+
+ // Helper to answer every query with one algorithm, timing each
+ static void runQueries(PathFinder& finder, const vector<pair<string, string> >& queries, Algorithm algorithm,
+                        ModeResult& result) {
+     const CompactGraph& g = finder.getCompact();
+     bool weighted = PathFinder::isWeighted(algorithm);
+     result.settled = 0;
+     chrono::steady_clock::time_point wallStart = chrono::steady_clock::now();
+     for (size_t i = 0; i < queries.size(); i++) {
+         chrono::steady_clock::time_point start = chrono::steady_clock::now();
+         vector<string> path = finder.findPath(queries[i].first, queries[i].second, algorithm);
+         result.latencies.push_back(secondsSince(start) * 1e6);
+
+         // Counting settled vertices scans the workspaces, so it stays out of the timings
+         long long settled = finder.countSettled(algorithm);
+         result.settled = (settled < 0 || result.settled < 0) ? -1 : result.settled + settled;
+         if (StatsPolicy::ENABLED) {
+             result.stats.add(finder.getLastStats());
+         }
+         if (!path.empty()) {
+             result.found++;
+             result.weightSum += weighted ? pathWeight(g, path) : (long long)path.size() - 1;
+         }
+     }
+     result.wallSeconds = secondsSince(wallStart);
+ }
+
+ // Helper to run one mode on the master finder
+ static bool runMode(const string& mode, PathFinder& finder, const vector<pair<string, string> >& queries,
+                     int numThreads, ModeResult& result) {
+     result.mode = mode;
+     result.preprocessSeconds = 0.0;
+     result.wallSeconds = 0.0;
+     result.found = 0;
+     result.settled = -1;
+     result.weightSum = 0;
+     result.stats.clear();
+     result.skipped = false;
+     finder.setParallel(false);
+     finder.setQueueType(QUEUE_AUTO);
+
+     if (mode == "bfs") {
+         runQueries(finder, queries, ALGORITHM_BFS, result);
+     } else if (mode == "parallel-bfs") {
+         finder.setParallel(true);
+         runQueries(finder, queries, ALGORITHM_BFS, result);
+     } else if (mode == "dijkstra-heap" || mode == "dijkstra-radix" || mode == "dijkstra-bucket") {
+         QueueType type = (mode == "dijkstra-heap") ? QUEUE_DARY_HEAP : (mode == "dijkstra-radix") ? QUEUE_RADIX_HEAP : QUEUE_BUCKET;
+         finder.setQueueType(type);
+         runQueries(finder, queries, ALGORITHM_DIJKSTRA, result);
+     } else if (mode == "bibfs") {
+         runQueries(finder, queries, ALGORITHM_BIDIRECTIONAL_BFS, result);
+     } else if (mode == "bidijkstra") {
+         runQueries(finder, queries, ALGORITHM_BIDIRECTIONAL_DIJKSTRA, result);
+     } else if (mode == "bidijkstra-parallel") {
+         finder.setParallel(true);
+         runQueries(finder, queries, ALGORITHM_BIDIRECTIONAL_DIJKSTRA, result);
+     } else if (mode == "astar") {
+         runQueries(finder, queries, ALGORITHM_ASTAR, result);
+     } else if (mode == "alt") {
+         chrono::steady_clock::time_point start = chrono::steady_clock::now();
+         finder.prepareLandmarks(BENCH_LANDMARKS, LANDMARKS_FARTHEST, "");
+         result.preprocessSeconds = secondsSince(start);
+         runQueries(finder, queries, ALGORITHM_ALT, result);
+     } else if (mode == "ch") {
+         chrono::steady_clock::time_point start = chrono::steady_clock::now();
+         bool built = finder.prepareContractionHierarchy(BENCH_CH_BUDGET_SECONDS);
+         result.preprocessSeconds = secondsSince(start);
+         if (!built) {
+             cerr << "Skipping ch: contraction ran over " << BENCH_CH_BUDGET_SECONDS << " seconds" << endl;
+             result.skipped = true;
+             return true;
+         }
+         runQueries(finder, queries, ALGORITHM_CH, result);
+     } else if (mode == "alternatives") {
+         // Yen's algorithm is far slower per query, so it gets a prefix of the query set
+         const CompactGraph& g = finder.getCompact();
+         size_t count = min(queries.size(), BENCH_ALTERNATIVE_QUERIES);
+         chrono::steady_clock::time_point wallStart = chrono::steady_clock::now();
+         for (size_t i = 0; i < count; i++) {
+             chrono::steady_clock::time_point start = chrono::steady_clock::now();
+             vector<vector<string> > paths = finder.findKShortestPaths(queries[i].first, queries[i].second,
+                                                                       BENCH_ALTERNATIVES, numThreads);
+             result.latencies.push_back(secondsSince(start) * 1e6);
+             if (!paths.empty()) {
+                 result.found++;
+                 result.weightSum += pathWeight(g, paths.back());
+             }
+         }
+         result.wallSeconds = secondsSince(wallStart);
+     } else if (mode == "batch") {
+         // Worker finders answer the queries on every thread, as the navigator's batch mode does
+         BatchJob job;
+         job.queries = &queries;
+         job.next.store(0);
+         job.latencies.assign(queries.size(), 0.0);
+         job.weights.assign(queries.size(), -1);
+         vector<PathFinder*> finders;
+         for (int t = 0; t < numThreads; t++) {
+             finders.push_back(finder.createWorker());
+         }
+         chrono::steady_clock::time_point wallStart = chrono::steady_clock::now();
+         vector<thread> workers;
+         for (int t = 1; t < numThreads; t++) {
+             workers.push_back(thread(batchWorker, finders[t], ref(job)));
+         }
+         batchWorker(finders[0], job);
+         for (size_t t = 0; t < workers.size(); t++) {
+             workers[t].join();
+         }
+         result.wallSeconds = secondsSince(wallStart);
+         for (size_t t = 0; t < finders.size(); t++) {
+             delete finders[t];
+         }
+         result.latencies = job.latencies;
+         for (size_t i = 0; i < job.weights.size(); i++) {
+             if (job.weights[i] >= 0) {
+                 result.found++;
+                 result.weightSum += job.weights[i];
+             }
+         }
+     } else if (mode == "snapshot") {
+         // Save the graph with landmarks and a hierarchy of travel times, load it back and answer the
+         // queries from the mapped file; preprocessing that fails to survive the trip fails the run. A
+         // hierarchy that runs over its budget is left out of the trip
+         int numEdges = finder.getCompact().getNumEdges();
+         bool symmetric = !finder.getCompact().isDirected();
+         bool contracted = false;
+         if (symmetric) {
+             finder.setMetric(METRIC_TIME);
+             finder.prepareLandmarks(BENCH_LANDMARKS, LANDMARKS_FARTHEST, "");
+             contracted = finder.prepareContractionHierarchy(BENCH_CH_BUDGET_SECONDS);
+             finder.setMetric(METRIC_LENGTH);
+         }
+         chrono::steady_clock::time_point start = chrono::steady_clock::now();
+         bool loaded = finder.saveSnapshot(BENCH_SNAPSHOT_FILE) && finder.loadSnapshot(BENCH_SNAPSHOT_FILE);
+         result.preprocessSeconds = secondsSince(start);
+         if (!loaded) {
+             cerr << "Error: Could not save and load " << BENCH_SNAPSHOT_FILE << endl;
+             remove(BENCH_SNAPSHOT_FILE);
+             return false;
+         }
+         bool intact = finder.getCompact().getNumEdges() == numEdges;
+         if (symmetric) {
+             const Landmarks& landmarks = finder.getLandmarks();
+             const ContractionHierarchy& hierarchy = finder.getContractionHierarchy();
+             intact = intact && !landmarks.isEmpty() && landmarks.getMetric() == METRIC_TIME &&
+                      (!contracted || (!hierarchy.isEmpty() && hierarchy.getMetric() == METRIC_TIME));
+         }
+         if (intact) {
+             runQueries(finder, queries, ALGORITHM_DIJKSTRA, result);
+         }
+         finder.rebuild();
+         remove(BENCH_SNAPSHOT_FILE);
+         if (!intact) {
+             cerr << "Error: The snapshot did not keep the graph, landmarks and hierarchy it was saved with" << endl;
+             return false;
+         }
+     } else {
+         cerr << "Error: Unknown mode '" << mode << "'" << endl;
+         return false;
+     }
+     return true;
+ }
+
+ // Helper to write one mode's results as a JSON object
+ static void writeResult(ostream& out, const ModeResult& result) {
+     vector<double> sorted = result.latencies;
+     sort(sorted.begin(), sorted.end());
+     double p50 = 0.0;
+     double p99 = 0.0;
+     double mean = 0.0;
+     if (!sorted.empty()) {
+         p50 = sorted[sorted.size() / 2];
+         p99 = sorted[min(sorted.size() - 1, (size_t)(sorted.size() * 0.99))];
+         for (size_t i = 0; i < sorted.size(); i++) {
+             mean += sorted[i];
+         }
+         mean /= sorted.size();
+     }
+     double throughput = (result.wallSeconds > 0.0) ? sorted.size() / result.wallSeconds : 0.0;
+
+     out << "    {\"mode\": \"" << result.mode << "\""
+         << ", \"queries\": " << sorted.size()
+         << ", \"found\": " << result.found
+         << ", \"preprocess_seconds\": " << result.preprocessSeconds
+         << ", \"p50_us\": " << p50
+         << ", \"p99_us\": " << p99
+         << ", \"mean_us\": " << mean
+         << ", \"throughput_qps\": " << throughput
+         << ", \"settled_total\": " << result.settled
+         << ", \"settled_mean\": " << ((result.settled >= 0 && !sorted.empty()) ? (double)result.settled / sorted.size() : -1.0)
+         << ", \"weight_sum\": " << result.weightSum
+         << ", \"skipped\": " << (result.skipped ? "true" : "false");
+     if (StatsPolicy::ENABLED) {
+         const SearchStats& stats = result.stats;
+         out << ", \"relaxed_total\": " << stats.relaxed
+             << ", \"pushes\": " << stats.pushes
+             << ", \"decrease_keys\": " << stats.decreaseKeys
+             << ", \"pops\": " << stats.pops
+             << ", \"peak_queue\": " << stats.peakQueueSize
+             << ", \"setup_seconds\": " << stats.phaseSeconds[PHASE_SETUP]
+             << ", \"search_seconds\": " << stats.phaseSeconds[PHASE_SEARCH]
+             << ", \"path_seconds\": " << stats.phaseSeconds[PHASE_PATH];
+     }
+     out << "}";
+ }
+
+ // Usage: benchmark verticesFile edgesFile [--queries N] [--seed S] [--modes a,b,...] [--threads T]
+ //                  [--reorder bfs|rcm|hilbert]
+ int main(int argc, char* argv[]) {
+     if (argc < 3) {
+         cerr << "Usage: " << argv[0] << " verticesFile edgesFile [--queries N] [--seed S] [--modes a,b,...] [--threads T]"
+              << " [--reorder bfs|rcm|hilbert]" << endl;
+         cerr << "Modes: " << DEFAULT_MODES << endl;
+         return 1;
+     }
+     string verticesFile = argv[1];
+     string edgesFile = argv[2];
+     size_t numQueries = 1000;
+     unsigned int seed = 316;
+     string modeList = DEFAULT_MODES;
+     string ordering;
+     int numThreads = thread::hardware_concurrency();
+     try {
+         for (int i = 3; i + 1 < argc; i += 2) {
+             string option = argv[i];
+             if (option == "--queries") {
+                 numQueries = stoul(argv[i + 1]);
+             } else if (option == "--seed") {
+                 seed = stoul(argv[i + 1]);
+             } else if (option == "--modes") {
+                 modeList = argv[i + 1];
+             } else if (option == "--threads") {
+                 numThreads = stoi(argv[i + 1]);
+             } else if (option == "--reorder") {
+                 ordering = argv[i + 1];
+             } else {
+                 cerr << "Error: Unknown option " << option << endl;
+                 return 1;
+             }
+         }
+     } catch (const exception& e) {
+         cerr << "Error parsing arguments: " << e.what() << endl;
+         return 1;
+     }
+     if (numThreads <= 0) {
+         numThreads = 1;
+     }
+
+     // Load and freeze the graph, timing each step
+     Graph graph;
+     FastLoader loader(0);
+     chrono::steady_clock::time_point start = chrono::steady_clock::now();
+     if (!loader.loadVertices(verticesFile, graph) || !loader.loadEdges(edgesFile, graph)) {
+         cerr << "Error: Could not load " << verticesFile << " and " << edgesFile << endl;
+         return 1;
+     }
+     double loadSeconds = secondsSince(start);
+     PathFinder finder(graph);
+     start = chrono::steady_clock::now();
+     finder.rebuild();
+     double buildSeconds = secondsSince(start);
+     const CompactGraph& g = finder.getCompact();
+
+     // Random query pairs among the live vertices, the same for every mode
+     vector<VertexId> live;
+     for (VertexId v = 0; v < (VertexId)g.getNumVertices(); v++) {
+         if (g.isLive(v)) {
+             live.push_back(v);
+         }
+     }
+     if (live.empty()) {
+         cerr << "Error: The graph has no vertices" << endl;
+         return 1;
+     }
+     mt19937 random(seed);
+     vector<pair<string, string> > queries;
+     for (size_t i = 0; i < numQueries; i++) {
+         VertexId from = live[random() % live.size()];
+         VertexId to = live[random() % live.size()];
+         queries.push_back(make_pair(string(g.getName(from)), string(g.getName(to))));
+     }
+
+     // Renumber after the queries are drawn, so every ordering answers the same queries
+     double reorderSeconds = 0.0;
+     if (!ordering.empty()) {
+         VertexOrdering parsed;
+         if (!VertexOrder::parse(ordering, parsed)) {
+             cerr << "Error: Unknown ordering '" << ordering << "'" << endl;
+             return 1;
+         }
+         start = chrono::steady_clock::now();
+         if (!finder.reorderVertices(parsed)) {
+             return 1;
+         }
+         reorderSeconds = secondsSince(start);
+     }
+
+     // Run the modes
+     vector<ModeResult> results;
+     stringstream modes(modeList);
+     string mode;
+     while (getline(modes, mode, ',')) {
+         if (mode.empty()) {
+             continue;
+         }
+         cerr << "Running " << mode << "..." << endl;
+         ModeResult result;
+         if (!runMode(mode, finder, queries, numThreads, result)) {
+             return 1;
+         }
+         results.push_back(result);
+     }
+
+     // Report
+     cout << "{" << endl;
+     cout << "  \"graph\": {\"vertices_file\": \"" << verticesFile << "\", \"edges_file\": \"" << edgesFile << "\""
+          << ", \"vertices\": " << live.size() << ", \"edges\": " << g.getNumEdges()
+          << ", \"min_weight\": " << g.getMinWeight() << ", \"max_weight\": " << g.getMaxWeight()
+          << ", \"coordinates\": " << (g.hasCoordinates() ? "true" : "false") << "}," << endl;
+     cout << "  \"load_seconds\": " << loadSeconds << "," << endl;
+     cout << "  \"build_seconds\": " << buildSeconds << "," << endl;
+     cout << "  \"ordering\": \"" << (ordering.empty() ? "load" : ordering) << "\"," << endl;
+     cout << "  \"reorder_seconds\": " << reorderSeconds << "," << endl;
+     cout << "  \"seed\": " << seed << "," << endl;
+     cout << "  \"threads\": " << numThreads << "," << endl;
+     cout << "  \"results\": [" << endl;
+     for (size_t i = 0; i < results.size(); i++) {
+         writeResult(cout, results[i]);
+         cout << (i + 1 < results.size() ? "," : "") << endl;
+     }
+     cout << "  ]" << endl;
+     cout << "}" << endl;
+     return 0;
+ }
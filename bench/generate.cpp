@@ -0,0 +1,241 @@
+/* File: generate.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: a generator of synthetic graphs for benchmarking, written in the navigator's vertices
+ *          (name or name,x,y per line) and edges (from,to,weight per line) text formats. Grids and
+ *          random geometric graphs look like road networks and carry coordinates; Erdos-Renyi and
+ *          R-MAT graphs have the short diameters and skewed degrees of social and web graphs.
+ *
+ */
+
+ #include <iostream>
+ #include <fstream>
+ #include <string>
+ #include <vector>
+ #include <random>
+ #include <cmath>
+ #include <unordered_set>
+
+ using namespace std;
+
+ // Side of the square the coordinates of grids and geometric graphs are spread over
+ const double GENERATE_AREA = 100000.0;
+
+ // R-MAT quadrant probabilities (the Graph500 values); the fourth is what is left
+ const double RMAT_A = 0.57;
+ const double RMAT_B = 0.19;
+ const double RMAT_C = 0.19;
+
+ // A generated graph: whole-number vertex coordinates (empty when it has none), so the written file
+ // holds exactly what the weights were computed from, and undirected weighted edges
+ struct GeneratedGraph {
+     int numVertices;
+     vector<double> x;
+     vector<double> y;
+     vector<int> from;
+     vector<int> to;
+     vector<int> weights;
+ };
+
+ // Helper to add an edge once; the loader would keep only the first copy anyway
+ static void addEdge(GeneratedGraph& g, unordered_set<unsigned long long>& seen, int a, int b, int weight) {
+     if (a == b) {
+         return;
+     }
+     unsigned long long key = (a < b) ? ((unsigned long long)a << 32) | b : ((unsigned long long)b << 32) | a;
+     if (!seen.insert(key).second) {
+         return;
+     }
+     g.from.push_back(a);
+     g.to.push_back(b);
+     g.weights.push_back(weight);
+ }
+
+ // Helper to weigh an edge by the straight-line length between its ends, stretched by up to half
+ // again so routes have some variety; A* stays admissible since no weight is below the distance
+ static int lengthWeight(const GeneratedGraph& g, int a, int b, mt19937& random) {
+     double dx = g.x[a] - g.x[b];
+     double dy = g.y[a] - g.y[b];
+     double length = sqrt(dx * dx + dy * dy);
+     uniform_real_distribution<double> stretch(1.0, 1.5);
+     return (int)ceil(length * stretch(random)) + 1;
+ }
+
+ // A square grid with four neighbors per vertex
+ static void generateGrid(GeneratedGraph& g, int n, mt19937& random) {
+     int side = (int)ceil(sqrt((double)n));
+     double spacing = GENERATE_AREA / side;
+     g.numVertices = side * side;
+     for (int v = 0; v < g.numVertices; v++) {
+         g.x.push_back(floor((v % side) * spacing));
+         g.y.push_back(floor((v / side) * spacing));
+     }
+     unordered_set<unsigned long long> seen;
+     for (int v = 0; v < g.numVertices; v++) {
+         if (v % side + 1 < side) {
+             addEdge(g, seen, v, v + 1, lengthWeight(g, v, v + 1, random));
+         }
+         if (v + side < g.numVertices) {
+             addEdge(g, seen, v, v + side, lengthWeight(g, v, v + side, random));
+         }
+     }
+ }
+
+ // Points scattered uniformly, each joined to every point within the radius that gives about
+ // degree neighbors; a coarse grid of cells keeps the pairing near linear
+ static void generateGeometric(GeneratedGraph& g, int n, double degree, mt19937& random) {
+     g.numVertices = n;
+     uniform_real_distribution<double> coordinate(0.0, GENERATE_AREA);
+     for (int v = 0; v < n; v++) {
+         g.x.push_back(floor(coordinate(random)));
+         g.y.push_back(floor(coordinate(random)));
+     }
+     double radius = GENERATE_AREA * sqrt(degree / (M_PI * n));
+     int cells = (int)(GENERATE_AREA / radius);
+     if (cells < 1) {
+         cells = 1;
+     }
+     double cellSize = GENERATE_AREA / cells;
+     vector<vector<int> > buckets((size_t)cells * cells);
+     for (int v = 0; v < n; v++) {
+         int cx = min((int)(g.x[v] / cellSize), cells - 1);
+         int cy = min((int)(g.y[v] / cellSize), cells - 1);
+         buckets[(size_t)cy * cells + cx].push_back(v);
+     }
+
+     unordered_set<unsigned long long> seen;
+     for (int v = 0; v < n; v++) {
+         int cx = min((int)(g.x[v] / cellSize), cells - 1);
+         int cy = min((int)(g.y[v] / cellSize), cells - 1);
+         for (int ny = max(cy - 1, 0); ny <= min(cy + 1, cells - 1); ny++) {
+             for (int nx = max(cx - 1, 0); nx <= min(cx + 1, cells - 1); nx++) {
+                 const vector<int>& bucket = buckets[(size_t)ny * cells + nx];
+                 for (size_t i = 0; i < bucket.size(); i++) {
+                     int u = bucket[i];
+                     double dx = g.x[u] - g.x[v];
+                     double dy = g.y[u] - g.y[v];
+                     if (u > v && dx * dx + dy * dy <= radius * radius) {
+                         addEdge(g, seen, v, u, lengthWeight(g, v, u, random));
+                     }
+                 }
+             }
+         }
+     }
+ }
+
+ // Edges drawn uniformly at random until the average degree is reached
+ static void generateErdosRenyi(GeneratedGraph& g, int n, double degree, mt19937& random) {
+     g.numVertices = n;
+     long long numEdges = (long long)(n * degree / 2);
+     uniform_int_distribution<int> vertex(0, n - 1);
+     uniform_int_distribution<int> weight(1, 100);
+     unordered_set<unsigned long long> seen;
+     for (long long i = 0; i < numEdges; i++) {
+         addEdge(g, seen, vertex(random), vertex(random), weight(random));
+     }
+ }
+
+ // Recursive matrix graph: each edge picks a quadrant of the adjacency matrix level by level, which
+ // gives the power-law degrees of real networks. The vertex count is rounded up to a power of two
+ static void generateRMAT(GeneratedGraph& g, int n, double degree, mt19937& random) {
+     int scale = 0;
+     while ((1 << scale) < n) {
+         scale++;
+     }
+     g.numVertices = 1 << scale;
+     long long numEdges = (long long)(g.numVertices * degree / 2);
+     uniform_real_distribution<double> unit(0.0, 1.0);
+     uniform_int_distribution<int> weight(1, 100);
+     unordered_set<unsigned long long> seen;
+     for (long long i = 0; i < numEdges; i++) {
+         int a = 0;
+         int b = 0;
+         for (int level = 0; level < scale; level++) {
+             double p = unit(random);
+             int row = (p >= RMAT_A + RMAT_B) ? 1 : 0;
+             int col = (p >= RMAT_A && p < RMAT_A + RMAT_B) || p >= RMAT_A + RMAT_B + RMAT_C ? 1 : 0;
+             a = (a << 1) | row;
+             b = (b << 1) | col;
+         }
+         addEdge(g, seen, a, b, weight(random));
+     }
+ }
+
+ // Helper to write the vertices and edges files
+ static bool writeGraph(const GeneratedGraph& g, const string& prefix) {
+     string verticesFile = prefix + "Vertices.txt";
+     string edgesFile = prefix + "Edges.txt";
+     ofstream vertices(verticesFile);
+     ofstream edges(edgesFile);
+     if (!vertices.is_open() || !edges.is_open()) {
+         cerr << "Error: Could not open " << verticesFile << " or " << edgesFile << endl;
+         return false;
+     }
+     for (int v = 0; v < g.numVertices; v++) {
+         vertices << "v" << v;
+         if (!g.x.empty()) {
+             vertices << "," << (long long)g.x[v] << "," << (long long)g.y[v];
+         }
+         vertices << "\n";
+     }
+     for (size_t i = 0; i < g.from.size(); i++) {
+         edges << "v" << g.from[i] << ",v" << g.to[i] << "," << g.weights[i] << "\n";
+     }
+     if (!vertices || !edges) {
+         cerr << "Error: Could not write " << verticesFile << " or " << edgesFile << endl;
+         return false;
+     }
+     cout << "Wrote " << g.numVertices << " vertices to " << verticesFile << " and " << g.from.size()
+          << " edges to " << edgesFile << endl;
+     return true;
+ }
+
+ // Usage: generate grid|geometric|er|rmat numVertices outputPrefix [--degree D] [--seed S]
+ int main(int argc, char* argv[]) {
+     if (argc < 4) {
+         cerr << "Usage: " << argv[0] << " grid|geometric|er|rmat numVertices outputPrefix [--degree D] [--seed S]" << endl;
+         return 1;
+     }
+     string type = argv[1];
+     string prefix = argv[3];
+     int n = 0;
+     double degree = 6.0;
+     unsigned int seed = 316;
+     try {
+         n = stoi(argv[2]);
+         for (int i = 4; i + 1 < argc; i += 2) {
+             string option = argv[i];
+             if (option == "--degree") {
+                 degree = stod(argv[i + 1]);
+             } else if (option == "--seed") {
+                 seed = stoul(argv[i + 1]);
+             } else {
+                 cerr << "Error: Unknown option " << option << endl;
+                 return 1;
+             }
+         }
+     } catch (const exception& e) {
+         cerr << "Error parsing arguments: " << e.what() << endl;
+         return 1;
+     }
+     if (n < 2 || degree <= 0.0) {
+         cerr << "Error: Need at least 2 vertices and a positive degree" << endl;
+         return 1;
+     }
+
+     mt19937 random(seed);
+     GeneratedGraph g;
+     if (type == "grid") {
+         generateGrid(g, n, random);
+     } else if (type == "geometric") {
+         generateGeometric(g, n, degree, random);
+     } else if (type == "er") {
+         generateErdosRenyi(g, n, degree, random);
+     } else if (type == "rmat") {
+         generateRMAT(g, n, degree, random);
+     } else {
+         cerr << "Error: Unknown graph type '" << type << "'" << endl;
+         return 1;
+     }
+     return writeGraph(g, prefix) ? 0 : 1;
+ }
@@ -0,0 +1,110 @@
+/* File: bucketqueue.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the BucketQueue class.
+ *
+ */
+
+ #include "bucketqueue.h"
+
+ // Constructors
+ BucketQueue::BucketQueue(int maxWeight) : buckets((size_t)maxWeight + 1), current(0), liveCount(0) {}
+
+ BucketQueue::BucketQueue(int maxWeight, int capacity) : buckets((size_t)maxWeight + 1), current(0), liveCount(0) {
+     reserve(capacity);
+ }
+
+ // Make room for vertex IDs below capacity without growing on insert
+ void BucketQueue::reserve(int capacity) {
+     if (capacity > (int)keys.size()) {
+         keys.resize(capacity, -1);
+     }
+ }
+
+ // Insert a node with a priority between the last extracted key and that plus maxWeight
+ void BucketQueue::insert(VertexId node, int priority) {
+     if (priority < current || (size_t)(priority - current) >= buckets.size()) {
+         cout << "Error: Bucket queue key " << priority << " is outside the window of the queue" << endl;
+         return;
+     }
+     if (node >= keys.size()) {
+         keys.resize(node + 1, -1);
+     }
+     if (keys[node] < 0) {
+         liveCount++;
+     }
+
+     keys[node] = priority;
+     push(priority, node);
+ }
+
+ // Extract the minimum node from the queue
+ VertexId BucketQueue::extractMin() {
+     if (isEmpty()) {
+         cout << "Error: Cannot extract from an empty queue" << endl;
+         return INVALID_VERTEX;
+     }
+
+     // Scan forward from the current key; entries superseded by decreaseKey are dropped
+     while (true) {
+         vector<VertexId>& bucket = buckets[current % buckets.size()];
+         while (!bucket.empty()) {
+             VertexId node = bucket.back();
+             bucket.pop_back();
+             if (keys[node] == current) {
+                 keys[node] = -1;
+                 liveCount--;
+                 return node;
+             }
+         }
+         current++;
+     }
+ }
+
+ // Decrease the key of a node in the queue (the old entry is skipped lazily)
+ void BucketQueue::decreaseKey(VertexId node, int priority) {
+     // Check if the node exists in the queue
+     if (!contains(node)) {
+         cout << "Error: Node not found in the queue" << endl;
+         return;
+     }
+
+     // Only decrease if the new priority is smaller
+     if (priority < keys[node] && priority >= current) {
+         keys[node] = priority;
+         push(priority, node);
+     }
+ }
+
+ // Check if the queue is empty
+ bool BucketQueue::isEmpty() const {
+     return liveCount == 0;
+ }
+
+ // Check if the queue contains a node
+ bool BucketQueue::contains(VertexId node) const {
+     return node < keys.size() && keys[node] >= 0;
+ }
+
+ // Remove every node and reset the scan position to 0
+ void BucketQueue::clear() {
+     for (size_t i = 0; i < usedBuckets.size(); i++) {
+         vector<VertexId>& bucket = buckets[usedBuckets[i]];
+         for (size_t j = 0; j < bucket.size(); j++) {
+             keys[bucket[j]] = -1;
+         }
+         bucket.clear();
+     }
+     usedBuckets.clear();
+     current = 0;
+     liveCount = 0;
+ }
+
+ // Helper to add an entry to the bucket of its key, noting buckets that were empty
+ void BucketQueue::push(int priority, VertexId node) {
+     size_t index = priority % buckets.size();
+     if (buckets[index].empty()) {
+         usedBuckets.push_back(index);
+     }
+     buckets[index].push_back(node);
+ }
@@ -0,0 +1,57 @@
+/* File: bucketqueue.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the BucketQueue class, a Dial-style monotone priority queue.
+ *          With a maximum edge weight C, every key in the queue lies within C of the last
+ *          extracted key, so a circular array of C+1 buckets indexed by key holds them all.
+ *
+ */
+
+ #ifndef BUCKETQUEUE_H
+ #define BUCKETQUEUE_H
+ #include <iostream>
+ #include <vector>
+ #include "symboltable.h"
+
+ using namespace std;
+
+ class BucketQueue {
+     public:
+         // Constructors
+         BucketQueue(int maxWeight);
+         BucketQueue(int maxWeight, int capacity);
+
+         // Make room for vertex IDs below capacity without growing on insert
+         void reserve(int capacity);
+
+         // Insert a node with a priority between the last extracted key and that plus maxWeight
+         void insert(VertexId node, int priority);
+
+         // Extract the minimum node from the queue
+         VertexId extractMin();
+
+         // Decrease the key of a node in the queue (the old entry is skipped lazily)
+         void decreaseKey(VertexId node, int priority);
+
+         // Check if the queue is empty
+         bool isEmpty() const;
+
+         // Check if the queue contains a node
+         bool contains(VertexId node) const;
+
+         // Remove every node and reset the scan position to 0, in time proportional to the entries
+         // inserted since the last clear rather than the number of buckets
+         void clear();
+
+     private:
+         vector<vector<VertexId> > buckets; // buckets[key % buckets.size()]
+         vector<size_t> usedBuckets; // Buckets that became non-empty since the last clear
+         vector<int> keys; // Current key of each node in the queue, or -1 if absent
+         int current;      // Key of the bucket the scan is at; no live key is smaller
+         int liveCount;    // Number of nodes in the queue (stale entries are not counted)
+
+         // Helper to add an entry to the bucket of its key, noting buckets that were empty
+         void push(int priority, VertexId node);
+ };
+
+ #endif // BUCKETQUEUE_H
@@ -0,0 +1,687 @@
+/* File: compactgraph.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the CompactGraph class.
+ *
+ */
+
+ #include "compactgraph.h"
+ #include <algorithm>
+ #include <utility>
+ #include <cmath>
+ #include <cstring>
+
+ // Constructors
+ CompactGraph::CompactGraph() : metric(METRIC_LENGTH), reversed(false), shallow(false), symbols(nullptr) {
+     memset(&info, 0, sizeof(info));
+     memset(metricInfo, 0, sizeof(metricInfo));
+     shared_ptr<OwnedArrays> arrays = make_shared<OwnedArrays>();
+     arrays->arcs[0].offsets.push_back(0);
+     owned = arrays;
+     viewOwnedArrays();
+ }
+
+ CompactGraph::CompactGraph(const Graph& g) : metric(METRIC_LENGTH), reversed(false), shallow(false), symbols(nullptr) {
+     build(g);
+ }
+
+ // Copying shares the arrays, which are never written in place
+ CompactGraph::CompactGraph(const CompactGraph& other) {
+     *this = other;
+ }
+
+ CompactGraph& CompactGraph::operator=(const CompactGraph& other) {
+     if (this == &other) {
+         return *this;
+     }
+
+     // The shared pointers keep everything the views point into alive, so the views are copied as they are
+     info = other.info;
+     memcpy(metricInfo, other.metricInfo, sizeof(metricInfo));
+     owned = other.owned;
+     for (int d = 0; d < 2; d++) {
+         for (int m = 0; m < NUM_METRICS; m++) {
+             changedWeights[d][m] = other.changedWeights[d][m];
+         }
+         arcViews[d] = other.arcViews[d];
+     }
+     xView = other.xView;
+     yView = other.yView;
+     liveView = other.liveView;
+     shallow = other.shallow;
+     symbols = other.symbols;
+     nameOffsets = other.nameOffsets;
+     nameData = other.nameData;
+     nameOrder = other.nameOrder;
+     snapshot = other.snapshot;
+     select(other.metric, other.reversed);
+     return *this;
+ }
+
+ // View base's arcs weighted by metric, reversed if asked
+ CompactGraph::CompactGraph(const CompactGraph& base, Metric viewMetric, bool viewReversed)
+     : info(base.info), xView(base.xView), yView(base.yView), liveView(base.liveView), shallow(true),
+       symbols(base.symbols), nameOffsets(base.nameOffsets), nameData(base.nameData), nameOrder(base.nameOrder),
+       snapshot(base.snapshot) {
+     memcpy(metricInfo, base.metricInfo, sizeof(metricInfo));
+     arcViews[0] = base.arcViews[0];
+     arcViews[1] = base.arcViews[1];
+     select(viewMetric, viewReversed);
+ }
+
+ // Helper to point the views at the owned arrays
+ void CompactGraph::viewOwnedArrays() {
+     for (int d = 0; d < 2; d++) {
+         const ArcArrays& arrays = owned->arcs[d];
+         ArcViews& views = arcViews[d];
+         views.offsets = arrays.offsets.data();
+         views.targets = arrays.targets.data();
+         for (int m = 0; m < NUM_METRICS; m++) {
+             views.weights[m] = arrays.weights[m].data();
+         }
+         views.classes = arrays.classes.data();
+         views.twoWay = arrays.twoWay.empty() ? nullptr : arrays.twoWay.data();
+     }
+
+     // Without one-way edges every arc is its own reverse
+     if (!info.directed) {
+         arcViews[1] = arcViews[0];
+     }
+     xView = owned->xCoords.empty() ? nullptr : owned->xCoords.data();
+     yView = owned->yCoords.empty() ? nullptr : owned->yCoords.data();
+     liveView = owned->live.data();
+     nameOffsets = nullptr;
+     nameData = nullptr;
+     nameOrder = nullptr;
+     snapshot.reset();
+     select(metric, reversed);
+ }
+
+ // Helper to pick the accessors' arrays for a metric and direction
+ void CompactGraph::select(Metric newMetric, bool newReversed) {
+     metric = newMetric;
+     reversed = newReversed;
+     const ArcViews& views = arcViews[reversed ? 1 : 0];
+     offsetsView = views.offsets;
+     targetsView = views.targets;
+     weightsView = views.weights[metric];
+     classesView = views.classes;
+ }
+
+ // Rebuild the compact arrays from a graph
+ void CompactGraph::build(const Graph& g) {
+     // Vertex IDs are the graph's interned IDs, so names are shared rather than copied
+     symbols = &g.getSymbols();
+     int numIds = g.getIdBound();
+     shared_ptr<OwnedArrays> arrays = make_shared<OwnedArrays>();
+     arrays->live.assign(numIds, 0);
+     for (int i = 0; i < numIds; i++) {
+         if (g.getNode(VertexId(i))) {
+             arrays->live[i] = 1;
+         }
+     }
+
+     // The reversed arcs are only worth storing when some edge cannot be travelled both ways
+     memset(&info, 0, sizeof(info));
+     info.directed = g.hasOneWayEdges();
+     buildArcs(g, 0, arrays->arcs[0]);
+     if (info.directed) {
+         buildArcs(g, 1, arrays->arcs[1]);
+     }
+
+     // Copy coordinates; every vertex has them or none does
+     if (g.hasCoordinates()) {
+         arrays->xCoords.resize(numIds, 0.0);
+         arrays->yCoords.resize(numIds, 0.0);
+         for (int i = 0; i < numIds; i++) {
+             arrays->xCoords[i] = g.getX(i);
+             arrays->yCoords[i] = g.getY(i);
+         }
+     }
+
+     info.numVertices = numIds;
+     info.numArcs = arrays->arcs[0].targets.size();
+     info.hasCoordinates = !arrays->xCoords.empty();
+     metric = METRIC_LENGTH;
+     reversed = false;
+     shallow = false;
+     owned = arrays;
+     for (int d = 0; d < 2; d++) {
+         for (int m = 0; m < NUM_METRICS; m++) {
+             changedWeights[d][m].reset();
+         }
+     }
+     viewOwnedArrays();
+     for (int m = 0; m < NUM_METRICS; m++) {
+         computeWeightInfo(Metric(m));
+     }
+ }
+
+ // Helper to build one direction's arcs from the graph's edges, outgoing or incoming
+ void CompactGraph::buildArcs(const Graph& g, int direction, ArcArrays& out) {
+     int numIds = g.getIdBound();
+     size_t expected = 2 * g.getNumEdges();
+     out.offsets.clear();
+     out.targets.clear();
+     out.classes.clear();
+     out.twoWay.clear();
+     out.offsets.reserve(numIds + 1);
+     out.targets.reserve(expected);
+     out.classes.reserve(expected);
+     for (int m = 0; m < NUM_METRICS; m++) {
+         out.weights[m].clear();
+         out.weights[m].reserve(expected);
+     }
+
+     vector<pair<VertexId, EdgeId> > row;
+     out.offsets.push_back(0);
+     for (int i = 0; i < numIds; i++) {
+         const Node* node = g.getNode(VertexId(i));
+         if (node) {
+             // Every edge is listed at both ends; keep those that can be travelled the way this direction runs
+             const NeighborMap& neighbors = node->getNeighbors();
+             row.clear();
+             for (NeighborMap::const_iterator it = neighbors.begin(); it != neighbors.end(); ++it) {
+                 bool usable = (direction == 0) ? g.leadsFrom(it->second, i, it->first)
+                                                : g.leadsFrom(it->second, it->first, i);
+                 if (usable) {
+                     row.push_back(*it);
+                 }
+             }
+
+             // Sort each row so arcs are scanned in memory order and can be binary searched; parallel
+             // arcs sit side by side in edge order
+             sort(row.begin(), row.end());
+             for (size_t j = 0; j < row.size(); j++) {
+                 EdgeId e = row[j].second;
+                 out.targets.push_back(row[j].first);
+                 for (int m = 0; m < NUM_METRICS; m++) {
+                     out.weights[m].push_back(g.getEdgeMetric(e, Metric(m)));
+                 }
+                 out.classes.push_back(g.getEdgeClass(e));
+                 if (info.directed) {
+                     out.twoWay.push_back(!g.isOneWay(e));
+                 }
+             }
+         }
+         out.offsets.push_back(out.targets.size());
+     }
+ }
+
+ // Helper to record a metric's weight range and heuristic scales from the viewed arrays
+ void CompactGraph::computeWeightInfo(Metric m) {
+     const EdgeId* offsets = arcViews[0].offsets;
+     const VertexId* targets = arcViews[0].targets;
+     const int* weights = arcViews[0].weights[m];
+     MetricInfo& result = metricInfo[m];
+
+     // Record the weight range so the searches can pick a suitable priority queue
+     result.minWeight = 0;
+     result.maxWeight = 0;
+     for (EdgeId e = 0; e < info.numArcs; e++) {
+         if (e == 0 || weights[e] < result.minWeight) {
+             result.minWeight = weights[e];
+         }
+         if (e == 0 || weights[e] > result.maxWeight) {
+             result.maxWeight = weights[e];
+         }
+     }
+
+     // Find how far distances can be scaled while staying below every weight; the reversed arcs are
+     // the same arcs, so the scales hold both ways
+     double euclideanScale = 0.0;
+     double manhattanScale = 0.0;
+     if (info.hasCoordinates) {
+         bool first = true;
+         for (VertexId v = 0; v < info.numVertices; v++) {
+             for (EdgeId e = offsets[v]; e < offsets[v + 1]; e++) {
+                 double dx = fabs(xView[v] - xView[targets[e]]);
+                 double dy = fabs(yView[v] - yView[targets[e]]);
+                 double euclidean = sqrt(dx * dx + dy * dy);
+                 double manhattan = dx + dy;
+                 if (euclidean > 0.0 && (first || weights[e] / euclidean < euclideanScale)) {
+                     euclideanScale = weights[e] / euclidean;
+                 }
+                 if (manhattan > 0.0 && (first || weights[e] / manhattan < manhattanScale)) {
+                     manhattanScale = weights[e] / manhattan;
+                 }
+                 if (euclidean > 0.0) {
+                     first = false;
+                 }
+             }
+         }
+
+         // Leave a little room for rounding so the heuristics never overestimate
+         euclideanScale = (euclideanScale > 0.0) ? euclideanScale * (1.0 - 1e-9) : 0.0;
+         manhattanScale = (manhattanScale > 0.0) ? manhattanScale * (1.0 - 1e-9) : 0.0;
+     }
+     result.euclideanScale = euclideanScale;
+     result.manhattanScale = manhattanScale;
+ }
+
+ // Change the weights of existing edges in place, every arc of each edge that leads the updated way
+ bool CompactGraph::updateEdgeWeights(const vector<WeightUpdate>& updates) {
+     // Check every update first so a missing edge leaves the weights untouched
+     for (size_t i = 0; i < updates.size(); i++) {
+         const WeightUpdate& update = updates[i];
+         if (!isLive(update.from) || !isLive(update.to) || findArc(0, update.from, update.to) == info.numArcs) {
+             cerr << "Error: There is no edge from '" << getName(update.from) << "' to '"
+                  << getName(update.to) << "'" << endl;
+             return false;
+         }
+     }
+
+     // Built and mapped weights are never written, and changed ones may be held by copies of the graph
+     // (published versions), so a metric's weights are copied before a change unless only this graph
+     // holds them. Copies are only made and dropped by the thread that updates, so the count is exact
+     int numDirections = info.directed ? 2 : 1;
+     for (size_t i = 0; i < updates.size(); i++) {
+         Metric m = updates[i].metric;
+         for (int d = 0; d < numDirections; d++) {
+             shared_ptr<vector<int> >& weights = changedWeights[d][m];
+             if ((!weights || weights.use_count() > 1) && info.numArcs > 0) {
+                 weights = make_shared<vector<int> >(arcViews[d].weights[m], arcViews[d].weights[m] + info.numArcs);
+                 arcViews[d].weights[m] = weights->data();
+             }
+         }
+     }
+     if (!info.directed) {
+         arcViews[1] = arcViews[0];
+     }
+
+     // An update changes the arcs from -> to and, for two-way edges, the arcs back; a reversed arc
+     // from -> to lives in the row of to
+     bool rescan[NUM_METRICS] = {false};
+     for (size_t i = 0; i < updates.size(); i++) {
+         const WeightUpdate& update = updates[i];
+         Metric m = update.metric;
+         setArcWeights(0, update.from, update.to, false, m, update.weight, rescan[m]);
+         if (update.from != update.to) {
+             setArcWeights(0, update.to, update.from, true, m, update.weight, rescan[m]);
+         }
+         if (info.directed) {
+             setArcWeights(1, update.to, update.from, false, m, update.weight, rescan[m]);
+             if (update.from != update.to) {
+                 setArcWeights(1, update.from, update.to, true, m, update.weight, rescan[m]);
+             }
+         }
+     }
+     select(metric, reversed);
+
+     // Only moving an extreme weight inward needs a full scan; otherwise the range just widens. An edge
+     // updated twice in the batch counts with its final weight, read back from its arcs
+     for (size_t i = 0; i < updates.size(); i++) {
+         const WeightUpdate& update = updates[i];
+         Metric m = update.metric;
+         if (rescan[m]) {
+             continue;
+         }
+         MetricInfo& range = metricInfo[m];
+         const int* weights = arcViews[0].weights[m];
+         for (int side = 0; side < 2; side++) {
+             VertexId row = (side == 0) ? update.from : update.to;
+             VertexId target = (side == 0) ? update.to : update.from;
+             for (EdgeId e = findArc(0, row, target); e < arcViews[0].offsets[row + 1] && arcViews[0].targets[e] == target; e++) {
+                 int weight = weights[e];
+                 if (weight < range.minWeight) {
+                     range.minWeight = weight;
+                 }
+                 if (weight > range.maxWeight) {
+                     range.maxWeight = weight;
+                 }
+
+                 // A lighter edge can only shrink the heuristic scales; a heavier one leaves them admissible
+                 if (info.hasCoordinates) {
+                     double dx = fabs(xView[update.from] - xView[update.to]);
+                     double dy = fabs(yView[update.from] - yView[update.to]);
+                     double euclidean = sqrt(dx * dx + dy * dy);
+                     double manhattan = dx + dy;
+                     if (euclidean > 0.0 && weight / euclidean * (1.0 - 1e-9) < range.euclideanScale) {
+                         range.euclideanScale = max(weight / euclidean * (1.0 - 1e-9), 0.0);
+                     }
+                     if (manhattan > 0.0 && weight / manhattan * (1.0 - 1e-9) < range.manhattanScale) {
+                         range.manhattanScale = max(weight / manhattan * (1.0 - 1e-9), 0.0);
+                     }
+                 }
+             }
+         }
+     }
+     for (int m = 0; m < NUM_METRICS; m++) {
+         if (rescan[m]) {
+             computeWeightInfo(Metric(m));
+         }
+     }
+     return true;
+ }
+
+ // Helper to change the weights of the arcs in one row that lead to target
+ void CompactGraph::setArcWeights(int direction, VertexId row, VertexId target, bool twoWayOnly, Metric m,
+                                  int weight, bool& rescan) {
+     const ArcViews& views = arcViews[direction];
+     vector<int>& weights = *changedWeights[direction][m];
+     for (EdgeId e = findArc(direction, row, target); e < views.offsets[row + 1] && views.targets[e] == target; e++) {
+         if (twoWayOnly && views.twoWay && !views.twoWay[e]) {
+             continue;
+         }
+         int oldWeight = weights[e];
+         if (oldWeight != weight && (oldWeight == metricInfo[m].minWeight || oldWeight == metricInfo[m].maxWeight)) {
+             rescan = true;
+         }
+         weights[e] = weight;
+     }
+ }
+
+ // Helper to find the first arc from one vertex to another in a direction
+ EdgeId CompactGraph::findArc(int direction, VertexId from, VertexId to) const {
+     const ArcViews& views = arcViews[direction];
+     const VertexId* first = views.targets + views.offsets[from];
+     const VertexId* last = views.targets + views.offsets[from + 1];
+     const VertexId* it = lower_bound(first, last, to);
+     if (it == last || *it != to) {
+         return info.numArcs;
+     }
+     return it - views.targets;
+ }
+
+ // Add the graph's sections, including its names, to a snapshot
+ void CompactGraph::writeSnapshot(SnapshotWriter& writer) const {
+     size_t n = info.numVertices;
+     size_t m = info.numArcs;
+
+     // The info section keeps the length range and scales, as files without metrics expect
+     Info* stored = (Info*)writer.allocateSection(SECTION_GRAPH_INFO, sizeof(Info));
+     *stored = info;
+     stored->minWeight = metricInfo[METRIC_LENGTH].minWeight;
+     stored->maxWeight = metricInfo[METRIC_LENGTH].maxWeight;
+     stored->euclideanScale = metricInfo[METRIC_LENGTH].euclideanScale;
+     stored->manhattanScale = metricInfo[METRIC_LENGTH].manhattanScale;
+     writer.addSection(SECTION_OFFSETS, arcViews[0].offsets, (n + 1) * sizeof(EdgeId));
+     writer.addSection(SECTION_TARGETS, arcViews[0].targets, m * sizeof(VertexId));
+     writer.addSection(SECTION_WEIGHTS, arcViews[0].weights[METRIC_LENGTH], m * sizeof(int));
+     writer.addSection(SECTION_LIVE, liveView, n);
+     if (info.hasCoordinates) {
+         writer.addSection(SECTION_X_COORDS, xView, n * sizeof(double));
+         writer.addSection(SECTION_Y_COORDS, yView, n * sizeof(double));
+     }
+
+     // The other metrics follow the lengths, one whole array after another
+     writer.addSection(SECTION_METRIC_INFO, metricInfo, sizeof(metricInfo));
+     int* otherWeights = (int*)writer.allocateSection(SECTION_METRIC_WEIGHTS, (NUM_METRICS - 1) * m * sizeof(int));
+     for (int k = 1; k < NUM_METRICS; k++) {
+         memcpy(otherWeights + (k - 1) * m, arcViews[0].weights[k], m * sizeof(int));
+     }
+     writer.addSection(SECTION_CLASSES, arcViews[0].classes, m);
+     if (info.directed) {
+         writer.requireVersion(SNAPSHOT_VERSION_ONE_WAY);
+         writer.addSection(SECTION_TWO_WAY, arcViews[0].twoWay, m);
+         writer.addSection(SECTION_REVERSE_OFFSETS, arcViews[1].offsets, (n + 1) * sizeof(EdgeId));
+         writer.addSection(SECTION_REVERSE_TARGETS, arcViews[1].targets, m * sizeof(VertexId));
+         int* reverseWeights = (int*)writer.allocateSection(SECTION_REVERSE_WEIGHTS, NUM_METRICS * m * sizeof(int));
+         for (int k = 0; k < NUM_METRICS; k++) {
+             memcpy(reverseWeights + k * m, arcViews[1].weights[k], m * sizeof(int));
+         }
+         writer.addSection(SECTION_REVERSE_CLASSES, arcViews[1].classes, m);
+         writer.addSection(SECTION_REVERSE_TWO_WAY, arcViews[1].twoWay, m);
+     }
+
+     // String table: every name back to back, with offsets and an index sorted by name
+     uint64_t* newOffsets = (uint64_t*)writer.allocateSection(SECTION_NAME_OFFSETS, (n + 1) * sizeof(uint64_t));
+     newOffsets[0] = 0;
+     for (size_t v = 0; v < n; v++) {
+         newOffsets[v + 1] = newOffsets[v] + getName(v).size();
+     }
+     char* newData = writer.allocateSection(SECTION_NAME_DATA, newOffsets[n]);
+     vector<pair<string_view, VertexId> > sorted(n);
+     for (size_t v = 0; v < n; v++) {
+         string_view name = getName(v);
+         memcpy(newData + newOffsets[v], name.data(), name.size());
+         sorted[v] = make_pair(name, VertexId(v));
+     }
+     sort(sorted.begin(), sorted.end());
+     VertexId* newOrder = (VertexId*)writer.allocateSection(SECTION_NAME_ORDER, n * sizeof(VertexId));
+     for (size_t i = 0; i < n; i++) {
+         newOrder[i] = sorted[i].second;
+     }
+ }
+
+ // View the graph stored in a mapped snapshot without copying or parsing it
+ bool CompactGraph::loadSnapshot(const shared_ptr<Snapshot>& mapped) {
+     size_t infoSize, offsetsSize, targetsSize, weightsSize, liveSize, xSize, ySize;
+     size_t nameOffsetsSize, nameDataSize, nameOrderSize;
+     size_t metricInfoSize, metricWeightsSize, classesSize, twoWaySize;
+     size_t reverseOffsetsSize, reverseTargetsSize, reverseWeightsSize, reverseClassesSize, reverseTwoWaySize;
+     const Info* newInfo = (const Info*)mapped->getSection(SECTION_GRAPH_INFO, infoSize);
+     const EdgeId* newOffsets = (const EdgeId*)mapped->getSection(SECTION_OFFSETS, offsetsSize);
+     const VertexId* newTargets = (const VertexId*)mapped->getSection(SECTION_TARGETS, targetsSize);
+     const int* newWeights = (const int*)mapped->getSection(SECTION_WEIGHTS, weightsSize);
+     const unsigned char* newLive = (const unsigned char*)mapped->getSection(SECTION_LIVE, liveSize);
+     const double* newX = (const double*)mapped->getSection(SECTION_X_COORDS, xSize);
+     const double* newY = (const double*)mapped->getSection(SECTION_Y_COORDS, ySize);
+     const uint64_t* newNameOffsets = (const uint64_t*)mapped->getSection(SECTION_NAME_OFFSETS, nameOffsetsSize);
+     const char* newNameData = (const char*)mapped->getSection(SECTION_NAME_DATA, nameDataSize);
+     const VertexId* newNameOrder = (const VertexId*)mapped->getSection(SECTION_NAME_ORDER, nameOrderSize);
+     const MetricInfo* newMetricInfo = (const MetricInfo*)mapped->getSection(SECTION_METRIC_INFO, metricInfoSize);
+     const int* newMetricWeights = (const int*)mapped->getSection(SECTION_METRIC_WEIGHTS, metricWeightsSize);
+     const EdgeClass* newClasses = (const EdgeClass*)mapped->getSection(SECTION_CLASSES, classesSize);
+     const unsigned char* newTwoWay = (const unsigned char*)mapped->getSection(SECTION_TWO_WAY, twoWaySize);
+     const EdgeId* newReverseOffsets = (const EdgeId*)mapped->getSection(SECTION_REVERSE_OFFSETS, reverseOffsetsSize);
+     const VertexId* newReverseTargets = (const VertexId*)mapped->getSection(SECTION_REVERSE_TARGETS, reverseTargetsSize);
+     const int* newReverseWeights = (const int*)mapped->getSection(SECTION_REVERSE_WEIGHTS, reverseWeightsSize);
+     const EdgeClass* newReverseClasses = (const EdgeClass*)mapped->getSection(SECTION_REVERSE_CLASSES, reverseClassesSize);
+     const unsigned char* newReverseTwoWay = (const unsigned char*)mapped->getSection(SECTION_REVERSE_TWO_WAY, reverseTwoWaySize);
+
+     // Check the sizes against the counts once, so the accessors never have to
+     if (!newInfo || infoSize != sizeof(Info)) {
+         cerr << "Error: Snapshot has no graph" << endl;
+         return false;
+     }
+     size_t n = newInfo->numVertices;
+     size_t m = newInfo->numArcs;
+     bool valid = newOffsets && offsetsSize == (n + 1) * sizeof(EdgeId) && newOffsets[n] == m &&
+                  newTargets && targetsSize == m * sizeof(VertexId) &&
+                  newWeights && weightsSize == m * sizeof(int) &&
+                  newLive && liveSize == n &&
+                  newNameOffsets && nameOffsetsSize == (n + 1) * sizeof(uint64_t) && newNameOffsets[n] <= nameDataSize &&
+                  newNameOrder && nameOrderSize == n * sizeof(VertexId);
+     if (valid && newInfo->hasCoordinates) {
+         valid = newX && xSize == n * sizeof(double) && newY && ySize == n * sizeof(double);
+     }
+
+     // Files from before metrics have lengths only; one that has the other metrics must have all of them
+     bool hasMetrics = newMetricInfo || newMetricWeights || newClasses;
+     if (valid && hasMetrics) {
+         valid = newMetricInfo && metricInfoSize == sizeof(metricInfo) &&
+                 newMetricWeights && metricWeightsSize == (NUM_METRICS - 1) * m * sizeof(int) &&
+                 newClasses && classesSize == m;
+     }
+     if (valid && newInfo->directed) {
+         valid = mapped->getVersion() >= SNAPSHOT_VERSION_ONE_WAY && hasMetrics && newTwoWay && twoWaySize == m &&
+                 newReverseOffsets && reverseOffsetsSize == (n + 1) * sizeof(EdgeId) && newReverseOffsets[n] == m &&
+                 newReverseTargets && reverseTargetsSize == m * sizeof(VertexId) &&
+                 newReverseWeights && reverseWeightsSize == NUM_METRICS * m * sizeof(int) &&
+                 newReverseClasses && reverseClassesSize == m &&
+                 newReverseTwoWay && reverseTwoWaySize == m;
+     }
+     if (!valid) {
+         cerr << "Error: Snapshot graph sections are inconsistent" << endl;
+         return false;
+     }
+
+     // Drop any owned arrays and view the mapping instead
+     info = *newInfo;
+     owned.reset();
+     for (int d = 0; d < 2; d++) {
+         for (int k = 0; k < NUM_METRICS; k++) {
+             changedWeights[d][k].reset();
+         }
+     }
+     ArcViews& forward = arcViews[0];
+     forward.offsets = newOffsets;
+     forward.targets = newTargets;
+     forward.weights[METRIC_LENGTH] = newWeights;
+     forward.twoWay = info.directed ? newTwoWay : nullptr;
+     if (hasMetrics) {
+         memcpy(metricInfo, newMetricInfo, sizeof(metricInfo));
+         for (int k = 1; k < NUM_METRICS; k++) {
+             forward.weights[k] = newMetricWeights + (k - 1) * m;
+         }
+         forward.classes = newClasses;
+     } else {
+         // Every metric reads the lengths, and every arc is of class 0
+         for (int k = 0; k < NUM_METRICS; k++) {
+             metricInfo[k].minWeight = info.minWeight;
+             metricInfo[k].maxWeight = info.maxWeight;
+             metricInfo[k].euclideanScale = info.euclideanScale;
+             metricInfo[k].manhattanScale = info.manhattanScale;
+             forward.weights[k] = newWeights;
+         }
+         shared_ptr<OwnedArrays> arrays = make_shared<OwnedArrays>();
+         arrays->arcs[0].classes.assign(m, 0);
+         forward.classes = arrays->arcs[0].classes.data();
+         owned = arrays;
+     }
+     if (info.directed) {
+         ArcViews& backward = arcViews[1];
+         backward.offsets = newReverseOffsets;
+         backward.targets = newReverseTargets;
+         for (int k = 0; k < NUM_METRICS; k++) {
+             backward.weights[k] = newReverseWeights + k * m;
+         }
+         backward.classes = newReverseClasses;
+         backward.twoWay = newReverseTwoWay;
+     } else {
+         arcViews[1] = forward;
+     }
+     liveView = newLive;
+     xView = info.hasCoordinates ? newX : nullptr;
+     yView = info.hasCoordinates ? newY : nullptr;
+     symbols = nullptr;
+     nameOffsets = newNameOffsets;
+     nameData = newNameData;
+     nameOrder = newNameOrder;
+     snapshot = mapped;
+     shallow = false;
+     select(METRIC_LENGTH, false);
+     return true;
+ }
+
+ // Get the number of vertex IDs (one past the largest; removed nodes are empty rows)
+ int CompactGraph::getNumVertices() const {
+     return info.numVertices;
+ }
+
+ // Get the number of directed arcs (each two-way edge is stored twice)
+ int CompactGraph::getNumArcs() const {
+     return info.numArcs;
+ }
+
+ // Count the edges behind the arcs: a two-way edge is stored as two arcs unless it is a
+ // self-loop, while a one-way edge is stored as one
+ int CompactGraph::getNumEdges() const {
+     const ArcViews& forward = arcViews[0];
+     int numVertices = info.numVertices;
+     int single = 0;
+     int paired = 0;
+     for (VertexId v = 0; v < (VertexId)numVertices; v++) {
+         for (EdgeId e = forward.offsets[v]; e < forward.offsets[v + 1]; e++) {
+             if ((forward.twoWay && !forward.twoWay[e]) || forward.targets[e] == v) {
+                 single++;
+             } else {
+                 paired++;
+             }
+         }
+     }
+     return single + paired / 2;
+ }
+
+ // Check if any edge is one-way
+ bool CompactGraph::isDirected() const {
+     return info.directed != 0;
+ }
+
+ // Get the metric and direction this graph or view reads
+ Metric CompactGraph::getMetric() const {
+     return metric;
+ }
+
+ bool CompactGraph::isReversed() const {
+     return reversed;
+ }
+
+ // Get the smallest and largest arc weights of the metric (0 for a graph without edges)
+ int CompactGraph::getMinWeight() const {
+     return metricInfo[metric].minWeight;
+ }
+
+ int CompactGraph::getMaxWeight() const {
+     return metricInfo[metric].maxWeight;
+ }
+
+ // Check if every vertex has coordinates
+ bool CompactGraph::hasCoordinates() const {
+     return info.hasCoordinates != 0;
+ }
+
+ // Largest factors by which straight-line and Manhattan distances can be scaled without
+ // exceeding any edge weight, so scaled distances are admissible A* heuristics
+ double CompactGraph::getEuclideanScale() const {
+     return metricInfo[metric].euclideanScale;
+ }
+
+ double CompactGraph::getManhattanScale() const {
+     return metricInfo[metric].manhattanScale;
+ }
+
+ // Check if an ID belongs to a vertex of the graph (false for removed nodes)
+ bool CompactGraph::isLive(VertexId v) const {
+     return v < info.numVertices && liveView[v];
+ }
+
+ // Look up the ID of a vertex name (INVALID_VERTEX if not found)
+ VertexId CompactGraph::getVertexId(const string& name) const {
+     VertexId id = INVALID_VERTEX;
+     if (symbols) {
+         id = symbols->lookup(name);
+     } else if (nameOrder) {
+         // Binary search the snapshot's sorted name index
+         size_t low = 0;
+         size_t high = info.numVertices;
+         while (low < high) {
+             size_t middle = low + (high - low) / 2;
+             int comparison = getName(nameOrder[middle]).compare(name);
+             if (comparison == 0) {
+                 id = nameOrder[middle];
+                 break;
+             } else if (comparison < 0) {
+                 low = middle + 1;
+             } else {
+                 high = middle;
+             }
+         }
+     }
+
+     // Names interned after the build, or whose node was removed, are not in this view
+     if (!isLive(id)) {
+         return INVALID_VERTEX;
+     }
+     return id;
+ }
+
+ // Get the name of a vertex
+ string_view CompactGraph::getName(VertexId v) const {
+     if (symbols) {
+         return symbols->getName(v);
+     }
+     return string_view(nameData + nameOffsets[v], nameOffsets[v + 1] - nameOffsets[v]);
+ }
+
+ // Get the weight of the lightest arc from one vertex to another (-1 if there is none)
+ int CompactGraph::getEdgeWeight(VertexId from, VertexId to) const {
+     int best = -1;
+     for (EdgeId e = findArc(reversed ? 1 : 0, from, to); e < offsetsView[from + 1] && targetsView[e] == to; e++) {
+         if (best == -1 || weightsView[e] < best) {
+             best = weightsView[e];
+         }
+     }
+     return best;
+ }
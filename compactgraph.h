@@ -0,0 +1,239 @@
+/* File: compactgraph.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the CompactGraph class, a read-only compressed sparse row (CSR)
+ *          copy of a loaded Graph that uses dense integer vertex IDs for fast traversal. The
+ *          arrays are either owned or viewed inside a memory-mapped snapshot file. Every metric
+ *          has its own weight array, and a graph with one-way edges also keeps its arcs reversed;
+ *          a search reads them through a light view that picks one metric and one direction.
+ *
+ */
+
+ #ifndef COMPACTGRAPH_H
+ #define COMPACTGRAPH_H
+ #include <iostream>
+ #include <vector>
+ #include <string>
+ #include <string_view>
+ #include <memory>
+ #include "graph.h"
+ #include "symboltable.h"
+ #include "snapshot.h"
+
+ using namespace std;
+
+ class CompactGraph {
+     public:
+         // Constructors
+         CompactGraph();
+         CompactGraph(const Graph& g);
+
+         // Copying shares the arrays, which are never written in place: an update copies the weights it
+         // changes first whenever a copy still holds them, so a copy costs nothing per vertex or arc
+         CompactGraph(const CompactGraph& other);
+         CompactGraph& operator=(const CompactGraph& other);
+
+         // View base's arcs weighted by metric, reversed if asked (arcs into each vertex instead of out).
+         // Nothing is copied, so base must not be rebuilt, reloaded or updated while the view is in use
+         CompactGraph(const CompactGraph& base, Metric metric, bool reversed);
+
+         // Rebuild the compact arrays from a graph
+         void build(const Graph& g);
+
+         // Change the weights of existing edges, every arc of each edge that leads the updated way, keeping
+         // the weight ranges exact and the heuristic scales admissible. Weights viewed in a snapshot or held
+         // by a copy are copied first, so neither the mapped file nor a copy changes. Fails, changing
+         // nothing, if an update has no arc to change. Views of this graph must be made again afterwards
+         bool updateEdgeWeights(const vector<WeightUpdate>& updates);
+
+         // Add the graph's sections, including its names, to a snapshot
+         void writeSnapshot(SnapshotWriter& writer) const;
+
+         // View the graph stored in a mapped snapshot without copying or parsing it
+         bool loadSnapshot(const shared_ptr<Snapshot>& mapped);
+
+         // Get the number of vertex IDs (one past the largest; removed nodes are empty rows)
+         int getNumVertices() const;
+
+         // Get the number of directed arcs (each two-way edge is stored twice)
+         int getNumArcs() const;
+
+         // Count the edges the arcs come from, as Graph::getNumEdges does (scans the arcs)
+         int getNumEdges() const;
+
+         // Check if any edge is one-way, so the reversed arcs differ from the arcs
+         bool isDirected() const;
+
+         // Get the metric and direction this graph or view reads (a built graph reads lengths forward)
+         Metric getMetric() const;
+         bool isReversed() const;
+
+         // Get the smallest and largest arc weights of the metric (0 for a graph without edges)
+         int getMinWeight() const;
+         int getMaxWeight() const;
+
+         // Check if every vertex has coordinates, and get them
+         bool hasCoordinates() const;
+         double getX(VertexId v) const;
+         double getY(VertexId v) const;
+
+         // Largest factors by which straight-line and Manhattan distances can be scaled without
+         // exceeding any edge weight, so scaled distances are admissible A* heuristics
+         double getEuclideanScale() const;
+         double getManhattanScale() const;
+
+         // Check if an ID belongs to a vertex of the graph (false for removed nodes)
+         bool isLive(VertexId v) const;
+
+         // Look up the ID of a vertex name (INVALID_VERTEX if not found)
+         VertexId getVertexId(const string& name) const;
+
+         // Get the name of a vertex
+         string_view getName(VertexId v) const;
+
+         // Get the weight of the lightest arc from one vertex to another (-1 if there is none)
+         int getEdgeWeight(VertexId from, VertexId to) const;
+
+         // Range of outgoing arcs of a vertex: [edgeBegin(v), edgeEnd(v))
+         EdgeId edgeBegin(VertexId v) const;
+         EdgeId edgeEnd(VertexId v) const;
+
+         // Target, weight and class of an arc
+         VertexId edgeTarget(EdgeId e) const;
+         int edgeWeight(EdgeId e) const;
+         EdgeClass edgeClass(EdgeId e) const;
+
+     private:
+         // Scalars stored in the SECTION_GRAPH_INFO section of a snapshot; the weight range and scales
+         // are those of METRIC_LENGTH
+         struct Info {
+             uint32_t numVertices;
+             uint32_t numArcs;
+             int32_t minWeight;
+             int32_t maxWeight;
+             double euclideanScale;
+             double manhattanScale;
+             uint32_t hasCoordinates;
+             uint32_t directed; // 1 if any edge is one-way (0 in files from before one-way edges)
+         };
+
+         // Weight range and heuristic scales of one metric, stored in SECTION_METRIC_INFO
+         struct MetricInfo {
+             int32_t minWeight;
+             int32_t maxWeight;
+             double euclideanScale;
+             double manhattanScale;
+         };
+
+         // The arcs of one direction in CSR form, with each attribute in its own array so a search
+         // streams only the metric it minimizes
+         struct ArcArrays {
+             vector<EdgeId> offsets;   // offsets[v]..offsets[v+1] index the arcs of vertex v
+             vector<VertexId> targets; // Arc targets, sorted by ID within each vertex
+             vector<int> weights[NUM_METRICS]; // One weight per arc and metric, parallel to targets
+             vector<EdgeClass> classes;
+             vector<unsigned char> twoWay; // 1 for arcs of two-way edges; empty unless directed
+         };
+
+         // Where one direction's arcs are read from: the arrays above or a snapshot
+         struct ArcViews {
+             const EdgeId* offsets;
+             const VertexId* targets;
+             const int* weights[NUM_METRICS];
+             const EdgeClass* classes;
+             const unsigned char* twoWay; // nullptr when every arc is two-way
+         };
+
+         Info info;                // Counts, length weight range and heuristic scales
+         MetricInfo metricInfo[NUM_METRICS];
+
+         // Arrays a graph built in memory owns. The reversed arcs (index 1) are only stored for a directed
+         // graph; otherwise they are the arcs themselves
+         struct OwnedArrays {
+             ArcArrays arcs[2];
+             vector<double> xCoords;   // Vertex coordinates (empty unless every vertex has them)
+             vector<double> yCoords;
+             vector<unsigned char> live; // 0 for IDs whose node was removed from the graph
+         };
+
+         // The built arrays, shared by every copy and never changed once built; nullptr when the graph
+         // views a base graph or a snapshot (which only owns the classes a file without metrics lacks)
+         shared_ptr<const OwnedArrays> owned;
+
+         // Weights changed since the graph was built or mapped, per direction and metric (nullptr while
+         // unchanged). Copies share them as well, so a change copies them again unless no copy holds them
+         shared_ptr<vector<int> > changedWeights[2][NUM_METRICS];
+
+         // Views of both directions, pointing into the arrays above, into the snapshot, or into a base graph
+         ArcViews arcViews[2];
+         const double* xView;
+         const double* yView;
+         const unsigned char* liveView;
+
+         // The direction and metric the accessors read, picked out of arcViews
+         Metric metric;
+         bool reversed;
+         bool shallow; // True for a view made from a base graph; it owns no arrays
+         const EdgeId* offsetsView;
+         const VertexId* targetsView;
+         const int* weightsView;
+         const EdgeClass* classesView;
+
+         // Names come from the graph's symbol table, or from the snapshot's string table
+         const SymbolTable* symbols;      // The graph's interned names; IDs match the graph's IDs
+         const uint64_t* nameOffsets;     // Snapshot names: nameData[nameOffsets[v]..nameOffsets[v+1])
+         const char* nameData;
+         const VertexId* nameOrder;       // Snapshot vertex IDs sorted by name
+         shared_ptr<Snapshot> snapshot;   // Keeps the mapping alive while anything views it
+
+         // Helper to point the views at the owned arrays
+         void viewOwnedArrays();
+
+         // Helper to pick the accessors' arrays for a metric and direction
+         void select(Metric newMetric, bool newReversed);
+
+         // Helper to record a metric's weight range and heuristic scales from the viewed arrays
+         void computeWeightInfo(Metric m);
+
+         // Helper to build one direction's arcs from the graph's edges, outgoing or incoming
+         void buildArcs(const Graph& g, int direction, ArcArrays& out);
+
+         // Helper to change the weights of the arcs in one row that lead to target; only the two-way
+         // ones if twoWayOnly. Notes if an extreme weight moved inward, so the range must be rescanned
+         void setArcWeights(int direction, VertexId row, VertexId target, bool twoWayOnly, Metric m,
+                            int weight, bool& rescan);
+
+         // Helper to find the first arc from one vertex to another in a direction (getNumArcs() if there is none)
+         EdgeId findArc(int direction, VertexId from, VertexId to) const;
+ };
+
+ // Inline accessors used in the search inner loops
+ inline EdgeId CompactGraph::edgeBegin(VertexId v) const {
+     return offsetsView[v];
+ }
+
+ inline EdgeId CompactGraph::edgeEnd(VertexId v) const {
+     return offsetsView[v + 1];
+ }
+
+ inline VertexId CompactGraph::edgeTarget(EdgeId e) const {
+     return targetsView[e];
+ }
+
+ inline int CompactGraph::edgeWeight(EdgeId e) const {
+     return weightsView[e];
+ }
+
+ inline EdgeClass CompactGraph::edgeClass(EdgeId e) const {
+     return classesView[e];
+ }
+
+ inline double CompactGraph::getX(VertexId v) const {
+     return xView[v];
+ }
+
+ inline double CompactGraph::getY(VertexId v) const {
+     return yView[v];
+ }
+
+ #endif // COMPACTGRAPH_H
@@ -0,0 +1,538 @@
+/* File: contractionhierarchy.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the ContractionHierarchy class.
+ *
+ */
+
+ #include "contractionhierarchy.h"
+ #include <climits>
+ #include <chrono>
+
+ // Witness searches give up after settling this many vertices, or on paths of more edges than
+ // the hop limit, and assume no witness exists; that can only add unneeded shortcuts, never lose
+ // a shortest path. Priorities are only estimates, so they use a much smaller search than the
+ // contraction itself, which would otherwise dominate once the remaining core gets dense
+ static const int WITNESS_SETTLE_LIMIT = 500;
+ static const int WITNESS_HOP_LIMIT = INT_MAX;
+ static const int PRIORITY_SETTLE_LIMIT = 20;
+ static const int PRIORITY_HOP_LIMIT = 2;
+
+ // A time-limited build checks the clock once per this many vertices taken off the queue
+ static const int BUDGET_CHECK_INTERVAL = 64;
+
+ // Working state of the preprocessing: the remaining graph with its shortcuts, and the scratch
+ // space of the witness searches
+ class Contractor {
+     public:
+         struct Edge {
+             VertexId target;
+             int weight;
+             VertexId middle;
+         };
+
+         struct Shortcut {
+             VertexId from;
+             VertexId to;
+             int weight;
+         };
+
+         vector<vector<Edge> > adjacency; // Edges among the vertices not yet contracted
+         vector<int> deletedNeighbors;    // Number of already contracted neighbors of each vertex
+
+         Contractor(const CompactGraph& g) : witnessHeap(g.getNumVertices()) {
+             int n = g.getNumVertices();
+             adjacency.resize(n);
+             deletedNeighbors.assign(n, 0);
+             witnessDistances.assign(n, INT_MAX);
+             witnessHops.assign(n, 0);
+             isWitnessTarget.assign(n, false);
+             for (VertexId v = 0; v < (VertexId)n; v++) {
+                 adjacency[v].reserve(g.edgeEnd(v) - g.edgeBegin(v));
+                 for (EdgeId e = g.edgeBegin(v); e < g.edgeEnd(v); e++) {
+                     // A loop is never part of a shortest path
+                     if (g.edgeTarget(e) == v) {
+                         continue;
+                     }
+
+                     // Parallel arcs are adjacent in a row; only the lightest can be on a shortest path
+                     if (!adjacency[v].empty() && adjacency[v].back().target == g.edgeTarget(e)) {
+                         if (g.edgeWeight(e) < adjacency[v].back().weight) {
+                             adjacency[v].back().weight = g.edgeWeight(e);
+                         }
+                         continue;
+                     }
+                     Edge edge = {g.edgeTarget(e), g.edgeWeight(e), INVALID_VERTEX};
+                     adjacency[v].push_back(edge);
+                 }
+             }
+         }
+
+         // Collect the shortcuts that contracting v needs: one for every pair of neighbors whose
+         // only shortest connection runs through v
+         void findShortcuts(VertexId v, int settleLimit, int hopLimit, vector<Shortcut>& shortcuts) {
+             shortcuts.clear();
+             const vector<Edge>& edges = adjacency[v];
+             for (size_t i = 0; i + 1 < edges.size(); i++) {
+                 // Each pair is checked once, from the neighbor that comes first
+                 int limit = 0;
+                 for (size_t j = i + 1; j < edges.size(); j++) {
+                     if (edges[i].weight + edges[j].weight > limit) {
+                         limit = edges[i].weight + edges[j].weight;
+                     }
+                 }
+
+                 // The search can stop once it has settled every neighbor it is looking for
+                 for (size_t j = i + 1; j < edges.size(); j++) {
+                     isWitnessTarget[edges[j].target] = true;
+                 }
+                 witnessSearch(edges[i].target, v, limit, settleLimit, hopLimit, edges.size() - i - 1);
+                 for (size_t j = i + 1; j < edges.size(); j++) {
+                     isWitnessTarget[edges[j].target] = false;
+                 }
+                 for (size_t j = i + 1; j < edges.size(); j++) {
+                     int via = edges[i].weight + edges[j].weight;
+                     if (witnessDistances[edges[j].target] > via) {
+                         Shortcut shortcut = {edges[i].target, edges[j].target, via};
+                         shortcuts.push_back(shortcut);
+                     }
+                 }
+             }
+         }
+
+         // Edge difference of contracting v, plus its contracted neighbors to spread the
+         // contractions evenly over the graph
+         int priority(VertexId v, vector<Shortcut>& shortcuts) {
+             findShortcuts(v, PRIORITY_SETTLE_LIMIT, PRIORITY_HOP_LIMIT, shortcuts);
+             return (int)shortcuts.size() - (int)adjacency[v].size() + deletedNeighbors[v];
+         }
+
+         // Remove v from the remaining graph and insert its shortcuts
+         void contract(VertexId v, const vector<Shortcut>& shortcuts) {
+             const vector<Edge>& edges = adjacency[v];
+             for (size_t i = 0; i < edges.size(); i++) {
+                 removeEdge(edges[i].target, v);
+                 deletedNeighbors[edges[i].target]++;
+             }
+             for (size_t i = 0; i < shortcuts.size(); i++) {
+                 addEdge(shortcuts[i].from, shortcuts[i].to, shortcuts[i].weight, v);
+                 addEdge(shortcuts[i].to, shortcuts[i].from, shortcuts[i].weight, v);
+             }
+         }
+
+     private:
+         vector<int> witnessDistances;
+         vector<int> witnessHops; // Edges on the path to each touched vertex
+         vector<VertexId> witnessTouched;
+         vector<bool> isWitnessTarget;
+         DaryHeap<4> witnessHeap;
+
+         // Dijkstra from source in the remaining graph without the vertex being contracted, following
+         // paths of at most hopLimit edges and stopping past limit, after settleLimit vertices, or once
+         // all targets are settled
+         void witnessSearch(VertexId source, VertexId excluded, int limit, int settleLimit, int hopLimit, int targets) {
+             for (size_t i = 0; i < witnessTouched.size(); i++) {
+                 witnessDistances[witnessTouched[i]] = INT_MAX;
+             }
+             witnessTouched.clear();
+             witnessHeap.clear();
+
+             witnessDistances[source] = 0;
+             witnessHops[source] = 0;
+             witnessTouched.push_back(source);
+             witnessHeap.insert(source, 0);
+             int settled = 0;
+             while (!witnessHeap.isEmpty() && witnessHeap.minPriority() <= limit && settled < settleLimit) {
+                 VertexId current = witnessHeap.extractMin();
+                 settled++;
+                 if (isWitnessTarget[current] && --targets == 0) {
+                     break;
+                 }
+                 if (witnessHops[current] >= hopLimit) {
+                     continue;
+                 }
+                 const vector<Edge>& edges = adjacency[current];
+                 for (size_t i = 0; i < edges.size(); i++) {
+                     VertexId neighbor = edges[i].target;
+                     if (neighbor == excluded) {
+                         continue;
+                     }
+                     int newDistance = witnessDistances[current] + edges[i].weight;
+                     if (newDistance < witnessDistances[neighbor]) {
+                         if (witnessDistances[neighbor] == INT_MAX) {
+                             witnessTouched.push_back(neighbor);
+                         }
+                         witnessDistances[neighbor] = newDistance;
+                         witnessHops[neighbor] = witnessHops[current] + 1;
+                         if (witnessHeap.contains(neighbor)) {
+                             witnessHeap.decreaseKey(neighbor, newDistance);
+                         } else {
+                             witnessHeap.insert(neighbor, newDistance);
+                         }
+                     }
+                 }
+             }
+         }
+
+         // Add an edge, or shorten the existing edge between the two vertices
+         void addEdge(VertexId from, VertexId to, int weight, VertexId middle) {
+             vector<Edge>& edges = adjacency[from];
+             for (size_t i = 0; i < edges.size(); i++) {
+                 if (edges[i].target == to) {
+                     if (weight < edges[i].weight) {
+                         edges[i].weight = weight;
+                         edges[i].middle = middle;
+                     }
+                     return;
+                 }
+             }
+             Edge edge = {to, weight, middle};
+             edges.push_back(edge);
+         }
+
+         // Remove the edge from -> to by moving the last edge into its slot
+         void removeEdge(VertexId from, VertexId to) {
+             vector<Edge>& edges = adjacency[from];
+             for (size_t i = 0; i < edges.size(); i++) {
+                 if (edges[i].target == to) {
+                     edges[i] = edges.back();
+                     edges.pop_back();
+                     return;
+                 }
+             }
+         }
+ };
+
+ // Constructor
+ ContractionHierarchy::ContractionHierarchy()
+     : numVertices(0), numShortcuts(0), metric(METRIC_LENGTH), rank(nullptr), upOffsets(nullptr), upArcs(nullptr) {}
+
+ // Copies share the upward graph and start with fresh search state
+ ContractionHierarchy::ContractionHierarchy(const ContractionHierarchy& other) {
+     *this = other;
+ }
+
+ ContractionHierarchy& ContractionHierarchy::operator=(const ContractionHierarchy& other) {
+     if (this == &other) {
+         return *this;
+     }
+     numVertices = other.numVertices;
+     numShortcuts = other.numShortcuts;
+     metric = other.metric;
+     upward = other.upward;
+     rank = other.rank;
+     upOffsets = other.upOffsets;
+     upArcs = other.upArcs;
+     ownQuery = Query();
+     return *this;
+ }
+
+ // Order the vertices and contract them for the metric g reads, building the upward search graph
+ void ContractionHierarchy::build(const CompactGraph& g) {
+     build(g, 0.0);
+ }
+
+ // Same, giving up and leaving the hierarchy empty once contraction has run for maxSeconds (0 for no limit)
+ bool ContractionHierarchy::build(const CompactGraph& g, double maxSeconds) {
+     chrono::steady_clock::time_point started = chrono::steady_clock::now();
+     clear();
+     numVertices = g.getNumVertices();
+     metric = g.getMetric();
+     shared_ptr<UpwardGraph> built = make_shared<UpwardGraph>();
+     built->rank.assign(numVertices, -1);
+
+     Contractor contractor(g);
+     vector<Contractor::Shortcut> shortcuts;
+
+     // Queue every vertex by its initial edge difference
+     DaryHeap<4> order(numVertices);
+     vector<int> priorities(numVertices);
+     for (VertexId v = 0; v < (VertexId)numVertices; v++) {
+         priorities[v] = contractor.priority(v, shortcuts);
+         order.insert(v, priorities[v]);
+     }
+
+     // The edges a vertex still has when it is contracted all lead to higher ranks, so they
+     // are exactly its upward arcs
+     vector<vector<Contractor::Edge> > upward(numVertices);
+     int nextRank = 0;
+     int extracted = 0;
+     while (!order.isEmpty()) {
+         if (maxSeconds > 0.0 && ++extracted % BUDGET_CHECK_INTERVAL == 0 &&
+             chrono::duration<double>(chrono::steady_clock::now() - started).count() > maxSeconds) {
+             clear();
+             return false;
+         }
+         VertexId v = order.extractMin();
+
+         // Priorities go stale as neighbors are contracted; recompute lazily and requeue the
+         // vertex if it is no longer the cheapest
+         priorities[v] = contractor.priority(v, shortcuts);
+         if (!order.isEmpty() && priorities[v] > order.minPriority()) {
+             order.insert(v, priorities[v]);
+             continue;
+         }
+
+         built->rank[v] = nextRank++;
+         contractor.findShortcuts(v, WITNESS_SETTLE_LIMIT, WITNESS_HOP_LIMIT, shortcuts);
+         upward[v] = contractor.adjacency[v];
+         contractor.contract(v, shortcuts);
+         contractor.adjacency[v].clear();
+         contractor.adjacency[v].shrink_to_fit();
+
+         // Each neighbor gained a contracted neighbor, which raises its priority by one. Its edge
+         // difference changed too, but re-evaluating that means a witness search per pair of its
+         // neighbors, so it is left to the lazy check when the neighbor comes up
+         for (size_t i = 0; i < upward[v].size(); i++) {
+             VertexId neighbor = upward[v][i].target;
+             priorities[neighbor]++;
+             order.updateKey(neighbor, priorities[neighbor]);
+         }
+     }
+
+     // Flatten the upward arcs into CSR form
+     vector<EdgeId>& offsets = built->upOffsets;
+     offsets.assign(numVertices + 1, 0);
+     for (int v = 0; v < numVertices; v++) {
+         offsets[v + 1] = offsets[v] + upward[v].size();
+     }
+     built->upArcs.resize(offsets[numVertices]);
+     for (int v = 0; v < numVertices; v++) {
+         for (size_t i = 0; i < upward[v].size(); i++) {
+             Arc arc = {upward[v][i].target, upward[v][i].weight, upward[v][i].middle};
+             built->upArcs[offsets[v] + i] = arc;
+             if (arc.middle != INVALID_VERTEX) {
+                 numShortcuts++;
+             }
+         }
+     }
+     setUpward(built);
+     return true;
+ }
+
+ // Add the vertex order and upward graph to a snapshot
+ void ContractionHierarchy::writeSnapshot(SnapshotWriter& writer) const {
+     writer.addSection(SECTION_CH_RANK, rank, upward->rank.size() * sizeof(int));
+     writer.addSection(SECTION_CH_OFFSETS, upOffsets, upward->upOffsets.size() * sizeof(EdgeId));
+     writer.addSection(SECTION_CH_ARCS, upArcs, upward->upArcs.size() * sizeof(Arc));
+     *(uint32_t*)writer.allocateSection(SECTION_CH_METRIC, sizeof(uint32_t)) = metric;
+ }
+
+ // Copy a hierarchy out of a snapshot of a graph with numIds vertex IDs; false if it has none
+ bool ContractionHierarchy::loadSnapshot(const Snapshot& snapshot, int numIds) {
+     size_t rankSize, offsetsSize, arcsSize, metricSize;
+     const int* newRank = (const int*)snapshot.getSection(SECTION_CH_RANK, rankSize);
+     const EdgeId* newOffsets = (const EdgeId*)snapshot.getSection(SECTION_CH_OFFSETS, offsetsSize);
+     const Arc* newArcs = (const Arc*)snapshot.getSection(SECTION_CH_ARCS, arcsSize);
+     const uint32_t* storedMetric = (const uint32_t*)snapshot.getSection(SECTION_CH_METRIC, metricSize);
+     if (!newRank || rankSize != numIds * sizeof(int) || !newOffsets || offsetsSize != (numIds + 1) * sizeof(EdgeId) ||
+         !newArcs || arcsSize != newOffsets[numIds] * sizeof(Arc)) {
+         return false;
+     }
+
+     // Snapshots from before metrics hold a hierarchy of lengths
+     if (storedMetric && (metricSize != sizeof(uint32_t) || *storedMetric >= (uint32_t)NUM_METRICS)) {
+         return false;
+     }
+
+     clear();
+     numVertices = numIds;
+     metric = storedMetric ? (Metric)*storedMetric : METRIC_LENGTH;
+     shared_ptr<UpwardGraph> loaded = make_shared<UpwardGraph>();
+     loaded->rank.assign(newRank, newRank + numIds);
+     loaded->upOffsets.assign(newOffsets, newOffsets + numIds + 1);
+     loaded->upArcs.assign(newArcs, newArcs + newOffsets[numIds]);
+     for (size_t e = 0; e < loaded->upArcs.size(); e++) {
+         if (loaded->upArcs[e].middle != INVALID_VERTEX) {
+             numShortcuts++;
+         }
+     }
+     setUpward(loaded);
+     return true;
+ }
+
+ // Drop the hierarchy
+ void ContractionHierarchy::clear() {
+     numVertices = 0;
+     numShortcuts = 0;
+     metric = METRIC_LENGTH;
+     setUpward(shared_ptr<const UpwardGraph>());
+ }
+
+ // Check if the hierarchy has not been built
+ bool ContractionHierarchy::isEmpty() const {
+     return !upward || upward->rank.empty();
+ }
+
+ // Get the number of shortcuts added during preprocessing
+ int ContractionHierarchy::getNumShortcuts() const {
+     return numShortcuts;
+ }
+
+ // Get the metric the hierarchy was contracted for
+ Metric ContractionHierarchy::getMetric() const {
+     return metric;
+ }
+
+ // Find a shortest path as a sequence of original vertices (empty if there is none)
+ vector<VertexId> ContractionHierarchy::findPath(VertexId start, VertexId end) {
+     return findPath(start, end, ownQuery);
+ }
+
+ // Same, with caller-owned search state so several threads can share the hierarchy
+ vector<VertexId> ContractionHierarchy::findPath(VertexId start, VertexId end, Query& query) const {
+     vector<VertexId> path;
+     if (start >= (VertexId)numVertices || end >= (VertexId)numVertices) {
+         return path;
+     }
+
+     // Size the state on its first query against this hierarchy
+     vector<int>* distances = query.distances;
+     vector<VertexId>* predecessors = query.predecessors;
+     vector<VertexId>& touched = query.touched;
+     DaryHeap<4>* heaps = query.heaps;
+     if (distances[0].size() != (size_t)numVertices) {
+         touched.clear();
+         for (int side = 0; side < 2; side++) {
+             distances[side].assign(numVertices, INT_MAX);
+             predecessors[side].assign(numVertices, INVALID_VERTEX);
+             heaps[side] = DaryHeap<4>(numVertices);
+         }
+     }
+
+     // Reset only what the last query touched
+     for (size_t i = 0; i < touched.size(); i++) {
+         for (int side = 0; side < 2; side++) {
+             distances[side][touched[i]] = INT_MAX;
+             predecessors[side][touched[i]] = INVALID_VERTEX;
+         }
+     }
+     touched.clear();
+     heaps[0].clear();
+     heaps[1].clear();
+
+     distances[0][start] = 0;
+     heaps[0].insert(start, 0);
+     touched.push_back(start);
+     if (distances[1][end] == INT_MAX && end != start) {
+         touched.push_back(end);
+     }
+     distances[1][end] = 0;
+     heaps[1].insert(end, 0);
+
+     // Both searches climb the hierarchy; every shortest path has a highest vertex where they meet.
+     // A side stops once its smallest key can no longer improve the best meeting
+     int best = INT_MAX;
+     VertexId meet = INVALID_VERTEX;
+     while (true) {
+         bool forwardActive = !heaps[0].isEmpty() && heaps[0].minPriority() < best;
+         bool backwardActive = !heaps[1].isEmpty() && heaps[1].minPriority() < best;
+         if (!forwardActive && !backwardActive) {
+             break;
+         }
+         int side = (forwardActive && (!backwardActive || heaps[0].minPriority() <= heaps[1].minPriority())) ? 0 : 1;
+
+         VertexId current = heaps[side].extractMin();
+         int distance = distances[side][current];
+         if (distances[1 - side][current] != INT_MAX && distance + distances[1 - side][current] < best) {
+             best = distance + distances[1 - side][current];
+             meet = current;
+         }
+
+         // Stall on demand: if a higher vertex already reaches this one more cheaply, the search
+         // arrived here on a path that is not shortest and need not go further up from it
+         bool stalled = false;
+         for (EdgeId e = upOffsets[current]; e < upOffsets[current + 1]; e++) {
+             int above = distances[side][upArcs[e].target];
+             if (above != INT_MAX && above + upArcs[e].weight < distance) {
+                 stalled = true;
+                 break;
+             }
+         }
+         if (stalled) {
+             continue;
+         }
+
+         for (EdgeId e = upOffsets[current]; e < upOffsets[current + 1]; e++) {
+             VertexId neighbor = upArcs[e].target;
+             int newDistance = distance + upArcs[e].weight;
+             if (newDistance < distances[side][neighbor]) {
+                 if (distances[0][neighbor] == INT_MAX && distances[1][neighbor] == INT_MAX) {
+                     touched.push_back(neighbor);
+                 }
+                 distances[side][neighbor] = newDistance;
+                 predecessors[side][neighbor] = current;
+                 if (heaps[side].contains(neighbor)) {
+                     heaps[side].decreaseKey(neighbor, newDistance);
+                 } else {
+                     heaps[side].insert(neighbor, newDistance);
+                 }
+             }
+         }
+     }
+
+     if (meet == INVALID_VERTEX) {
+         return path;
+     }
+
+     // Upward path start -> meet, then meet -> end, still with shortcuts
+     vector<VertexId> upwardPath;
+     for (VertexId v = meet; v != INVALID_VERTEX; v = predecessors[0][v]) {
+         upwardPath.push_back(v);
+     }
+     for (size_t i = 0, j = upwardPath.size() - 1; i < j; i++, j--) {
+         VertexId temp = upwardPath[i];
+         upwardPath[i] = upwardPath[j];
+         upwardPath[j] = temp;
+     }
+     for (VertexId v = predecessors[1][meet]; v != INVALID_VERTEX; v = predecessors[1][v]) {
+         upwardPath.push_back(v);
+     }
+
+     // Replace every shortcut by the original edges it stands for
+     path.push_back(upwardPath[0]);
+     for (size_t i = 0; i + 1 < upwardPath.size(); i++) {
+         unpackArc(upwardPath[i], upwardPath[i + 1], path);
+     }
+     return path;
+ }
+
+ // Helper to make newUpward the upward graph (nullptr for none) and drop search state sized for the old one
+ void ContractionHierarchy::setUpward(const shared_ptr<const UpwardGraph>& newUpward) {
+     upward = newUpward;
+     rank = upward ? upward->rank.data() : nullptr;
+     upOffsets = upward ? upward->upOffsets.data() : nullptr;
+     upArcs = upward ? upward->upArcs.data() : nullptr;
+     ownQuery = Query();
+ }
+
+ // Helper to find the arc between two vertices, stored at the lower-ranked end
+ const ContractionHierarchy::Arc* ContractionHierarchy::findArc(VertexId u, VertexId w) const {
+     VertexId lower = (rank[u] < rank[w]) ? u : w;
+     VertexId higher = (lower == u) ? w : u;
+     for (EdgeId e = upOffsets[lower]; e < upOffsets[lower + 1]; e++) {
+         if (upArcs[e].target == higher) {
+             return &upArcs[e];
+         }
+     }
+     return nullptr;
+ }
+
+ // Helper to append the original vertices of the arc from -> to (excluding from) to path
+ void ContractionHierarchy::unpackArc(VertexId from, VertexId to, vector<VertexId>& path) const {
+     // Shortcuts nest deeply on large graphs, so unpack with an explicit stack instead of recursion
+     vector<pair<VertexId, VertexId> > pending(1, make_pair(from, to));
+     while (!pending.empty()) {
+         pair<VertexId, VertexId> arcEnds = pending.back();
+         pending.pop_back();
+
+         const Arc* arc = findArc(arcEnds.first, arcEnds.second);
+         if (arc == nullptr || arc->middle == INVALID_VERTEX) {
+             path.push_back(arcEnds.second);
+         } else {
+             // The first half has to come out first, so it goes on the stack last
+             pending.push_back(make_pair(arc->middle, arcEnds.second));
+             pending.push_back(make_pair(arcEnds.first, arc->middle));
+         }
+     }
+ }
@@ -0,0 +1,108 @@
+/* File: contractionhierarchy.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the ContractionHierarchy class. Preprocessing contracts vertices one
+ *          at a time in order of edge difference, adding shortcut edges that preserve shortest path
+ *          distances among the vertices left. Queries then run a bidirectional Dijkstra that only
+ *          follows edges towards more important vertices, and unpack shortcuts back into the
+ *          original vertices of the path.
+ *
+ */
+
+ #ifndef CONTRACTIONHIERARCHY_H
+ #define CONTRACTIONHIERARCHY_H
+ #include <iostream>
+ #include <vector>
+ #include <memory>
+ #include "compactgraph.h"
+ #include "daryheap.h"
+ #include "snapshot.h"
+
+ using namespace std;
+
+ class ContractionHierarchy {
+     public:
+         // Search state for one query at a time; each thread querying a shared hierarchy needs its own.
+         // It is reset through the list of touched vertices, so a query costs nothing per vertex
+         struct Query {
+             vector<int> distances[2];
+             vector<VertexId> predecessors[2];
+             vector<VertexId> touched;
+             DaryHeap<4> heaps[2];
+         };
+
+         // Constructor
+         ContractionHierarchy();
+
+         // Copies share the upward graph, which is only ever replaced whole, and start with fresh search state
+         ContractionHierarchy(const ContractionHierarchy& other);
+         ContractionHierarchy& operator=(const ContractionHierarchy& other);
+
+         // Order the vertices and contract them for the metric g reads, building the upward search graph
+         void build(const CompactGraph& g);
+
+         // Same, giving up and leaving the hierarchy empty once contraction has run for maxSeconds; false
+         // if it gave up. Dense graphs can take far longer to contract than to search without a hierarchy
+         bool build(const CompactGraph& g, double maxSeconds);
+
+         // Add the vertex order and upward graph to a snapshot
+         void writeSnapshot(SnapshotWriter& writer) const;
+
+         // Copy a hierarchy out of a snapshot of a graph with numIds vertex IDs; false if it has none
+         bool loadSnapshot(const Snapshot& snapshot, int numIds);
+
+         // Drop the hierarchy
+         void clear();
+
+         // Check if the hierarchy has not been built
+         bool isEmpty() const;
+
+         // Get the number of shortcuts added during preprocessing
+         int getNumShortcuts() const;
+
+         // Get the metric the hierarchy was contracted for
+         Metric getMetric() const;
+
+         // Find a shortest path as a sequence of original vertices (empty if there is none)
+         vector<VertexId> findPath(VertexId start, VertexId end);
+
+         // Same, with caller-owned search state so several threads can share the hierarchy
+         vector<VertexId> findPath(VertexId start, VertexId end, Query& query) const;
+
+     private:
+         struct Arc {
+             VertexId target;
+             int weight;
+             VertexId middle; // Contracted vertex a shortcut bypasses, or INVALID_VERTEX for an original edge
+         };
+
+         // The vertex order and upward search graph
+         struct UpwardGraph {
+             vector<int> rank;        // Contraction order; arcs only lead to higher ranks
+             vector<EdgeId> upOffsets; // upOffsets[v]..upOffsets[v+1] index the upward arcs of v
+             vector<Arc> upArcs;
+         };
+
+         int numVertices;
+         int numShortcuts;
+         Metric metric;
+         shared_ptr<const UpwardGraph> upward; // nullptr until built; copies of the hierarchy share it
+
+         // The arrays of upward, read directly by the searches
+         const int* rank;
+         const EdgeId* upOffsets;
+         const Arc* upArcs;
+
+         Query ownQuery; // Search state for findPath without a caller-owned query
+
+         // Helper to make newUpward the upward graph (nullptr for none) and drop search state sized for the old one
+         void setUpward(const shared_ptr<const UpwardGraph>& newUpward);
+
+         // Helper to find the arc between two vertices, stored at the lower-ranked end
+         const Arc* findArc(VertexId u, VertexId w) const;
+
+         // Helper to append the original vertices of the arc from -> to (excluding from) to path
+         void unpackArc(VertexId from, VertexId to, vector<VertexId>& path) const;
+ };
+
+ #endif // CONTRACTIONHIERARCHY_H
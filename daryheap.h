@@ -0,0 +1,267 @@
+/* File: daryheap.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration and implementation of the DaryHeap class template, an indexed d-ary
+ *          min-heap over dense vertex IDs that implements the priority queue for Dijkstra's algorithm.
+ *          Positions are kept in a flat array indexed by vertex ID, so contains() is O(1) and no
+ *          swap performs a lookup.
+ *
+ */
+
+ #ifndef DARYHEAP_H
+ #define DARYHEAP_H
+ #include <iostream>
+ #include <vector>
+ #include "symboltable.h"
+
+ using namespace std;
+
+ template <int Arity>
+ class DaryHeap {
+     public:
+         // Constructors
+         DaryHeap();
+         DaryHeap(int capacity);
+
+         // Make room for vertex IDs below capacity without growing on insert
+         void reserve(int capacity);
+
+         // Insert a node into the heap with a given priority
+         void insert(VertexId node, int priority);
+
+         // Extract the minimum node from the heap
+         VertexId extractMin();
+
+         // Get the smallest priority in the heap (the heap must not be empty)
+         int minPriority() const;
+
+         // Decrease the key of a node in the heap
+         void decreaseKey(VertexId node, int priority);
+
+         // Change the key of a node in the heap in either direction
+         void updateKey(VertexId node, int priority);
+
+         // Check if the heap is empty
+         bool isEmpty() const;
+
+         // Check if the heap contains a node
+         bool contains(VertexId node) const;
+
+         // Get the number of nodes in the heap
+         int size() const;
+
+         // Remove every node, in time proportional to the heap size rather than the capacity
+         void clear();
+
+         // Print the heap for debugging
+         void printHeap() const;
+
+     private:
+         struct Entry {
+             int priority;
+             VertexId node;
+         };
+
+         vector<Entry> heap;    // The heap array, root at index 0
+         vector<int> positions; // positions[node] is the node's heap index, or -1 if absent
+
+         // Helper methods
+         void bubbleUp(int pos);
+         void bubbleDown(int pos);
+ };
+
+ // A binary heap is the 2-ary case
+ typedef DaryHeap<2> BinaryHeap;
+
+ // Constructors
+ template <int Arity>
+ DaryHeap<Arity>::DaryHeap() {}
+
+ template <int Arity>
+ DaryHeap<Arity>::DaryHeap(int capacity) {
+     reserve(capacity);
+ }
+
+ // Make room for vertex IDs below capacity without growing on insert
+ template <int Arity>
+ void DaryHeap<Arity>::reserve(int capacity) {
+     if (capacity > (int)positions.size()) {
+         positions.resize(capacity, -1);
+     }
+ }
+
+ // Insert a node into the heap with a given priority
+ template <int Arity>
+ void DaryHeap<Arity>::insert(VertexId node, int priority) {
+     if (node >= positions.size()) {
+         positions.resize(node + 1, -1);
+     }
+
+     // Add the node to the end of the heap and bubble up
+     Entry entry;
+     entry.priority = priority;
+     entry.node = node;
+     heap.push_back(entry);
+     bubbleUp(heap.size() - 1);
+ }
+
+ // Extract the minimum node from the heap
+ template <int Arity>
+ VertexId DaryHeap<Arity>::extractMin() {
+     if (isEmpty()) {
+         cout << "Error: Cannot extract from an empty heap" << endl;
+         return INVALID_VERTEX;
+     }
+
+     // The root of the heap is the minimum
+     VertexId minNode = heap[0].node;
+     positions[minNode] = -1;
+
+     // Move the last element to the root and bubble it down
+     Entry last = heap.back();
+     heap.pop_back();
+     if (!heap.empty()) {
+         heap[0] = last;
+         bubbleDown(0);
+     }
+
+     return minNode;
+ }
+
+ // Get the smallest priority in the heap (the heap must not be empty)
+ template <int Arity>
+ int DaryHeap<Arity>::minPriority() const {
+     return heap[0].priority;
+ }
+
+ // Decrease the key of a node in the heap
+ template <int Arity>
+ void DaryHeap<Arity>::decreaseKey(VertexId node, int newPriority) {
+     // Check if the node exists in the heap
+     if (!contains(node)) {
+         cout << "Error: Node not found in the heap" << endl;
+         return;
+     }
+
+     // Only decrease if the new priority is smaller
+     int pos = positions[node];
+     if (newPriority < heap[pos].priority) {
+         heap[pos].priority = newPriority;
+         bubbleUp(pos);
+     }
+ }
+
+ // Change the key of a node in the heap in either direction
+ template <int Arity>
+ void DaryHeap<Arity>::updateKey(VertexId node, int newPriority) {
+     // Check if the node exists in the heap
+     if (!contains(node)) {
+         cout << "Error: Node not found in the heap" << endl;
+         return;
+     }
+
+     int pos = positions[node];
+     int oldPriority = heap[pos].priority;
+     heap[pos].priority = newPriority;
+     if (newPriority < oldPriority) {
+         bubbleUp(pos);
+     } else if (newPriority > oldPriority) {
+         bubbleDown(pos);
+     }
+ }
+
+ // Check if the heap is empty
+ template <int Arity>
+ bool DaryHeap<Arity>::isEmpty() const {
+     return heap.empty();
+ }
+
+ // Check if the heap contains a node
+ template <int Arity>
+ bool DaryHeap<Arity>::contains(VertexId node) const {
+     return node < positions.size() && positions[node] >= 0;
+ }
+
+ // Get the number of nodes in the heap
+ template <int Arity>
+ int DaryHeap<Arity>::size() const {
+     return heap.size();
+ }
+
+ // Remove every node, in time proportional to the heap size rather than the capacity
+ template <int Arity>
+ void DaryHeap<Arity>::clear() {
+     for (size_t i = 0; i < heap.size(); i++) {
+         positions[heap[i].node] = -1;
+     }
+     heap.clear();
+ }
+
+ // Print the heap for debugging
+ template <int Arity>
+ void DaryHeap<Arity>::printHeap() const {
+     cout << "Heap contents:" << endl;
+     for (size_t i = 0; i < heap.size(); i++) {
+         cout << "Node: " << heap[i].node << ", Priority: " << heap[i].priority << endl;
+     }
+ }
+
+ // Helper method to bubble up a node
+ template <int Arity>
+ void DaryHeap<Arity>::bubbleUp(int pos) {
+     // Save the node that needs to be bubbled up
+     Entry entry = heap[pos];
+
+     // While not at the root and the parent has higher priority
+     while (pos > 0) {
+         int parent = (pos - 1) / Arity;
+         if (heap[parent].priority <= entry.priority) {
+             break;
+         }
+
+         // Move the parent down
+         heap[pos] = heap[parent];
+         positions[heap[pos].node] = pos;
+         pos = parent;
+     }
+
+     // Place the node in its final position
+     heap[pos] = entry;
+     positions[entry.node] = pos;
+ }
+
+ // Helper method to bubble down a node
+ template <int Arity>
+ void DaryHeap<Arity>::bubbleDown(int pos) {
+     int size = heap.size();
+     // Save the node that needs to be bubbled down
+     Entry entry = heap[pos];
+
+     // While there is at least one child
+     while (Arity * pos + 1 < size) {
+         // Find the child with the smallest priority
+         int first = Arity * pos + 1;
+         int last = (first + Arity < size) ? first + Arity : size;
+         int child = first;
+         for (int c = first + 1; c < last; c++) {
+             if (heap[c].priority < heap[child].priority) {
+                 child = c;
+             }
+         }
+
+         // If the child has smaller priority, move it up
+         if (heap[child].priority < entry.priority) {
+             heap[pos] = heap[child];
+             positions[heap[pos].node] = pos;
+             pos = child;
+         } else {
+             break;
+         }
+     }
+
+     // Place the node in its final position
+     heap[pos] = entry;
+     positions[entry.node] = pos;
+ }
+
+ #endif // DARYHEAP_H
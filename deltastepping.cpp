@@ -0,0 +1,227 @@
+/* File: deltastepping.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the DeltaStepping class.
+ *
+ */
+
+ #include "deltastepping.h"
+ #include "spinbarrier.h"
+ #include <atomic>
+ #include <thread>
+ #include <functional>
+ #include <climits>
+ #include <cstdint>
+
+ // A vertex label packs the distance into the high 32 bits and the predecessor into the low 32, so
+ // one compare-and-swap keeps the two consistent
+ static const uint64_t UNREACHED_LABEL = ((uint64_t)INT_MAX << 32) | INVALID_VERTEX;
+
+ // No bucket has been proposed yet
+ static const long long NO_BUCKET = LLONG_MAX;
+
+ // Helpers to pack and unpack a label
+ static inline uint64_t makeLabel(int distance, VertexId predecessor) {
+     return ((uint64_t)(uint32_t)distance << 32) | predecessor;
+ }
+
+ static inline int labelDistance(uint64_t label) {
+     return (int)(label >> 32);
+ }
+
+ // State shared by the threads of one run
+ struct DeltaShared {
+     const CompactGraph* graph;
+     int delta;
+     int numBuckets;                     // Length of each thread's circular bucket array
+     vector<atomic<uint64_t> > labels;
+     vector<vector<VertexId> > current;  // current[t] is thread t's part of the bucket being relaxed
+     atomic<size_t> claimed[2];          // Next index of the current bucket to claim, by round parity
+     atomic<long long> proposed[2];      // Lowest non-empty bucket any thread holds, by round parity
+     SpinBarrier barrier;
+
+     DeltaShared(const CompactGraph& g, int delta, int numBuckets, int numThreads)
+         : graph(&g), delta(delta), numBuckets(numBuckets), labels(g.getNumVertices()),
+           current(numThreads), barrier(numThreads) {
+         for (size_t v = 0; v < labels.size(); v++) {
+             labels[v].store(UNREACHED_LABEL, memory_order_relaxed);
+         }
+         for (int i = 0; i < 2; i++) {
+             claimed[i].store(0);
+             proposed[i].store(NO_BUCKET);
+         }
+     }
+ };
+
+ // Vertices of the current bucket are handed out in chunks of this many
+ static const size_t DELTA_CHUNK = 64;
+
+ // Helper to relax every arc out of v, filing improved vertices in this thread's buckets; entries left
+ // over from a bucket v has since moved out of are skipped
+ static void relaxVertex(DeltaShared& shared, VertexId v, long long bucket, vector<vector<VertexId> >& buckets) {
+     const CompactGraph& g = *shared.graph;
+     int distance = labelDistance(shared.labels[v].load(memory_order_relaxed));
+     if (distance / shared.delta < bucket) {
+         return;
+     }
+
+     for (EdgeId e = g.edgeBegin(v); e < g.edgeEnd(v); e++) {
+         VertexId neighbor = g.edgeTarget(e);
+         int newDistance = distance + g.edgeWeight(e);
+         uint64_t newLabel = makeLabel(newDistance, v);
+         uint64_t old = shared.labels[neighbor].load(memory_order_relaxed);
+         while (newDistance < labelDistance(old)) {
+             if (shared.labels[neighbor].compare_exchange_weak(old, newLabel)) {
+                 buckets[(newDistance / shared.delta) % shared.numBuckets].push_back(neighbor);
+                 break;
+             }
+         }
+     }
+ }
+
+ // One thread of a delta-stepping run
+ static void deltaWorker(DeltaShared& shared, int id, int numThreads) {
+     vector<vector<VertexId> > buckets(shared.numBuckets);
+     long long bucket = 0;
+
+     for (int round = 0; ; round++) {
+         int parity = round & 1;
+
+         // Relax the current bucket, claimed in chunks across every thread's part of it
+         size_t total = 0;
+         for (int t = 0; t < numThreads; t++) {
+             total += shared.current[t].size();
+         }
+         while (true) {
+             size_t start = shared.claimed[parity].fetch_add(DELTA_CHUNK);
+             if (start >= total) {
+                 break;
+             }
+             size_t end = (start + DELTA_CHUNK < total) ? start + DELTA_CHUNK : total;
+             int t = 0;
+             size_t offset = 0;
+             for (size_t i = start; i < end; i++) {
+                 while (i - offset >= shared.current[t].size()) {
+                     offset += shared.current[t].size();
+                     t++;
+                 }
+                 relaxVertex(shared, shared.current[t][i - offset], bucket, buckets);
+             }
+         }
+
+         // Keep going on this thread's own refill of the bucket while it is too small to share
+         vector<VertexId>& own = buckets[bucket % shared.numBuckets];
+         while (!own.empty() && own.size() < DELTA_FUSION_LIMIT) {
+             vector<VertexId> batch;
+             batch.swap(own);
+             for (size_t i = 0; i < batch.size(); i++) {
+                 relaxVertex(shared, batch[i], bucket, buckets);
+             }
+         }
+
+         // Propose the lowest bucket this thread still holds; every pending entry lies within
+         // numBuckets of the current one, so one lap of the circular array finds it
+         for (long long b = bucket; b < bucket + shared.numBuckets; b++) {
+             if (!buckets[b % shared.numBuckets].empty()) {
+                 long long seen = shared.proposed[parity].load();
+                 while (b < seen && !shared.proposed[parity].compare_exchange_weak(seen, b)) {}
+                 break;
+             }
+         }
+         shared.barrier.wait();
+
+         // Everyone agrees on the next bucket; stop when no thread holds anything
+         long long next = shared.proposed[parity].load();
+         if (next == NO_BUCKET) {
+             break;
+         }
+         if (id == 0) {
+             shared.claimed[1 - parity].store(0);
+             shared.proposed[1 - parity].store(NO_BUCKET);
+         }
+         bucket = next;
+         shared.current[id].swap(buckets[bucket % shared.numBuckets]);
+         buckets[bucket % shared.numBuckets].clear();
+         shared.barrier.wait();
+     }
+ }
+
+ // Constructor; numThreads 0 uses one thread per hardware core
+ DeltaStepping::DeltaStepping(const CompactGraph& g, int threads) : graph(g), numThreads(threads), delta(0) {
+     if (numThreads <= 0) {
+         numThreads = thread::hardware_concurrency();
+     }
+     if (numThreads <= 0) {
+         numThreads = 1;
+     }
+ }
+
+ // Set the bucket width; 0 picks it from the weights
+ void DeltaStepping::setDelta(int width) {
+     delta = width;
+ }
+
+ int DeltaStepping::getDelta() const {
+     return (delta > 0) ? delta : chooseDelta(graph);
+ }
+
+ // Pick a bucket width: the mean arc weight, raised so the buckets stay few
+ int DeltaStepping::chooseDelta(const CompactGraph& g) {
+     // With delta near the typical weight, most arcs leave the bucket they start in, so few vertices
+     // are relaxed twice, while the bucket count stays near the hop diameter
+     long long total = 0;
+     int numArcs = g.getNumArcs();
+     for (VertexId v = 0; v < (VertexId)g.getNumVertices(); v++) {
+         for (EdgeId e = g.edgeBegin(v); e < g.edgeEnd(v); e++) {
+             total += g.edgeWeight(e);
+         }
+     }
+     long long width = (numArcs > 0) ? total / numArcs : 1;
+
+     // A few huge weights would otherwise need a huge circular bucket array
+     long long minimum = (long long)g.getMaxWeight() / (DELTA_MAX_BUCKETS - 2) + 1;
+     if (width < minimum) {
+         width = minimum;
+     }
+     return (width < 1) ? 1 : (int)width;
+ }
+
+ // Compute the distance from source to every vertex and the predecessor of each on a shortest path
+ bool DeltaStepping::run(VertexId source, vector<int>& distances, vector<VertexId>& predecessors) {
+     if (graph.getMinWeight() < 0) {
+         cerr << "Error: Delta-stepping needs non-negative weights" << endl;
+         return false;
+     }
+     int n = graph.getNumVertices();
+     if (source >= (VertexId)n) {
+         cerr << "Error: Start node does not exist" << endl;
+         return false;
+     }
+
+     // Every pending entry is less than maxWeight + delta past the current bucket's start
+     int width = getDelta();
+     int numBuckets = graph.getMaxWeight() / width + 2;
+     DeltaShared shared(graph, width, numBuckets, numThreads);
+     shared.labels[source].store(makeLabel(0, INVALID_VERTEX));
+     shared.current[0].push_back(source);
+
+     // The first thread runs on this one
+     vector<thread> workers;
+     for (int t = 1; t < numThreads; t++) {
+         workers.push_back(thread(deltaWorker, ref(shared), t, numThreads));
+     }
+     deltaWorker(shared, 0, numThreads);
+     for (size_t i = 0; i < workers.size(); i++) {
+         workers[i].join();
+     }
+
+     // Unpack the labels
+     distances.assign(n, INT_MAX);
+     predecessors.assign(n, INVALID_VERTEX);
+     for (int v = 0; v < n; v++) {
+         uint64_t label = shared.labels[v].load(memory_order_relaxed);
+         distances[v] = labelDistance(label);
+         predecessors[v] = (VertexId)(label & 0xffffffffu);
+     }
+     return true;
+ }
@@ -0,0 +1,48 @@
+/* File: deltastepping.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the DeltaStepping class, which computes a full single-source
+ *          shortest path tree on several threads. Vertices are kept in buckets of distance width
+ *          delta; all vertices of the lowest non-empty bucket are relaxed in parallel, and a
+ *          vertex's distance and predecessor are updated together with one compare-and-swap.
+ *
+ */
+
+ #ifndef DELTASTEPPING_H
+ #define DELTASTEPPING_H
+ #include <iostream>
+ #include <vector>
+ #include "compactgraph.h"
+
+ using namespace std;
+
+ // The automatic delta is raised until the circular bucket array needs at most this many buckets
+ const int DELTA_MAX_BUCKETS = 4096;
+
+ // A thread relaxes its own part of the current bucket without a barrier while it stays this small
+ const size_t DELTA_FUSION_LIMIT = 1000;
+
+ class DeltaStepping {
+     public:
+         // Constructor; numThreads 0 uses one thread per hardware core
+         DeltaStepping(const CompactGraph& g, int numThreads);
+
+         // Set the bucket width; 0 picks it from the weights (see chooseDelta)
+         void setDelta(int delta);
+         int getDelta() const;
+
+         // Pick a bucket width: the mean arc weight, raised so the buckets stay few
+         static int chooseDelta(const CompactGraph& g);
+
+         // Compute the distance from source to every vertex (INT_MAX if unreachable) and the
+         // predecessor of each on a shortest path (INVALID_VERTEX for the source and unreachable
+         // vertices). Fails if the graph has a negative weight
+         bool run(VertexId source, vector<int>& distances, vector<VertexId>& predecessors);
+
+     private:
+         const CompactGraph& graph;
+         int numThreads;
+         int delta;
+ };
+
+ #endif // DELTASTEPPING_H
@@ -0,0 +1,207 @@
+/* File: dynamicsssp.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the DynamicSSSP class.
+ *
+ */
+
+ #include "dynamicsssp.h"
+ #include <climits>
+
+ // Marks a repair leaves on the vertices it writes
+ static const unsigned char MARK_NONE = 0;
+ static const unsigned char MARK_AFFECTED = 1;
+ static const unsigned char MARK_TOUCHED = 2;
+
+ // Constructor
+ DynamicSSSP::DynamicSSSP(const CompactGraph& g, Metric m)
+     : base(g), metric(m), graph(g, m, false), reverse(g, m, true), source(INVALID_VERTEX) {}
+
+ // Compute the tree from source from scratch
+ bool DynamicSSSP::build(VertexId start) {
+     graph = CompactGraph(base, metric, false);
+     reverse = CompactGraph(base, metric, true);
+     if (!graph.isLive(start)) {
+         cerr << "Error: Start node does not exist" << endl;
+         return false;
+     }
+     if (graph.getMinWeight() < 0) {
+         cerr << "Error: A maintained shortest path tree needs non-negative weights" << endl;
+         return false;
+     }
+     int n = graph.getNumVertices();
+     source = start;
+     distances.assign(n, INT_MAX);
+     predecessors.assign(n, INVALID_VERTEX);
+     marks.assign(n, MARK_NONE);
+     changed.clear();
+     touched.clear();
+     previous.clear();
+
+     heap.clear();
+     distances[source] = 0;
+     heap.insert(source, 0);
+     propagate();
+
+     // A build is not a repair, so nothing counts as changed
+     for (size_t i = 0; i < touched.size(); i++) {
+         marks[touched[i]] = MARK_NONE;
+     }
+     touched.clear();
+     previous.clear();
+     return true;
+ }
+
+ // Repair the tree after the given edges changed weight
+ void DynamicSSSP::repair(const vector<WeightUpdate>& allUpdates) {
+     changed.clear();
+     if (source == INVALID_VERTEX) {
+         return;
+     }
+     graph = CompactGraph(base, metric, false);
+     reverse = CompactGraph(base, metric, true);
+     vector<WeightUpdate> updates;
+     for (size_t i = 0; i < allUpdates.size(); i++) {
+         if (allUpdates[i].metric == metric) {
+             updates.push_back(allUpdates[i]);
+         }
+     }
+     if (updates.empty()) {
+         return;
+     }
+     if (graph.getMinWeight() < 0) {
+         build(source);
+         return;
+     }
+     heap.clear();
+
+     // Tree arcs that got heavier no longer justify the labels below them; each edge is checked in
+     // both directions since either end may be the parent of a two-way edge. Weights are read from the
+     // graph, so an edge updated twice in the batch counts with its final weight, and parallel arcs
+     // count with the lightest
+     vector<VertexId> stack;
+     for (size_t i = 0; i < updates.size(); i++) {
+         VertexId ends[2] = {updates[i].from, updates[i].to};
+         for (int side = 0; side < 2; side++) {
+             VertexId parent = ends[side];
+             VertexId child = ends[1 - side];
+             int weight = graph.getEdgeWeight(parent, child);
+             if (predecessors[child] == parent && marks[child] == MARK_NONE && weight >= 0 &&
+                 distances[parent] + weight > distances[child]) {
+                 marks[child] = MARK_AFFECTED;
+                 stack.push_back(child);
+             }
+         }
+     }
+
+     // The whole subtree below such an arc is affected; a vertex's children are the neighbors whose
+     // predecessor it is, so the subtree is found without child lists
+     vector<VertexId> region;
+     while (!stack.empty()) {
+         VertexId v = stack.back();
+         stack.pop_back();
+         region.push_back(v);
+         for (EdgeId e = graph.edgeBegin(v); e < graph.edgeEnd(v); e++) {
+             VertexId neighbor = graph.edgeTarget(e);
+             if (marks[neighbor] == MARK_NONE && predecessors[neighbor] == v) {
+                 marks[neighbor] = MARK_AFFECTED;
+                 stack.push_back(neighbor);
+             }
+         }
+     }
+     for (size_t i = 0; i < region.size(); i++) {
+         VertexId v = region[i];
+         touched.push_back(v);
+         previous.push_back(distances[v]);
+         distances[v] = INT_MAX;
+         predecessors[v] = INVALID_VERTEX;
+     }
+
+     // Relabel the affected vertices from their unaffected in-neighbors, whose labels still hold
+     for (size_t i = 0; i < region.size(); i++) {
+         VertexId v = region[i];
+         for (EdgeId e = reverse.edgeBegin(v); e < reverse.edgeEnd(v); e++) {
+             VertexId neighbor = reverse.edgeTarget(e);
+             if (marks[neighbor] != MARK_AFFECTED && distances[neighbor] != INT_MAX) {
+                 improve(v, distances[neighbor] + reverse.edgeWeight(e), neighbor);
+             }
+         }
+     }
+
+     // Arcs that got lighter may improve the vertex at their far end
+     for (size_t i = 0; i < updates.size(); i++) {
+         VertexId ends[2] = {updates[i].from, updates[i].to};
+         for (int side = 0; side < 2; side++) {
+             int weight = graph.getEdgeWeight(ends[side], ends[1 - side]);
+             if (distances[ends[side]] != INT_MAX && weight >= 0) {
+                 improve(ends[1 - side], distances[ends[side]] + weight, ends[side]);
+             }
+         }
+     }
+     propagate();
+
+     // Report the vertices that ended up with a different distance, and clear the marks
+     for (size_t i = 0; i < touched.size(); i++) {
+         if (distances[touched[i]] != previous[i]) {
+             changed.push_back(touched[i]);
+         }
+         marks[touched[i]] = MARK_NONE;
+     }
+     touched.clear();
+     previous.clear();
+ }
+
+ // Helper to lower a vertex's label and queue it
+ bool DynamicSSSP::improve(VertexId v, int distance, VertexId predecessor) {
+     if (distance >= distances[v]) {
+         return false;
+     }
+     if (marks[v] == MARK_NONE) {
+         marks[v] = MARK_TOUCHED;
+         touched.push_back(v);
+         previous.push_back(distances[v]);
+     }
+     distances[v] = distance;
+     predecessors[v] = predecessor;
+     if (heap.contains(v)) {
+         heap.decreaseKey(v, distance);
+     } else {
+         heap.insert(v, distance);
+     }
+     return true;
+ }
+
+ // Helper to settle the queued vertices, relaxing arcs out of each
+ void DynamicSSSP::propagate() {
+     while (!heap.isEmpty()) {
+         VertexId current = heap.extractMin();
+         for (EdgeId e = graph.edgeBegin(current); e < graph.edgeEnd(current); e++) {
+             improve(graph.edgeTarget(e), distances[current] + graph.edgeWeight(e), current);
+         }
+     }
+ }
+
+ // Get the source
+ VertexId DynamicSSSP::getSource() const {
+     return source;
+ }
+
+ // Get a vertex's distance (INT_MAX if unreachable)
+ int DynamicSSSP::getDistance(VertexId v) const {
+     return distances[v];
+ }
+
+ // Get the vertex before v on a shortest path
+ VertexId DynamicSSSP::getPredecessor(VertexId v) const {
+     return predecessors[v];
+ }
+
+ // Get the metric the tree minimizes
+ Metric DynamicSSSP::getMetric() const {
+     return metric;
+ }
+
+ // Get the vertices whose distance the last repair changed
+ const vector<VertexId>& DynamicSSSP::getChanged() const {
+     return changed;
+ }
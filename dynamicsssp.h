@@ -0,0 +1,71 @@
+/* File: dynamicsssp.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the DynamicSSSP class, a shortest path tree from one source that is
+ *          repaired after edge weights change instead of being recomputed (after Ramalingam and
+ *          Reps). A heavier tree arc only invalidates the subtree below it; those vertices are
+ *          relabeled from their unaffected neighbors, lighter arcs seed the vertices they improve,
+ *          and one Dijkstra pass over just the changed region settles everything again.
+ *
+ */
+
+ #ifndef DYNAMICSSSP_H
+ #define DYNAMICSSSP_H
+ #include <iostream>
+ #include <vector>
+ #include "compactgraph.h"
+ #include "searchworkspace.h"
+
+ using namespace std;
+
+ class DynamicSSSP {
+     public:
+         // Constructor; the tree follows base weighted by metric, and base must not be rebuilt while the
+         // tree is in use
+         DynamicSSSP(const CompactGraph& base, Metric metric);
+
+         // Compute the tree from source from scratch; false if the source does not exist or a weight is negative
+         bool build(VertexId source);
+
+         // Repair the tree after the given edges changed weight; the graph must already hold the new
+         // weights. Updates of other metrics are ignored. Falls back to a full build if a weight went negative
+         void repair(const vector<WeightUpdate>& updates);
+
+         // Get the metric the tree minimizes
+         Metric getMetric() const;
+
+         // Get the source, a vertex's distance (INT_MAX if unreachable) and the vertex before it on a
+         // shortest path (INVALID_VERTEX for the source and unreachable vertices)
+         VertexId getSource() const;
+         int getDistance(VertexId v) const;
+         VertexId getPredecessor(VertexId v) const;
+
+         // Get the vertices whose distance the last repair changed (empty after a build)
+         const vector<VertexId>& getChanged() const;
+
+     private:
+         const CompactGraph& base;
+         Metric metric;
+         CompactGraph graph;   // Views of base's arcs and reversed arcs weighted by metric, made again
+         CompactGraph reverse; // by every build and repair since updates move base's arrays
+         VertexId source;
+         vector<int> distances;
+         vector<VertexId> predecessors;
+         vector<VertexId> changed;
+         vector<VertexId> touched;      // Vertices whose label the current repair has written
+         vector<int> previous;          // Their distances before the repair, parallel to touched
+         vector<unsigned char> marks;   // During a repair: 1 below a heavier tree arc, 2 otherwise touched
+         DijkstraHeap heap;
+
+         // Helper to lower a vertex's label and queue it; true if the label improved
+         bool improve(VertexId v, int distance, VertexId predecessor);
+
+         // Helper to settle the queued vertices, relaxing arcs out of each
+         void propagate();
+
+         // The tree holds views into base, so it is not copied
+         DynamicSSSP(const DynamicSSSP& other);
+         DynamicSSSP& operator=(const DynamicSSSP& other);
+ };
+
+ #endif // DYNAMICSSSP_H
@@ -0,0 +1,360 @@
+/* File: fastloader.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the FastLoader class.
+ *
+ */
+
+ #include "fastloader.h"
+ #include "mappedfile.h"
+ #include <string_view>
+ #include <charconv>
+ #include <thread>
+ #include <functional>
+ #include <climits>
+ #include <cstring>
+
+ // A parsed vertices file line; the name points into the mapped file
+ struct VertexRecord {
+     string_view name;
+     double x;
+     double y;
+     bool hasCoordinates;
+ };
+
+ // A parsed edges file line, already resolved to vertex IDs
+ struct EdgeRecord {
+     VertexId from;
+     VertexId to;
+     EdgeAttributes attributes;
+     bool oneWay;
+     bool extended; // False for from,to,weight lines, which keep the old merge rules
+ };
+
+ // Helper to strip the whitespace and carriage returns around a field
+ static string_view trim(string_view text) {
+     size_t start = text.find_first_not_of(" \t\r\n");
+     if (start == string_view::npos) {
+         return string_view();
+     }
+     size_t end = text.find_last_not_of(" \t\r\n");
+     return text.substr(start, end - start + 1);
+ }
+
+ // Helper to split a line at commas into at most maxFields fields (the last takes the rest);
+ // returns the number of fields
+ static int splitFields(string_view line, string_view* fields, int maxFields) {
+     int count = 0;
+     while (count < maxFields - 1) {
+         size_t comma = line.find(',');
+         if (comma == string_view::npos) {
+             break;
+         }
+         fields[count++] = line.substr(0, comma);
+         line = line.substr(comma + 1);
+     }
+     fields[count++] = line;
+     return count;
+ }
+
+ // Helper to parse a whole field as a decimal int; false if it is not one or does not fit
+ static bool parseInt(string_view field, int& value) {
+     field = trim(field);
+     size_t i = 0;
+     bool negative = false;
+     if (i < field.size() && (field[i] == '-' || field[i] == '+')) {
+         negative = (field[i] == '-');
+         i++;
+     }
+     if (i == field.size()) {
+         return false;
+     }
+
+     long long result = 0;
+     long long limit = negative ? -(long long)INT_MIN : INT_MAX;
+     for (; i < field.size(); i++) {
+         if (field[i] < '0' || field[i] > '9') {
+             return false;
+         }
+         result = result * 10 + (field[i] - '0');
+         if (result > limit) {
+             return false;
+         }
+     }
+     value = (int)(negative ? -result : result);
+     return true;
+ }
+
+ // Helper to parse a whole field as a double; false if it is not one
+ static bool parseDouble(string_view field, double& value) {
+     field = trim(field);
+     const char* end = field.data() + field.size();
+     from_chars_result result = from_chars(field.data(), end, value);
+     return result.ec == errc() && result.ptr == end && !field.empty();
+ }
+
+ // Worker that parses the vertex lines in [begin, end); stops at the first bad line
+ static void parseVertexChunk(const char* begin, const char* end, vector<VertexRecord>& records, string& error) {
+     const char* line = begin;
+     while (line < end) {
+         const char* newline = (const char*)memchr(line, '\n', end - line);
+         const char* lineEnd = newline ? newline : end;
+         string_view text = trim(string_view(line, lineEnd - line));
+         line = newline ? newline + 1 : end;
+
+         // Skip empty lines
+         if (text.empty()) {
+             continue;
+         }
+
+         // An optional coordinate column may follow the name: name,x,y
+         string_view fields[3];
+         int numFields = splitFields(text, fields, 3);
+         VertexRecord record = {trim(fields[0]), 0.0, 0.0, false};
+         if (numFields == 2) {
+             error = "Error: Malformed vertex line: " + string(text);
+             return;
+         }
+         if (numFields == 3) {
+             if (!parseDouble(fields[1], record.x) || !parseDouble(fields[2], record.y)) {
+                 error = "Error parsing coordinates in '" + string(text) + "'";
+                 return;
+             }
+             record.hasCoordinates = true;
+         }
+         records.push_back(record);
+     }
+ }
+
+ // Worker that parses the edge lines in [begin, end) and resolves their names; edges naming an
+ // unknown location are counted rather than kept. Stops at the first bad line
+ static void parseEdgeChunk(const char* begin, const char* end, const SymbolTable& symbols,
+                            vector<EdgeRecord>& records, size_t& unknown, string& error) {
+     const char* line = begin;
+     while (line < end) {
+         const char* newline = (const char*)memchr(line, '\n', end - line);
+         const char* lineEnd = newline ? newline : end;
+         string_view text = trim(string_view(line, lineEnd - line));
+         line = newline ? newline + 1 : end;
+
+         // Skip empty lines
+         if (text.empty()) {
+             continue;
+         }
+
+         // Parse the CSV line: from,to,length[,time[,class[,oneway|twoway]]]
+         string_view fields[6];
+         int numFields = splitFields(text, fields, 6);
+         if (numFields < 3) {
+             error = "Error: Malformed edge line: " + string(text);
+             return;
+         }
+         EdgeRecord record;
+         int& length = record.attributes.metrics[METRIC_LENGTH];
+         if (!parseInt(fields[2], length)) {
+             error = "Error parsing weight '" + string(trim(fields[2])) + "'";
+             return;
+         }
+
+         // Missing attributes default to the length, class 0 and a two-way edge
+         record.attributes.metrics[METRIC_TIME] = length;
+         record.attributes.edgeClass = 0;
+         record.oneWay = false;
+         record.extended = numFields > 3;
+         if (numFields > 3 && !parseInt(fields[3], record.attributes.metrics[METRIC_TIME])) {
+             error = "Error parsing travel time '" + string(trim(fields[3])) + "'";
+             return;
+         }
+         if (numFields > 4) {
+             int edgeClass;
+             if (!parseInt(fields[4], edgeClass) || edgeClass < 0 || edgeClass > 255) {
+                 error = "Error parsing edge class '" + string(trim(fields[4])) + "'";
+                 return;
+             }
+             record.attributes.edgeClass = edgeClass;
+         }
+         if (numFields > 5) {
+             string_view direction = trim(fields[5]);
+             if (direction == "oneway") {
+                 record.oneWay = true;
+             } else if (direction != "twoway") {
+                 error = "Error parsing direction '" + string(direction) + "'";
+                 return;
+             }
+         }
+
+         // The symbol table is only read here, so the threads can share it
+         record.from = symbols.lookup(trim(fields[0]));
+         record.to = symbols.lookup(trim(fields[1]));
+         if (record.from == INVALID_VERTEX || record.to == INVALID_VERTEX) {
+             unknown++;
+             continue;
+         }
+         records.push_back(record);
+     }
+ }
+
+ // Constructor; numThreads 0 uses one thread per hardware core
+ FastLoader::FastLoader(int threads) : numThreads(threads), verbose(false) {
+     if (numThreads <= 0) {
+         numThreads = thread::hardware_concurrency();
+     }
+     if (numThreads <= 0) {
+         numThreads = 1;
+     }
+ }
+
+ // Print a line for every edge loaded
+ void FastLoader::setVerbose(bool enabled) {
+     verbose = enabled;
+ }
+
+ // Helper to split data into up to numThreads [begin, end) ranges that end on line boundaries
+ vector<pair<size_t, size_t> > FastLoader::splitChunks(const char* data, size_t size) const {
+     vector<pair<size_t, size_t> > chunks;
+     size_t count = numThreads;
+     if (count > size / FAST_LOADER_MIN_CHUNK) {
+         count = size / FAST_LOADER_MIN_CHUNK;
+     }
+     if (count == 0) {
+         count = 1;
+     }
+
+     // Move each even split point forward to just past the next newline
+     size_t start = 0;
+     for (size_t i = 1; i <= count && start < size; i++) {
+         size_t boundary = size;
+         if (i < count) {
+             boundary = size / count * i;
+             if (boundary < start) {
+                 continue;
+             }
+             const char* newline = (const char*)memchr(data + boundary, '\n', size - boundary);
+             boundary = newline ? newline - data + 1 : size;
+         }
+         chunks.push_back(make_pair(start, boundary));
+         start = boundary;
+     }
+     return chunks;
+ }
+
+ // Load a vertices file (name or name,x,y per line) into graph
+ bool FastLoader::loadVertices(const string& filename, Graph& graph) {
+     MappedFile file;
+     if (!file.open(filename)) {
+         return false;
+     }
+
+     // Parse the chunks in parallel; the first runs on this thread
+     vector<pair<size_t, size_t> > chunks = splitChunks(file.getData(), file.getSize());
+     vector<vector<VertexRecord> > records(chunks.size());
+     vector<string> errors(chunks.size());
+     vector<thread> workers;
+     for (size_t i = 1; i < chunks.size(); i++) {
+         workers.push_back(thread(parseVertexChunk, file.getData() + chunks[i].first, file.getData() + chunks[i].second,
+                                  ref(records[i]), ref(errors[i])));
+     }
+     if (!chunks.empty()) {
+         parseVertexChunk(file.getData() + chunks[0].first, file.getData() + chunks[0].second, records[0], errors[0]);
+     }
+     for (size_t i = 0; i < workers.size(); i++) {
+         workers[i].join();
+     }
+
+     // Report the first bad line in file order
+     for (size_t i = 0; i < errors.size(); i++) {
+         if (!errors[i].empty()) {
+             cerr << errors[i] << endl;
+             return false;
+         }
+     }
+
+     // Merge in file order so vertex IDs follow the file
+     for (size_t i = 0; i < records.size(); i++) {
+         for (size_t j = 0; j < records[i].size(); j++) {
+             const VertexRecord& record = records[i][j];
+             string name(record.name);
+             graph.addNode(name);
+             if (record.hasCoordinates) {
+                 graph.setCoordinates(name, record.x, record.y);
+             }
+         }
+     }
+     return true;
+ }
+
+ // Load an edges file (from,to,length[,time[,class[,oneway|twoway]]] per line) into graph; both ends must
+ // be loaded vertices
+ bool FastLoader::loadEdges(const string& filename, Graph& graph) {
+     MappedFile file;
+     if (!file.open(filename)) {
+         return false;
+     }
+
+     // Parse the chunks in parallel; the first runs on this thread
+     vector<pair<size_t, size_t> > chunks = splitChunks(file.getData(), file.getSize());
+     vector<vector<EdgeRecord> > records(chunks.size());
+     vector<size_t> unknown(chunks.size(), 0);
+     vector<string> errors(chunks.size());
+     vector<thread> workers;
+     for (size_t i = 1; i < chunks.size(); i++) {
+         workers.push_back(thread(parseEdgeChunk, file.getData() + chunks[i].first, file.getData() + chunks[i].second,
+                                  cref(graph.getSymbols()), ref(records[i]), ref(unknown[i]), ref(errors[i])));
+     }
+     if (!chunks.empty()) {
+         parseEdgeChunk(file.getData() + chunks[0].first, file.getData() + chunks[0].second,
+                        graph.getSymbols(), records[0], unknown[0], errors[0]);
+     }
+     for (size_t i = 0; i < workers.size(); i++) {
+         workers[i].join();
+     }
+
+     // Report the first bad line in file order
+     for (size_t i = 0; i < errors.size(); i++) {
+         if (!errors[i].empty()) {
+             cerr << errors[i] << endl;
+             return false;
+         }
+     }
+
+     // Size every neighbor map and the edge table up front; rehashing dominates the merge otherwise
+     vector<uint32_t> degrees(graph.getIdBound(), 0);
+     size_t numRecords = 0;
+     for (size_t i = 0; i < records.size(); i++) {
+         numRecords += records[i].size();
+         for (size_t j = 0; j < records[i].size(); j++) {
+             degrees[records[i][j].from]++;
+             degrees[records[i][j].to]++;
+         }
+     }
+     graph.reserveEdges(numRecords);
+     for (size_t v = 0; v < degrees.size(); v++) {
+         Node* node = graph.getNode(VertexId(v));
+         if (node && degrees[v] > 0) {
+             node->reserveNeighbors(node->getNeighbors().size() + degrees[v]);
+         }
+     }
+
+     // Merge in file order, so the first of any repeated from,to,weight edges wins as before; lines
+     // with attributes always add an edge, so parallel roads and ferries each keep their own
+     size_t skipped = 0;
+     for (size_t i = 0; i < records.size(); i++) {
+         skipped += unknown[i];
+         for (size_t j = 0; j < records[i].size(); j++) {
+             const EdgeRecord& record = records[i][j];
+             if (record.extended) {
+                 graph.addEdge(record.from, record.to, record.attributes, record.oneWay);
+             } else {
+                 graph.addEdge(record.from, record.to, record.attributes.metrics[METRIC_LENGTH]);
+             }
+             if (verbose) {
+                 cout << "Loaded edge: " << graph.getName(record.from) << (record.oneWay ? " one way to " : " to ")
+                      << graph.getName(record.to) << " with weight " << record.attributes.metrics[METRIC_LENGTH] << endl;
+             }
+         }
+     }
+     if (skipped > 0) {
+         cerr << "Warning: Skipped " << skipped << " edges between unknown locations" << endl;
+     }
+     return true;
+ }
@@ -0,0 +1,49 @@
+/* File: fastloader.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the FastLoader class, which reads the vertices and edges text files
+ *          into a Graph. Each file is memory-mapped and split at line boundaries into one chunk per
+ *          thread; the threads parse their lines in place as string_views without allocating, and
+ *          the results are merged into the graph in file order.
+ *
+ */
+
+ #ifndef FASTLOADER_H
+ #define FASTLOADER_H
+ #include <iostream>
+ #include <vector>
+ #include <string>
+ #include <utility>
+ #include "graph.h"
+
+ using namespace std;
+
+ // Chunks smaller than this are not worth a thread of their own
+ const size_t FAST_LOADER_MIN_CHUNK = 1 << 20;
+
+ class FastLoader {
+     public:
+         // Constructor; numThreads 0 uses one thread per hardware core
+         FastLoader(int numThreads);
+
+         // Print a line for every edge loaded
+         void setVerbose(bool enabled);
+
+         // Load a vertices file (name or name,x,y per line) into graph
+         bool loadVertices(const string& filename, Graph& graph);
+
+         // Load an edges file into graph; both ends must be loaded vertices. A line is from,to,length and
+         // optionally travel time, edge class (0-255) and oneway or twoway, defaulting to the length, 0 and
+         // twoway. Lines with only a length merge into an existing edge between the same locations as they
+         // always have; longer lines always add one, so parallel edges can be loaded
+         bool loadEdges(const string& filename, Graph& graph);
+
+     private:
+         int numThreads; // Threads used to parse a file
+         bool verbose;   // Whether every loaded edge is printed
+
+         // Helper to split data into up to numThreads [begin, end) ranges that end on line boundaries
+         vector<pair<size_t, size_t> > splitChunks(const char* data, size_t size) const;
+ };
+
+ #endif // FASTLOADER_H
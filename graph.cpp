@@ -6,158 +6,475 @@
  */
 
  #include "graph.h"
+ #include <new>
 
  // Constructor
- Graph::Graph() : numNodes(0), numEdges(0) {}
- 
+ Graph::Graph() : pool(&arena), numNodes(0), numEdges(0), numOneWay(0), version(0) {}
+
  // Destructor to handle memory cleanup
  Graph::~Graph() {
-     // Delete all node objects
-    for (map<string, Node*>::iterator it = nodes.begin(); it != nodes.end(); ++it) {
-        delete it->second;
-    }
+     // Nodes and their neighbor maps hold nothing but arena memory, so they are not destroyed one
+     // by one; the pool and arena release everything when they go
      nodes.clear();
      numNodes = 0;
      numEdges = 0;
+     numOneWay = 0;
  }
- 
- // Add a node to the graph
- void Graph::addNode(const string& id, Node* node) {
-     // Check if node already exists
-     if (nodes.find(id) == nodes.end()) {
-         nodes[id] = node;
-         numNodes++;
-     } else {
-         // Replace existing node (delete old one first)
-         delete nodes[id];
-         nodes[id] = node;
-     }
+
+ // Helper to build a node in the pool
+ Node* Graph::createNode(VertexId id) {
+     void* memory = pool.allocate(sizeof(Node), alignof(Node));
+     return new (memory) Node(id, &pool);
+ }
+
+ // Helper to destroy a node; its map's blocks and its own go back to the pool
+ void Graph::destroyNode(Node* node) {
+     node->~Node();
+     pool.deallocate(node, sizeof(Node), alignof(Node));
  }
- 
+
  // Add a node by ID only (creates a new node)
  void Graph::addNode(const string& id) {
+     VertexId vid = symbols.intern(id);
+     if (vid >= nodes.size()) {
+         nodes.resize(vid + 1, nullptr);
+     }
+
      // Check if node already exists
-     if (nodes.find(id) == nodes.end()) {
-         nodes[id] = new Node(id);
+     if (nodes[vid] == nullptr) {
+         nodes[vid] = createNode(vid);
          numNodes++;
+         version++;
      }
  }
- 
- // Remove a node from the graph
+
+ // Remove a node and its edges from the graph in time proportional to its degree
  void Graph::removeNode(const string& id) {
-    map<string, Node*>::iterator it = nodes.find(id);
-    if (it != nodes.end()) {
-        // First, remove all edges connected to this node
-        Node* nodeToRemove = it->second;
-         
-        // Iterate through all nodes to remove edges to the node being removed
-        for (map<string, Node*>::iterator it = nodes.begin(); it != nodes.end(); ++it) {
-            Node* currentNode = it->second;
-            if (currentNode->hasNeighbor(id)) {
-            currentNode->removeNeighbor(id);
-            numEdges--;
-            }
-        }
-         
-        // Delete the node and remove from map
-        delete nodeToRemove;
-        nodes.erase(it);
-        numNodes--;
+     VertexId vid = getVertexId(id);
+     if (getNode(vid)) {
+         detachNode(vid);
+         version++;
      }
  }
- 
+
+ // Remove a batch of nodes and their edges in time proportional to their total degree
+ int Graph::removeNodes(const vector<VertexId>& ids) {
+     int removed = 0;
+     for (size_t i = 0; i < ids.size(); i++) {
+         if (getNode(ids[i])) {
+             detachNode(ids[i]);
+             removed++;
+         }
+     }
+     if (removed > 0) {
+         version++;
+     }
+     return removed;
+ }
+
+ // Helper to remove the edges of a node from its neighbors and destroy it
+ void Graph::detachNode(VertexId id) {
+     Node* node = nodes[id];
+     const NeighborMap& neighbors = node->getNeighbors();
+     for (NeighborMap::const_iterator it = neighbors.begin(); it != neighbors.end(); ++it) {
+         // A self-loop is stored once, at the node itself
+         if (it->first != id) {
+             nodes[it->first]->removeNeighbor(id, it->second);
+         }
+         freeEdge(it->second);
+     }
+
+     // Destroy the node and leave its slot empty; the name stays interned for reuse
+     destroyNode(node);
+     nodes[id] = nullptr;
+     if (id < hasCoords.size()) {
+         hasCoords[id] = false;
+     }
+     numNodes--;
+ }
+
  // Get a node by its ID
  Node* Graph::getNode(const string& id) {
-    map<string, Node*>::iterator it = nodes.find(id);
-     return (it != nodes.end()) ? it->second : nullptr;
+     return getNode(getVertexId(id));
  }
- 
+
  // Const version for read-only access
  const Node* Graph::getNode(const string& id) const {
-    map<string, Node*>::const_iterator it = nodes.find(id);
-    return (it != nodes.end()) ? it->second : nullptr;
+    return getNode(getVertexId(id));
+ }
+
+ // Get a node by its interned vertex ID
+ Node* Graph::getNode(VertexId id) {
+     return (id < nodes.size()) ? nodes[id] : nullptr;
+ }
+
+ const Node* Graph::getNode(VertexId id) const {
+     return (id < nodes.size()) ? nodes[id] : nullptr;
+ }
+
+ // Get the interned vertex ID of a name (INVALID_VERTEX if it was never added)
+ VertexId Graph::getVertexId(const string& id) const {
+     return symbols.lookup(id);
+ }
+
+ // Get the name for an interned vertex ID
+ const string& Graph::getName(VertexId id) const {
+     return symbols.getName(id);
  }
- 
- // Add a weighted edge between two nodes
+
+ // Get the symbol table shared with the compact views of this graph
+ const SymbolTable& Graph::getSymbols() const {
+     return symbols;
+ }
+
+ // Get one past the largest vertex ID in use (removed nodes leave holes)
+ int Graph::getIdBound() const {
+     return nodes.size();
+ }
+
+ // Renumber the nodes so that order[i] becomes ID i
+ bool Graph::renumber(const vector<VertexId>& order) {
+     // Check that order lists every node once, and invert it
+     if ((int)order.size() != numNodes) {
+         return false;
+     }
+     vector<VertexId> newIds(nodes.size(), INVALID_VERTEX);
+     for (size_t i = 0; i < order.size(); i++) {
+         if (!getNode(order[i]) || newIds[order[i]] != INVALID_VERTEX) {
+             return false;
+         }
+         newIds[order[i]] = i;
+     }
+
+     // Move every node, name and coordinate to its new ID
+     SymbolTable newSymbols;
+     vector<Node*> newNodes(order.size(), nullptr);
+     vector<double> newX(order.size(), 0.0);
+     vector<double> newY(order.size(), 0.0);
+     vector<bool> newHasCoords(order.size(), false);
+     for (size_t i = 0; i < order.size(); i++) {
+         VertexId old = order[i];
+         Node* node = nodes[old];
+         node->setId(i);
+         node->renumberNeighbors(newIds);
+         newNodes[i] = node;
+         newSymbols.intern(symbols.getName(old));
+         if (hasCoordinates(old)) {
+             newX[i] = xCoords[old];
+             newY[i] = yCoords[old];
+             newHasCoords[i] = true;
+         }
+     }
+     for (size_t e = 0; e < edgeFrom.size(); e++) {
+         if (edgeFrom[e] != INVALID_VERTEX) {
+             edgeFrom[e] = newIds[edgeFrom[e]];
+             edgeTo[e] = newIds[edgeTo[e]];
+         }
+     }
+     symbols = newSymbols;
+     nodes.swap(newNodes);
+     xCoords.swap(newX);
+     yCoords.swap(newY);
+     hasCoords.swap(newHasCoords);
+     version++;
+     return true;
+ }
+
+ // Add a two-way edge between two nodes unless they already share an edge
  void Graph::addEdge(const string& fromNodeId, const string& toNodeId, int weight) {
+     addEdge(getVertexId(fromNodeId), getVertexId(toNodeId), weight);
+ }
+
+ // Add a two-way edge between two nodes by vertex ID unless they already share an edge
+ void Graph::addEdge(VertexId fromNodeId, VertexId toNodeId, int weight) {
      Node* fromNode = getNode(fromNodeId);
-     Node* toNode = getNode(toNodeId);
-     
-     if (fromNode && toNode) {
-         // For undirected graph, add edges in both directions
-         // Only count as one edge for numEdges
-         if (!fromNode->hasNeighbor(toNodeId)) {
-             fromNode->addNeighbor(toNodeId, weight);
-             toNode->addNeighbor(fromNodeId, weight); // Add in opposite direction too
-             numEdges++;
+     if (fromNode && getNode(toNodeId) && !fromNode->hasNeighbor(toNodeId)) {
+         // A plain weighted edge has the same length and travel time
+         EdgeAttributes attributes;
+         for (int m = 0; m < NUM_METRICS; m++) {
+             attributes.metrics[m] = weight;
          }
+         attributes.edgeClass = 0;
+         addEdge(fromNodeId, toNodeId, attributes, false);
      }
  }
- 
- // Remove an edge between two nodes
- void Graph::removeEdge(const string& fromNodeId, const string& toNodeId) {
+
+ // Add an edge with the given attributes, even beside other edges between the same nodes
+ EdgeId Graph::addEdge(VertexId fromNodeId, VertexId toNodeId, const EdgeAttributes& attributes, bool oneWay) {
      Node* fromNode = getNode(fromNodeId);
      Node* toNode = getNode(toNodeId);
-     
-     if (fromNode && toNode) {
-         // Remove edges in both directions
-         if (fromNode->hasNeighbor(toNodeId)) {
-             fromNode->removeNeighbor(toNodeId);
-             toNode->removeNeighbor(fromNodeId);
-             numEdges--;
+     if (!fromNode || !toNode) {
+         return INVALID_EDGE;
+     }
+
+     // Reuse the ID of a removed edge before growing the table
+     EdgeId e;
+     if (!freeEdges.empty()) {
+         e = freeEdges.back();
+         freeEdges.pop_back();
+     } else {
+         e = edgeFrom.size();
+         edgeFrom.push_back(INVALID_VERTEX);
+         edgeTo.push_back(INVALID_VERTEX);
+         for (int m = 0; m < NUM_METRICS; m++) {
+             edgeMetrics[m].push_back(0);
+         }
+         edgeClasses.push_back(0);
+         edgeOneWay.push_back(0);
+     }
+     edgeFrom[e] = fromNodeId;
+     edgeTo[e] = toNodeId;
+     for (int m = 0; m < NUM_METRICS; m++) {
+         edgeMetrics[m][e] = attributes.metrics[m];
+     }
+     edgeClasses[e] = attributes.edgeClass;
+     edgeOneWay[e] = oneWay;
+
+     // Both ends list the edge, so removing either node finds it; a self-loop is listed once
+     fromNode->addNeighbor(toNodeId, e);
+     if (toNodeId != fromNodeId) {
+         toNode->addNeighbor(fromNodeId, e);
+     }
+     numEdges++;
+     if (oneWay) {
+         numOneWay++;
+     }
+     version++;
+     return e;
+ }
+
+ // Make room for count more edges so bulk loading does not regrow the edge table
+ void Graph::reserveEdges(size_t count) {
+     size_t size = edgeFrom.size() + count;
+     edgeFrom.reserve(size);
+     edgeTo.reserve(size);
+     for (int m = 0; m < NUM_METRICS; m++) {
+         edgeMetrics[m].reserve(size);
+     }
+     edgeClasses.reserve(size);
+     edgeOneWay.reserve(size);
+ }
+
+ // Helper to take an edge out of the edge table once both ends have forgotten it
+ void Graph::freeEdge(EdgeId e) {
+     if (edgeOneWay[e]) {
+         numOneWay--;
+     }
+     edgeFrom[e] = INVALID_VERTEX;
+     edgeTo[e] = INVALID_VERTEX;
+     freeEdges.push_back(e);
+     numEdges--;
+ }
+
+ // Set one metric of every edge that leads from one node to another
+ bool Graph::updateEdgeWeight(const string& fromNodeId, const string& toNodeId, Metric metric, int weight) {
+     return updateEdgeWeight(getVertexId(fromNodeId), getVertexId(toNodeId), metric, weight);
+ }
+
+ // Set one metric of every edge that leads from one node to another, by vertex ID
+ bool Graph::updateEdgeWeight(VertexId fromNodeId, VertexId toNodeId, Metric metric, int weight) {
+     Node* fromNode = getNode(fromNodeId);
+     if (!fromNode || !getNode(toNodeId)) {
+         return false;
+     }
+
+     // Parallel edges that lead the same way all take the new value; a one-way edge back is untouched
+     bool found = false;
+     bool changed = false;
+     pair<NeighborMap::const_iterator, NeighborMap::const_iterator> range =
+         fromNode->getNeighbors().equal_range(toNodeId);
+     for (NeighborMap::const_iterator it = range.first; it != range.second; ++it) {
+         EdgeId e = it->second;
+         if (leadsFrom(e, fromNodeId, toNodeId)) {
+             found = true;
+             if (edgeMetrics[metric][e] != weight) {
+                 edgeMetrics[metric][e] = weight;
+                 changed = true;
+             }
+         }
+     }
+     if (changed) {
+         version++;
+     }
+     return found;
+ }
+
+ // Apply a batch of metric updates, skipping missing edges
+ int Graph::updateEdgeWeights(const vector<WeightUpdate>& updates) {
+     int changed = 0;
+     for (size_t i = 0; i < updates.size(); i++) {
+         if (updateEdgeWeight(updates[i].from, updates[i].to, updates[i].metric, updates[i].weight)) {
+             changed++;
          }
      }
+     return changed;
  }
- 
+
+ // Remove every edge between two nodes, whichever way it runs
+ void Graph::removeEdge(const string& fromNodeId, const string& toNodeId) {
+     VertexId fromId = getVertexId(fromNodeId);
+     VertexId toId = getVertexId(toNodeId);
+     Node* fromNode = getNode(fromId);
+     Node* toNode = getNode(toId);
+
+     if (fromNode && toNode && fromNode->hasNeighbor(toId)) {
+         // Forget each edge at the far end, then drop them all from this end at once
+         pair<NeighborMap::const_iterator, NeighborMap::const_iterator> range =
+             fromNode->getNeighbors().equal_range(toId);
+         for (NeighborMap::const_iterator it = range.first; it != range.second; ++it) {
+             if (toId != fromId) {
+                 toNode->removeNeighbor(fromId, it->second);
+             }
+             freeEdge(it->second);
+         }
+         fromNode->removeNeighbor(toId);
+         version++;
+     }
+ }
+
+ // Get one past the largest edge ID in use
+ int Graph::getEdgeBound() const {
+     return edgeFrom.size();
+ }
+
+ // Check if an edge ID is in use
+ bool Graph::isEdgeLive(EdgeId e) const {
+     return e < edgeFrom.size() && edgeFrom[e] != INVALID_VERTEX;
+ }
+
+ // Get the attributes of an edge in use
+ VertexId Graph::getEdgeFrom(EdgeId e) const {
+     return edgeFrom[e];
+ }
+
+ VertexId Graph::getEdgeTo(EdgeId e) const {
+     return edgeTo[e];
+ }
+
+ int Graph::getEdgeMetric(EdgeId e, Metric metric) const {
+     return edgeMetrics[metric][e];
+ }
+
+ EdgeClass Graph::getEdgeClass(EdgeId e) const {
+     return edgeClasses[e];
+ }
+
+ bool Graph::isOneWay(EdgeId e) const {
+     return edgeOneWay[e] != 0;
+ }
+
+ // Check if an edge can be travelled from one node to the other
+ bool Graph::leadsFrom(EdgeId e, VertexId fromNodeId, VertexId toNodeId) const {
+     if (edgeFrom[e] == fromNodeId && edgeTo[e] == toNodeId) {
+         return true;
+     }
+     return !edgeOneWay[e] && edgeFrom[e] == toNodeId && edgeTo[e] == fromNodeId;
+ }
+
+ // Check if any edge is one-way
+ bool Graph::hasOneWayEdges() const {
+     return numOneWay > 0;
+ }
+
  // Get the neighbors of a node
  vector<Node*> Graph::getNeighbors(const string& nodeId) {
      vector<Node*> neighborNodes;
      Node* node = getNode(nodeId);
-     
+
     if (node) {
-        const unordered_map<string, int>& neighbors = node->getNeighbors();
-        for (unordered_map<string, int>::const_iterator it = neighbors.begin(); it != neighbors.end(); ++it) {
+        const NeighborMap& neighbors = node->getNeighbors();
+        for (NeighborMap::const_iterator it = neighbors.begin(); it != neighbors.end(); ++it) {
            Node* neighborNode = getNode(it->first);
            if (neighborNode) {
               neighborNodes.push_back(neighborNode);
            }
         }
     }
-     
+
      return neighborNodes;
  }
- 
+
  // Get all nodes in the graph
  vector<Node*> Graph::getAllNodes() {
      vector<Node*> allNodes;
-     allNodes.reserve(nodes.size());
-     
-    for (map<string, Node*>::iterator it = nodes.begin(); it != nodes.end(); ++it) {
-        Node* node = it->second;
-        allNodes.push_back(node);
+     allNodes.reserve(numNodes);
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i]) {
+            allNodes.push_back(nodes[i]);
+        }
     }
-     
+
      return allNodes;
  }
- 
+
  // Get all node IDs in the graph
  vector<string> Graph::getAllNodeIds() const {
      vector<string> ids;
-     ids.reserve(nodes.size());
-     
-    for (map<string, Node*>::const_iterator it = nodes.begin(); it != nodes.end(); ++it) {
-        ids.push_back(it->first);
+     ids.reserve(numNodes);
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodes[i]) {
+            ids.push_back(symbols.getName(i));
+        }
     }
-     
+
      return ids;
  }
- 
+
+ // Set the planar coordinates of a node
+ void Graph::setCoordinates(const string& id, double x, double y) {
+     VertexId vid = getVertexId(id);
+     if (!getNode(vid)) {
+         return;
+     }
+     if (vid >= hasCoords.size()) {
+         xCoords.resize(vid + 1, 0.0);
+         yCoords.resize(vid + 1, 0.0);
+         hasCoords.resize(vid + 1, false);
+     }
+     xCoords[vid] = x;
+     yCoords[vid] = y;
+     hasCoords[vid] = true;
+ }
+
+ // Check if a node has coordinates, and get them
+ bool Graph::hasCoordinates(VertexId id) const {
+     return id < hasCoords.size() && hasCoords[id];
+ }
+
+ double Graph::getX(VertexId id) const {
+     return hasCoordinates(id) ? xCoords[id] : 0.0;
+ }
+
+ double Graph::getY(VertexId id) const {
+     return hasCoordinates(id) ? yCoords[id] : 0.0;
+ }
+
+ // Check if every node in the graph has coordinates
+ bool Graph::hasCoordinates() const {
+     if (numNodes == 0) {
+         return false;
+     }
+     for (size_t i = 0; i < nodes.size(); i++) {
+         if (nodes[i] && !hasCoordinates(i)) {
+             return false;
+         }
+     }
+     return true;
+ }
+
  // Get the number of nodes in the graph
  int Graph::getNumNodes() const {
      return numNodes;
  }
- 
+
  // Get the number of edges in the graph
  int Graph::getNumEdges() const {
      return numEdges;
- }
\ No newline at end of file
+ }
+
+ // Get the version of the graph
+ unsigned long long Graph::getVersion() const {
+     return version;
+ }
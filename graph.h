@@ -8,12 +8,40 @@
  #ifndef GRAPH_H
  #define GRAPH_H
  #include <iostream>
- #include <map>
  #include <vector>
  #include <string>
+ #include <memory_resource>
  #include "node.h"
+ #include "symboltable.h"
  
  using namespace std;
+
+ // Sentinel for "no edge" (an edge between missing nodes)
+ const EdgeId INVALID_EDGE = numeric_limits<EdgeId>::max();
+
+ // The values every edge carries, one of which a query minimizes
+ enum Metric {
+     METRIC_LENGTH, // Distance; what the weight column of an edges file gives
+     METRIC_TIME,   // Travel time
+     NUM_METRICS
+ };
+
+ // Kind of road an edge is (highway, track, ferry, ...); the map decides what the numbers mean
+ typedef unsigned char EdgeClass;
+
+ // The attributes of one edge
+ struct EdgeAttributes {
+     int metrics[NUM_METRICS];
+     EdgeClass edgeClass;
+ };
+
+ // A new value of one metric for the edges that lead from one vertex to another
+ struct WeightUpdate {
+     VertexId from;
+     VertexId to;
+     int weight;
+     Metric metric;
+ };
  
  class Graph {
      public:
@@ -23,26 +51,84 @@
          // Destructor to handle memory cleanup
          ~Graph();
  
-         // Add a node to the graph
-         void addNode(const string& id, Node* node);
-         
          // Add a node by ID only (creates a new node)
          void addNode(const string& id);
  
-         // Remove a node from the graph
+         // Remove a node and its edges from the graph in time proportional to its degree
          void removeNode(const string& id);
+
+         // Remove a batch of nodes and their edges in time proportional to their total degree, bumping
+         // the version once; IDs that are not in use are skipped. Returns the number removed
+         int removeNodes(const vector<VertexId>& ids);
  
          // Get a node by its ID
          Node* getNode(const string& id);
          
          // Const version for read-only access
          const Node* getNode(const string& id) const;
+
+         // Get a node by its interned vertex ID
+         Node* getNode(VertexId id);
+         const Node* getNode(VertexId id) const;
+
+         // Get the interned vertex ID of a name (INVALID_VERTEX if it was never added)
+         VertexId getVertexId(const string& id) const;
+
+         // Get the name for an interned vertex ID
+         const string& getName(VertexId id) const;
+
+         // Get the symbol table shared with the compact views of this graph
+         const SymbolTable& getSymbols() const;
+
+         // Get one past the largest vertex ID in use (removed nodes leave holes)
+         int getIdBound() const;
+
+         // Renumber the nodes so that order[i], an ID in use, becomes ID i; every node must appear
+         // exactly once. Names, edges, weights and coordinates move with their nodes, so lookups by
+         // name are unchanged, and the names of removed nodes are dropped. False, changing nothing,
+         // if order is not such a list
+         bool renumber(const vector<VertexId>& order);
  
-         // Add a weighted edge between two nodes
+         // Add a two-way edge between two nodes with every metric set to weight, unless the nodes already
+         // share an edge (which keeps its attributes; see updateEdgeWeight)
          void addEdge(const string& fromNodeId, const string& toNodeId, int weight);
+
+         // Add a two-way edge between two nodes by vertex ID, as above
+         void addEdge(VertexId fromNodeId, VertexId toNodeId, int weight);
+
+         // Add an edge with the given attributes, even beside other edges between the same nodes; a one-way
+         // edge can only be travelled from fromNodeId. Returns its edge ID (INVALID_EDGE if a node is missing)
+         EdgeId addEdge(VertexId fromNodeId, VertexId toNodeId, const EdgeAttributes& attributes, bool oneWay);
+
+         // Make room for count more edges so bulk loading does not regrow the edge table
+         void reserveEdges(size_t count);
  
-         // Remove an edge between two nodes
+         // Set one metric of every edge that leads from one node to another; false if there is no such edge
+         bool updateEdgeWeight(const string& fromNodeId, const string& toNodeId, Metric metric, int weight);
+         bool updateEdgeWeight(VertexId fromNodeId, VertexId toNodeId, Metric metric, int weight);
+
+         // Apply a batch of metric updates, skipping missing edges; returns the number applied
+         int updateEdgeWeights(const vector<WeightUpdate>& updates);
+ 
+         // Remove every edge between two nodes, whichever way it runs
          void removeEdge(const string& fromNodeId, const string& toNodeId);
+
+         // Get one past the largest edge ID in use (removed edges leave holes until they are reused)
+         int getEdgeBound() const;
+
+         // Check if an edge ID is in use, and get the attributes of an edge in use
+         bool isEdgeLive(EdgeId e) const;
+         VertexId getEdgeFrom(EdgeId e) const;
+         VertexId getEdgeTo(EdgeId e) const;
+         int getEdgeMetric(EdgeId e, Metric metric) const;
+         EdgeClass getEdgeClass(EdgeId e) const;
+         bool isOneWay(EdgeId e) const;
+
+         // Check if an edge can be travelled from one node to the other
+         bool leadsFrom(EdgeId e, VertexId fromNodeId, VertexId toNodeId) const;
+
+         // Check if any edge is one-way
+         bool hasOneWayEdges() const;
  
          // Get the neighbors of a node
          vector<Node*> getNeighbors(const string& nodeId);
@@ -53,16 +139,66 @@
          // Get all node IDs in the graph
          vector<string> getAllNodeIds() const;
  
+         // Set the planar coordinates of a node
+         void setCoordinates(const string& id, double x, double y);
+
+         // Check if a node has coordinates, and get them
+         bool hasCoordinates(VertexId id) const;
+         double getX(VertexId id) const;
+         double getY(VertexId id) const;
+
+         // Check if every node in the graph has coordinates
+         bool hasCoordinates() const;
+
          // Get the number of nodes in the graph
          int getNumNodes() const;
  
-         // Get the number of edges in the graph
+         // Get the number of edges in the graph (parallel edges each count)
          int getNumEdges() const;
+
+         // Get the version of the graph; every change to its nodes, edges or weights bumps it, so
+         // anything derived from the graph can tell it is out of date
+         unsigned long long getVersion() const;
  
      private:
-         map<string, Node*> nodes; // A map to store nodes with their IDs as keys
+         // Nodes and their neighbor maps are carved from the arena through the pool, which recycles the
+         // blocks of removed nodes and of maps that grew. Destroying the graph hands back the arena's few
+         // large chunks instead of freeing every node and map entry one at a time
+         pmr::monotonic_buffer_resource arena;
+         pmr::unsynchronized_pool_resource pool;
+         SymbolTable symbols; // Interned node names; each name is stored once
+         vector<Node*> nodes; // Nodes indexed by vertex ID (nullptr for removed or unused IDs)
+         vector<double> xCoords; // Optional coordinates indexed by vertex ID
+         vector<double> yCoords;
+         vector<bool> hasCoords; // Whether the node with this ID was given coordinates
          int numNodes; // The number of nodes in the graph
          int numEdges; // The number of edges in the graph
+         int numOneWay; // How many of them are one-way
+
+         // The edge table, one array per attribute indexed by edge ID, so a pass over one metric reads
+         // nothing else. Removed edges are marked in edgeFrom and their IDs reused
+         vector<VertexId> edgeFrom; // INVALID_VERTEX for an ID not in use
+         vector<VertexId> edgeTo;
+         vector<int> edgeMetrics[NUM_METRICS];
+         vector<EdgeClass> edgeClasses;
+         vector<unsigned char> edgeOneWay;
+         vector<EdgeId> freeEdges; // Removed edge IDs waiting for reuse
+         unsigned long long version; // Bumped by every change to the nodes, edges or weights
+
+         // Helpers to build a node in the pool, and to destroy one and return its memory for reuse
+         Node* createNode(VertexId id);
+         void destroyNode(Node* node);
+
+         // Helper to remove the edges of a node from its neighbors and destroy it. Every edge is stored at
+         // both ends, so the node's own neighbors are the only nodes that point at it
+         void detachNode(VertexId id);
+
+         // Helper to take an edge out of the edge table once both ends have forgotten it
+         void freeEdge(EdgeId e);
+
+         // Nodes live in the graph's arena, so graphs are not copied
+         Graph(const Graph& other);
+         Graph& operator=(const Graph& other);
  };
  
  #endif // GRAPH_H
\ No newline at end of file
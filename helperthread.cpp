@@ -0,0 +1,67 @@
+/* File: helperthread.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the HelperThread class.
+ *
+ */
+
+ #include "helperthread.h"
+
+ // Constructor and destructor
+ HelperThread::HelperThread() : task(nullptr), argument(nullptr), pending(false), stopping(false), started(false) {}
+
+ HelperThread::~HelperThread() {
+     if (!started) {
+         return;
+     }
+     {
+         lock_guard<mutex> guard(lock);
+         stopping = true;
+     }
+     wake.notify_one();
+     worker.join();
+ }
+
+ // Start task(argument) on the helper thread; the previous task must have been waited for
+ void HelperThread::run(void (*newTask)(void*), void* newArgument) {
+     {
+         lock_guard<mutex> guard(lock);
+         task = newTask;
+         argument = newArgument;
+         pending = true;
+     }
+     if (!started) {
+         started = true;
+         worker = thread(loop, this);
+     } else {
+         wake.notify_one();
+     }
+ }
+
+ // Wait until the task started by run has finished
+ void HelperThread::wait() {
+     unique_lock<mutex> guard(lock);
+     while (pending) {
+         finished.wait(guard);
+     }
+ }
+
+ // The worker's loop: run each task handed over until told to stop
+ void HelperThread::loop(HelperThread* self) {
+     unique_lock<mutex> guard(self->lock);
+     while (true) {
+         while (!self->pending && !self->stopping) {
+             self->wake.wait(guard);
+         }
+         if (self->stopping) {
+             return;
+         }
+
+         // The task runs unlocked, so the caller can work on its own half meanwhile
+         guard.unlock();
+         self->task(self->argument);
+         guard.lock();
+         self->pending = false;
+         self->finished.notify_one();
+     }
+ }
@@ -0,0 +1,49 @@
+/* File: helperthread.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the HelperThread class, one worker thread that a finder keeps for
+ *          the second half of its parallel searches. The thread is started on first use and then
+ *          sleeps between tasks, so a query hands work over instead of starting a thread.
+ *
+ */
+
+ #ifndef HELPERTHREAD_H
+ #define HELPERTHREAD_H
+ #include <thread>
+ #include <mutex>
+ #include <condition_variable>
+
+ using namespace std;
+
+ class HelperThread {
+     public:
+         // Constructor and destructor; the destructor stops the thread if it was started
+         HelperThread();
+         ~HelperThread();
+
+         // Start task(argument) on the helper thread; the previous task must have been waited for
+         void run(void (*task)(void*), void* argument);
+
+         // Wait until the task started by run has finished
+         void wait();
+
+     private:
+         thread worker;
+         mutex lock;
+         condition_variable wake;     // Signals the worker that a task is pending or it should stop
+         condition_variable finished; // Signals run's caller that the task is done
+         void (*task)(void*);
+         void* argument;
+         bool pending;   // A task has been handed over and not finished yet
+         bool stopping;
+         bool started;
+
+         // The worker's loop: run each task handed over until told to stop
+         static void loop(HelperThread* self);
+
+         // The thread refers to this object, so it is not copied
+         HelperThread(const HelperThread& other);
+         HelperThread& operator=(const HelperThread& other);
+ };
+
+ #endif // HELPERTHREAD_H
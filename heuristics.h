@@ -0,0 +1,66 @@
+/* File: heuristics.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the A* heuristics that ship with PathFinder. Each heuristic is a small functor built
+ *          for one target that returns a lower bound on the distance from a vertex to that target.
+ *          They are passed to PathFinder::findPathAStar as a template parameter so the call inlines.
+ *
+ */
+
+ #ifndef HEURISTICS_H
+ #define HEURISTICS_H
+ #include <cmath>
+ #include "compactgraph.h"
+
+ using namespace std;
+
+ // Always 0: A* with this heuristic settles vertices exactly like Dijkstra's algorithm
+ class ZeroHeuristic {
+     public:
+         ZeroHeuristic(const CompactGraph& g, VertexId target) {}
+
+         int operator()(VertexId v) const {
+             return 0;
+         }
+ };
+
+ // Straight-line distance to the target, scaled so it never exceeds the remaining path weight
+ class EuclideanHeuristic {
+     public:
+         EuclideanHeuristic(const CompactGraph& g, VertexId target)
+             : graph(g), targetX(g.getX(target)), targetY(g.getY(target)), scale(g.getEuclideanScale()) {}
+
+         int operator()(VertexId v) const {
+             double dx = graph.getX(v) - targetX;
+             double dy = graph.getY(v) - targetY;
+             // Rounding down keeps the bound admissible and consistent with integer weights
+             return (int)floor(scale * sqrt(dx * dx + dy * dy));
+         }
+
+     private:
+         const CompactGraph& graph;
+         double targetX;
+         double targetY;
+         double scale;
+ };
+
+ // Manhattan distance to the target, scaled so it never exceeds the remaining path weight
+ class ManhattanHeuristic {
+     public:
+         ManhattanHeuristic(const CompactGraph& g, VertexId target)
+             : graph(g), targetX(g.getX(target)), targetY(g.getY(target)), scale(g.getManhattanScale()) {}
+
+         int operator()(VertexId v) const {
+             double distance = fabs(graph.getX(v) - targetX) + fabs(graph.getY(v) - targetY);
+             // Rounding down keeps the bound admissible and consistent with integer weights
+             return (int)floor(scale * distance);
+         }
+
+     private:
+         const CompactGraph& graph;
+         double targetX;
+         double targetY;
+         double scale;
+ };
+
+ #endif // HEURISTICS_H
@@ -0,0 +1,254 @@
+/* File: kshortestpaths.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the KShortestPaths class.
+ *
+ */
+
+ #include "kshortestpaths.h"
+ #include <atomic>
+ #include <thread>
+ #include <functional>
+ #include <algorithm>
+ #include <set>
+ #include <climits>
+
+ // A path waiting to be accepted, with the index of the vertex where it left the path it was spurred from
+ struct Candidate {
+     long long weight;
+     vector<VertexId> vertices;
+     size_t deviation;
+
+     // Order by weight, then by the vertices so equal paths meet and ties come out the same every run
+     bool operator<(const Candidate& other) const {
+         if (weight != other.weight) {
+             return weight < other.weight;
+         }
+         return vertices < other.vertices;
+     }
+ };
+
+ // What the threads of one round share: the spur searches along the path accepted last
+ struct SpurRound {
+     const CompactGraph* graph;
+     const SearchWorkspace* tree;           // Distances to the end on the full graph
+     VertexId end;
+     const vector<vector<VertexId> >* accepted;
+     const vector<VertexId>* path;          // The path accepted last
+     size_t first;                          // First spur index worth searching
+     atomic<size_t> next;                   // Next spur index to claim
+     vector<vector<VertexId> > spurPaths;   // spurPaths[i - first] runs from the spur vertex to the end
+     vector<int> spurWeights;               // Weight of each spur path, or -1 if there is none
+ };
+
+ // Helper to search from spur index i of the round's path to the end without its root vertices and
+ // without the arcs the accepted paths sharing its root take out of the spur vertex
+ static void spurSearch(SpurRound& round, size_t i, SearchWorkspace& workspace) {
+     const CompactGraph& g = *round.graph;
+     const SearchWorkspace& tree = *round.tree;
+     const vector<VertexId>& path = *round.path;
+     const vector<vector<VertexId> >& accepted = *round.accepted;
+     VertexId spur = path[i];
+     workspace.reset(g.getNumVertices());
+
+     // Settled vertices are never relaxed again, so settling the root keeps the search off it
+     for (size_t j = 0; j < i; j++) {
+         workspace.settle(path[j]);
+     }
+     vector<VertexId> blocked;
+     for (size_t p = 0; p < accepted.size(); p++) {
+         const vector<VertexId>& other = accepted[p];
+         if (other.size() > i + 1 && equal(path.begin(), path.begin() + i + 1, other.begin())) {
+             blocked.push_back(other[i + 1]);
+         }
+     }
+
+     // A* with the exact distances of the full graph, which never overestimate in a smaller one
+     DijkstraHeap& pq = workspace.getHeap();
+     workspace.setLabel(spur, 0, INVALID_VERTEX);
+     pq.insert(spur, tree.getDistance(spur));
+     bool found = false;
+     while (!pq.isEmpty()) {
+         VertexId current = pq.extractMin();
+         if (workspace.isSettled(current)) {
+             continue;
+         }
+         workspace.settle(current);
+         if (current == round.end) {
+             found = true;
+             break;
+         }
+
+         for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+             VertexId neighbor = g.edgeTarget(e);
+             int remaining = tree.getDistance(neighbor);
+             if (workspace.isSettled(neighbor) || remaining == INT_MAX) {
+                 continue;
+             }
+             if (current == spur && find(blocked.begin(), blocked.end(), neighbor) != blocked.end()) {
+                 continue;
+             }
+             int newDistance = workspace.getDistance(current) + g.edgeWeight(e);
+             if (newDistance < workspace.getDistance(neighbor)) {
+                 workspace.setLabel(neighbor, newDistance, current);
+                 if (pq.contains(neighbor)) {
+                     pq.decreaseKey(neighbor, newDistance + remaining);
+                 } else {
+                     pq.insert(neighbor, newDistance + remaining);
+                 }
+             }
+         }
+     }
+
+     vector<VertexId>& spurPath = round.spurPaths[i - round.first];
+     if (!found) {
+         round.spurWeights[i - round.first] = -1;
+         return;
+     }
+     for (VertexId v = round.end; v != INVALID_VERTEX; v = workspace.getPredecessor(v)) {
+         spurPath.push_back(v);
+     }
+     reverse(spurPath.begin(), spurPath.end());
+     round.spurWeights[i - round.first] = workspace.getDistance(round.end);
+ }
+
+ // Worker that runs spur searches until the round has none left
+ static void spurWorker(SpurRound& round, SearchWorkspace& workspace) {
+     while (true) {
+         size_t i = round.next.fetch_add(1);
+         if (i + 1 >= round.path->size()) {
+             break;
+         }
+         spurSearch(round, i, workspace);
+     }
+ }
+
+ // Constructor
+ KShortestPaths::KShortestPaths(const CompactGraph& g, const CompactGraph& reverse, SearchWorkspace& treeWorkspace,
+                                SearchWorkspace& spurWorkspace, int threads)
+     : graph(g), backward(reverse), tree(treeWorkspace), spurSpace(spurWorkspace), numThreads(threads) {
+     if (numThreads <= 0) {
+         numThreads = thread::hardware_concurrency();
+     }
+     if (numThreads <= 0) {
+         numThreads = 1;
+     }
+ }
+
+ // Compute the distance to end from every vertex with a search from end over the reversed arcs
+ void KShortestPaths::computeTree(VertexId end) {
+     tree.reset(graph.getNumVertices());
+     DijkstraHeap& pq = tree.getHeap();
+     tree.setLabel(end, 0, INVALID_VERTEX);
+     pq.insert(end, 0);
+     while (!pq.isEmpty()) {
+         VertexId current = pq.extractMin();
+         tree.settle(current);
+         for (EdgeId e = backward.edgeBegin(current); e < backward.edgeEnd(current); e++) {
+             VertexId neighbor = backward.edgeTarget(e);
+             if (tree.isSettled(neighbor)) {
+                 continue;
+             }
+             int newDistance = tree.getDistance(current) + backward.edgeWeight(e);
+             if (newDistance < tree.getDistance(neighbor)) {
+                 tree.setLabel(neighbor, newDistance, current);
+                 if (pq.contains(neighbor)) {
+                     pq.decreaseKey(neighbor, newDistance);
+                 } else {
+                     pq.insert(neighbor, newDistance);
+                 }
+             }
+         }
+     }
+ }
+
+ // Find up to k loopless paths from start to end, shortest first
+ bool KShortestPaths::find(VertexId start, VertexId end, int k, vector<vector<VertexId> >& paths,
+                           vector<long long>& weights) {
+     paths.clear();
+     weights.clear();
+     if (graph.getMinWeight() < 0) {
+         cerr << "Error: K shortest paths need non-negative weights" << endl;
+         return false;
+     }
+     int n = graph.getNumVertices();
+     if (start >= (VertexId)n || end >= (VertexId)n) {
+         cerr << "Error: Start or end node does not exist" << endl;
+         return false;
+     }
+     if (k <= 0) {
+         return true;
+     }
+
+     // The tree from the end also holds the shortest path itself
+     computeTree(end);
+     if (tree.getDistance(start) == INT_MAX) {
+         return true;
+     }
+     vector<VertexId> shortest;
+     for (VertexId v = start; v != INVALID_VERTEX; v = tree.getPredecessor(v)) {
+         shortest.push_back(v);
+     }
+     paths.push_back(shortest);
+     weights.push_back(tree.getDistance(start));
+     vector<size_t> deviations(1, 0);
+
+     // Workspaces for the extra threads are made once and reused by every round
+     vector<SearchWorkspace> extraWorkspaces(numThreads - 1);
+     set<Candidate> candidates;
+
+     while ((int)paths.size() < k) {
+         const vector<VertexId>& path = paths.back();
+         SpurRound round;
+         round.graph = &graph;
+         round.tree = &tree;
+         round.end = end;
+         round.accepted = &paths;
+         round.path = &path;
+         round.first = deviations.back();
+         round.next.store(round.first);
+         size_t numSpurs = (path.size() > round.first + 1) ? path.size() - 1 - round.first : 0;
+         round.spurPaths.resize(numSpurs);
+         round.spurWeights.assign(numSpurs, -1);
+
+         // Spur indices are claimed one at a time; the first worker runs on this thread
+         size_t threadCount = (numThreads < (int)numSpurs) ? numThreads : numSpurs;
+         vector<thread> workers;
+         for (size_t t = 1; t < threadCount; t++) {
+             workers.push_back(thread(spurWorker, ref(round), ref(extraWorkspaces[t - 1])));
+         }
+         spurWorker(round, spurSpace);
+         for (size_t t = 0; t < workers.size(); t++) {
+             workers[t].join();
+         }
+
+         // Join each spur path to its root, whose weight grows one arc at a time along the path
+         long long rootWeight = 0;
+         for (size_t i = 0; i < round.first; i++) {
+             rootWeight += graph.getEdgeWeight(path[i], path[i + 1]);
+         }
+         for (size_t s = 0; s < numSpurs; s++) {
+             size_t i = round.first + s;
+             if (round.spurWeights[s] >= 0) {
+                 Candidate candidate;
+                 candidate.weight = rootWeight + round.spurWeights[s];
+                 candidate.vertices.assign(path.begin(), path.begin() + i);
+                 candidate.vertices.insert(candidate.vertices.end(), round.spurPaths[s].begin(), round.spurPaths[s].end());
+                 candidate.deviation = i;
+                 candidates.insert(candidate);
+             }
+             rootWeight += graph.getEdgeWeight(path[i], path[i + 1]);
+         }
+
+         // Accept the lightest candidate
+         if (candidates.empty()) {
+             break;
+         }
+         set<Candidate>::iterator best = candidates.begin();
+         paths.push_back(best->vertices);
+         weights.push_back(best->weight);
+         deviations.push_back(best->deviation);
+         candidates.erase(best);
+     }
+     return true;
+ }
@@ -0,0 +1,49 @@
+/* File: kshortestpaths.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the KShortestPaths class, which finds the k shortest loopless paths
+ *          between two vertices with Yen's algorithm. One full search from the end gives the exact
+ *          distance to the end from every vertex; each spur search is then an A* search guided by
+ *          those distances, so it runs almost straight to the end. Spur searches reuse generation-
+ *          stamped workspaces, root path vertices are blocked by settling them before the search
+ *          starts, and a path is only spurred from where it left its parent (Lawler's refinement),
+ *          since the spurs of the shared prefix were already searched for the parent.
+ *
+ */
+
+ #ifndef KSHORTESTPATHS_H
+ #define KSHORTESTPATHS_H
+ #include <iostream>
+ #include <vector>
+ #include "compactgraph.h"
+ #include "searchworkspace.h"
+
+ using namespace std;
+
+ class KShortestPaths {
+     public:
+         // Constructor; reverse is g with its arcs reversed (g itself if no edge is one-way). The
+         // distances to the end are kept in treeWorkspace and the spur searches of this thread run in
+         // spurWorkspace. Each round's spur searches are spread over numThreads threads (0 uses one per
+         // hardware core); the extra threads get workspaces of their own
+         KShortestPaths(const CompactGraph& g, const CompactGraph& reverse, SearchWorkspace& treeWorkspace,
+                        SearchWorkspace& spurWorkspace, int numThreads);
+
+         // Find up to k loopless paths from start to end, shortest first: paths[i] lists the vertices of
+         // the i-th path and weights[i] its total weight, taking the lightest of any parallel arcs.
+         // Fewer come back when no more paths exist.
+         // Fails if the graph has a negative weight
+         bool find(VertexId start, VertexId end, int k, vector<vector<VertexId> >& paths, vector<long long>& weights);
+
+     private:
+         const CompactGraph& graph;
+         const CompactGraph& backward;
+         SearchWorkspace& tree;
+         SearchWorkspace& spurSpace;
+         int numThreads;
+
+         // Compute the distance to end from every vertex into the tree workspace
+         void computeTree(VertexId end);
+ };
+
+ #endif // KSHORTESTPATHS_H
@@ -0,0 +1,439 @@
+/* File: landmarks.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the Landmarks class.
+ *
+ */
+
+ #include "landmarks.h"
+ #include "daryheap.h"
+ #include <fstream>
+ #include <algorithm>
+ #include <thread>
+ #include <atomic>
+ #include <functional>
+ #include <random>
+ #include <cstring>
+
+ // Helper to compute shortest distances from one source to every vertex (INT_MAX if unreachable);
+ // optionally records the shortest path tree and the order in which vertices were settled
+ static void shortestDistances(const CompactGraph& g, VertexId source, vector<int>& distances,
+                               vector<VertexId>* predecessors, vector<VertexId>* order) {
+     int n = g.getNumVertices();
+     distances.assign(n, INT_MAX);
+     if (predecessors) {
+         predecessors->assign(n, INVALID_VERTEX);
+     }
+     if (order) {
+         order->clear();
+     }
+
+     DaryHeap<4> heap(n);
+     distances[source] = 0;
+     heap.insert(source, 0);
+     while (!heap.isEmpty()) {
+         VertexId current = heap.extractMin();
+         if (order) {
+             order->push_back(current);
+         }
+         for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+             VertexId neighbor = g.edgeTarget(e);
+             int newDistance = distances[current] + g.edgeWeight(e);
+             if (newDistance < distances[neighbor]) {
+                 distances[neighbor] = newDistance;
+                 if (predecessors) {
+                     (*predecessors)[neighbor] = current;
+                 }
+                 if (heap.contains(neighbor)) {
+                     heap.decreaseKey(neighbor, newDistance);
+                 } else {
+                     heap.insert(neighbor, newDistance);
+                 }
+             }
+         }
+     }
+ }
+
+ // Helper to compute hop counts from one source with BFS (INT_MAX if unreachable)
+ static void hopDistances(const CompactGraph& g, VertexId source, vector<int>& hops) {
+     hops.assign(g.getNumVertices(), INT_MAX);
+     vector<VertexId> queue(1, source);
+     hops[source] = 0;
+     for (size_t head = 0; head < queue.size(); head++) {
+         VertexId current = queue[head];
+         for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+             VertexId neighbor = g.edgeTarget(e);
+             if (hops[neighbor] == INT_MAX) {
+                 hops[neighbor] = hops[current] + 1;
+                 queue.push_back(neighbor);
+             }
+         }
+     }
+ }
+
+ // Worker that computes distance tables for landmarks handed out by a shared counter
+ static void computeTableWorker(const CompactGraph& g, const vector<VertexId>& landmarks,
+                                vector<vector<int> >& tables, atomic<int>& next) {
+     int i;
+     while ((i = next.fetch_add(1)) < (int)landmarks.size()) {
+         if (tables[i].empty()) {
+             shortestDistances(g, landmarks[i], tables[i], nullptr, nullptr);
+         }
+     }
+ }
+
+ // Constructor
+ Landmarks::Landmarks() : numVertices(0), metric(METRIC_LENGTH), graphSignature(0), distances(nullptr) {}
+
+ // Pick k landmarks and compute their distance tables for the metric g reads
+ void Landmarks::build(const CompactGraph& g, int k, LandmarkSelection selection) {
+     clear();
+     numVertices = g.getNumVertices();
+     metric = g.getMetric();
+     graphSignature = signatureOf(g);
+
+     // There cannot be more landmarks than vertices
+     int numLive = 0;
+     for (int v = 0; v < numVertices; v++) {
+         if (g.isLive(v)) {
+             numLive++;
+         }
+     }
+     if (k > numLive) {
+         k = numLive;
+     }
+     if (k <= 0) {
+         return;
+     }
+
+     vector<vector<int> > tables;
+     if (selection == LANDMARKS_AVOID) {
+         selectAvoid(g, k, tables);
+     } else {
+         selectFarthest(g, k);
+         tables.resize(landmarks.size());
+         computeTables(g, tables);
+     }
+
+     // Interleave the tables so the bounds for one vertex share a cache line
+     int numLandmarks = landmarks.size();
+     shared_ptr<vector<int> > interleaved = make_shared<vector<int> >((size_t)numVertices * numLandmarks);
+     for (int i = 0; i < numLandmarks; i++) {
+         for (int v = 0; v < numVertices; v++) {
+             (*interleaved)[(size_t)v * numLandmarks + i] = tables[i][v];
+         }
+     }
+     table = interleaved;
+     distances = table->data();
+ }
+
+ // Compute the distance tables of all landmarks, one thread per landmark at a time
+ void Landmarks::computeTables(const CompactGraph& g, vector<vector<int> >& tables) {
+     int numThreads = thread::hardware_concurrency();
+     if (numThreads < 1) {
+         numThreads = 1;
+     }
+     if (numThreads > (int)landmarks.size()) {
+         numThreads = landmarks.size();
+     }
+
+     // Each landmark's search is independent; the calling thread works too
+     atomic<int> next(0);
+     vector<thread> workers;
+     for (int t = 1; t < numThreads; t++) {
+         workers.push_back(thread(computeTableWorker, cref(g), cref(landmarks), ref(tables), ref(next)));
+     }
+     computeTableWorker(g, landmarks, tables, next);
+     for (size_t t = 0; t < workers.size(); t++) {
+         workers[t].join();
+     }
+ }
+
+ // Farthest selection: each new landmark is the vertex with the most hops to the nearest chosen
+ // one; unreachable vertices count as farthest, so every component gets covered in turn
+ void Landmarks::selectFarthest(const CompactGraph& g, int k) {
+     vector<int> nearestHops(numVertices, INT_MAX);
+     vector<int> hops;
+
+     // Start from the vertex farthest from an arbitrary one, which lies on the graph's rim
+     VertexId first = 0;
+     while (!g.isLive(first)) {
+         first++;
+     }
+     hopDistances(g, first, hops);
+     VertexId candidate = first;
+     for (int v = 0; v < numVertices; v++) {
+         if (hops[v] != INT_MAX && hops[v] > hops[candidate]) {
+             candidate = v;
+         }
+     }
+
+     while ((int)landmarks.size() < k) {
+         landmarks.push_back(candidate);
+         hopDistances(g, candidate, hops);
+
+         candidate = INVALID_VERTEX;
+         for (int v = 0; v < numVertices; v++) {
+             if (hops[v] < nearestHops[v]) {
+                 nearestHops[v] = hops[v];
+             }
+             if (g.isLive(v) && nearestHops[v] > 0 &&
+                 (candidate == INVALID_VERTEX || nearestHops[v] > nearestHops[candidate])) {
+                 candidate = v;
+             }
+         }
+         if (candidate == INVALID_VERTEX) {
+             break;
+         }
+     }
+ }
+
+ // Avoid selection: grow a shortest path tree from a random root, weigh each vertex by how much
+ // the current bounds underestimate its distance, and descend into the heaviest subtree that has
+ // no landmark yet; the leaf reached becomes the next landmark
+ void Landmarks::selectAvoid(const CompactGraph& g, int k, vector<vector<int> >& tables) {
+     mt19937 random(316);
+     vector<VertexId> liveVertices;
+     for (int v = 0; v < numVertices; v++) {
+         if (g.isLive(v)) {
+             liveVertices.push_back(v);
+         }
+     }
+
+     vector<int> rootDistances;
+     vector<VertexId> predecessors;
+     vector<VertexId> order;
+     vector<long long> size(numVertices);
+     vector<bool> isLandmark(numVertices, false);
+     vector<bool> coveredBelow(numVertices);
+     vector<EdgeId> childOffsets(numVertices + 1);
+     vector<VertexId> children;
+
+     while ((int)landmarks.size() < k) {
+         VertexId root = liveVertices[random() % liveVertices.size()];
+         shortestDistances(g, root, rootDistances, &predecessors, &order);
+
+         // Weight every reached vertex by the gap between its distance and the current bound
+         for (size_t j = 0; j < order.size(); j++) {
+             VertexId v = order[j];
+             int bound = 0;
+             for (size_t i = 0; i < tables.size(); i++) {
+                 if (tables[i][v] != INT_MAX && tables[i][root] != INT_MAX) {
+                     int difference = tables[i][v] - tables[i][root];
+                     if (difference < 0) {
+                         difference = -difference;
+                     }
+                     if (difference > bound) {
+                         bound = difference;
+                     }
+                 }
+             }
+             size[v] = rootDistances[v] - bound;
+             coveredBelow[v] = isLandmark[v];
+         }
+
+         // Sum the weights bottom-up; a subtree that already holds a landmark counts as zero
+         for (size_t j = order.size(); j-- > 1; ) {
+             VertexId v = order[j];
+             VertexId parent = predecessors[v];
+             if (coveredBelow[v]) {
+                 size[v] = 0;
+                 coveredBelow[parent] = true;
+             } else {
+                 size[parent] += size[v];
+             }
+         }
+
+         // Gather the children of every vertex of the tree
+         fill(childOffsets.begin(), childOffsets.end(), 0);
+         for (size_t j = 1; j < order.size(); j++) {
+             childOffsets[predecessors[order[j]] + 1]++;
+         }
+         for (int v = 0; v < numVertices; v++) {
+             childOffsets[v + 1] += childOffsets[v];
+         }
+         children.assign(order.size(), INVALID_VERTEX);
+         vector<EdgeId> fillPosition(childOffsets.begin(), childOffsets.end() - 1);
+         for (size_t j = 1; j < order.size(); j++) {
+             VertexId parent = predecessors[order[j]];
+             children[fillPosition[parent]++] = order[j];
+         }
+
+         // Descend from the root through the heaviest uncovered child until reaching a leaf
+         VertexId current = root;
+         while (true) {
+             VertexId heaviest = INVALID_VERTEX;
+             for (EdgeId c = childOffsets[current]; c < childOffsets[current + 1]; c++) {
+                 VertexId child = children[c];
+                 if (!coveredBelow[child] && (heaviest == INVALID_VERTEX || size[child] > size[heaviest])) {
+                     heaviest = child;
+                 }
+             }
+             if (heaviest == INVALID_VERTEX) {
+                 break;
+             }
+             current = heaviest;
+         }
+
+         // If the whole tree is already covered, fall back to the farthest vertex without a landmark
+         if (isLandmark[current]) {
+             current = INVALID_VERTEX;
+             for (size_t j = 0; j < order.size(); j++) {
+                 if (!isLandmark[order[j]]) {
+                     current = order[j];
+                 }
+             }
+             for (size_t j = 0; current == INVALID_VERTEX && j < liveVertices.size(); j++) {
+                 if (!isLandmark[liveVertices[j]]) {
+                     current = liveVertices[j];
+                 }
+             }
+         }
+
+         landmarks.push_back(current);
+         isLandmark[current] = true;
+         tables.push_back(vector<int>());
+         shortestDistances(g, current, tables.back(), nullptr, nullptr);
+     }
+ }
+
+ // Write the landmarks and tables to a binary file
+ bool Landmarks::save(const string& filename) const {
+     ofstream file(filename, ios::binary);
+     if (!file.is_open()) {
+         cerr << "Error: Could not open file " << filename << endl;
+         return false;
+     }
+
+     // Header: magic, vertex count, landmark count, graph fingerprint
+     unsigned int count = numVertices;
+     unsigned int numLandmarks = landmarks.size();
+     file.write("ALT1", 4);
+     file.write((const char*)&count, sizeof(count));
+     file.write((const char*)&numLandmarks, sizeof(numLandmarks));
+     file.write((const char*)&graphSignature, sizeof(graphSignature));
+     file.write((const char*)landmarks.data(), landmarks.size() * sizeof(VertexId));
+     file.write((const char*)distances, (size_t)count * numLandmarks * sizeof(int));
+
+     if (!file) {
+         cerr << "Error: Could not write landmarks to " << filename << endl;
+         return false;
+     }
+     return true;
+ }
+
+ // Read landmarks from a file; fails if the file was built for a different graph
+ bool Landmarks::load(const string& filename, const CompactGraph& g) {
+     ifstream file(filename, ios::binary);
+     if (!file.is_open()) {
+         return false;
+     }
+
+     char magic[4];
+     unsigned int count = 0;
+     unsigned int numLandmarks = 0;
+     unsigned long long signature = 0;
+     file.read(magic, 4);
+     file.read((char*)&count, sizeof(count));
+     file.read((char*)&numLandmarks, sizeof(numLandmarks));
+     file.read((char*)&signature, sizeof(signature));
+     if (!file || memcmp(magic, "ALT1", 4) != 0 || (int)count != g.getNumVertices() ||
+         signature != signatureOf(g) || numLandmarks > count) {
+         return false;
+     }
+
+     vector<VertexId> newLandmarks(numLandmarks);
+     shared_ptr<vector<int> > newDistances = make_shared<vector<int> >((size_t)count * numLandmarks);
+     file.read((char*)newLandmarks.data(), newLandmarks.size() * sizeof(VertexId));
+     file.read((char*)newDistances->data(), newDistances->size() * sizeof(int));
+     if (!file) {
+         return false;
+     }
+
+     numVertices = count;
+     metric = g.getMetric();
+     graphSignature = signature;
+     landmarks.swap(newLandmarks);
+     table = newDistances;
+     distances = table->data();
+     return true;
+ }
+
+ // Add the landmarks and tables to a snapshot
+ void Landmarks::writeSnapshot(SnapshotWriter& writer) const {
+     writer.addSection(SECTION_LANDMARKS, landmarks.data(), landmarks.size() * sizeof(VertexId));
+     writer.addSection(SECTION_LANDMARK_DISTANCES, distances, table->size() * sizeof(int));
+     *(uint32_t*)writer.allocateSection(SECTION_LANDMARK_METRIC, sizeof(uint32_t)) = metric;
+ }
+
+ // Copy landmarks out of a snapshot of g; false if it has none
+ bool Landmarks::loadSnapshot(const Snapshot& snapshot, const CompactGraph& g) {
+     size_t landmarksSize, distancesSize, metricSize;
+     const VertexId* newLandmarks = (const VertexId*)snapshot.getSection(SECTION_LANDMARKS, landmarksSize);
+     const int* newDistances = (const int*)snapshot.getSection(SECTION_LANDMARK_DISTANCES, distancesSize);
+     const uint32_t* storedMetric = (const uint32_t*)snapshot.getSection(SECTION_LANDMARK_METRIC, metricSize);
+     size_t k = landmarksSize / sizeof(VertexId);
+     if (!newLandmarks || !newDistances || k == 0 || distancesSize != (size_t)g.getNumVertices() * k * sizeof(int)) {
+         return false;
+     }
+
+     // Snapshots from before metrics hold length tables
+     Metric newMetric = METRIC_LENGTH;
+     if (storedMetric) {
+         if (metricSize != sizeof(uint32_t) || *storedMetric >= (uint32_t)NUM_METRICS) {
+             return false;
+         }
+         newMetric = (Metric)*storedMetric;
+     }
+
+     numVertices = g.getNumVertices();
+     metric = newMetric;
+     graphSignature = signatureOf(CompactGraph(g, metric, false));
+     landmarks.assign(newLandmarks, newLandmarks + k);
+     table = make_shared<vector<int> >(newDistances, newDistances + (size_t)numVertices * k);
+     distances = table->data();
+     return true;
+ }
+
+ // Drop all landmarks
+ void Landmarks::clear() {
+     numVertices = 0;
+     metric = METRIC_LENGTH;
+     graphSignature = 0;
+     landmarks.clear();
+     table.reset();
+     distances = nullptr;
+ }
+
+ // Check if there are no landmarks
+ bool Landmarks::isEmpty() const {
+     return landmarks.empty();
+ }
+
+ // Get the metric the distance tables hold
+ Metric Landmarks::getMetric() const {
+     return metric;
+ }
+
+ // Get the number of landmarks and a landmark's vertex
+ int Landmarks::getNumLandmarks() const {
+     return landmarks.size();
+ }
+
+ VertexId Landmarks::getLandmark(int i) const {
+     return landmarks[i];
+ }
+
+ // Helper to fingerprint a graph so stale files are rejected (FNV-1a over the CSR arrays)
+ unsigned long long Landmarks::signatureOf(const CompactGraph& g) {
+     unsigned long long hash = 1469598103934665603ULL;
+     int n = g.getNumVertices();
+     for (int v = 0; v < n; v++) {
+         hash = (hash ^ (g.isLive(v) ? g.edgeEnd(v) - g.edgeBegin(v) + 1 : 0)) * 1099511628211ULL;
+         for (EdgeId e = g.edgeBegin(v); e < g.edgeEnd(v); e++) {
+             hash = (hash ^ g.edgeTarget(e)) * 1099511628211ULL;
+             hash = (hash ^ (unsigned int)g.edgeWeight(e)) * 1099511628211ULL;
+         }
+     }
+     return hash;
+ }
@@ -0,0 +1,125 @@
+/* File: landmarks.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the Landmarks class, which picks a set of landmark vertices,
+ *          stores the shortest distance from every landmark to every vertex, and turns those
+ *          tables into triangle-inequality lower bounds for A* (the ALT technique). This gives
+ *          goal-directed search on graphs that have no coordinates, at a cost of k x |V| ints.
+ *
+ */
+
+ #ifndef LANDMARKS_H
+ #define LANDMARKS_H
+ #include <iostream>
+ #include <vector>
+ #include <string>
+ #include <climits>
+ #include <memory>
+ #include "compactgraph.h"
+ #include "snapshot.h"
+
+ using namespace std;
+
+ // Strategies for picking landmarks
+ enum LandmarkSelection {
+     LANDMARKS_FARTHEST, // Repeatedly take the vertex farthest (in hops) from the chosen ones
+     LANDMARKS_AVOID     // Goldberg-Werneck "avoid": grow landmarks into regions the bounds cover badly
+ };
+
+ // Number of landmarks used when none is requested explicitly
+ const int DEFAULT_NUM_LANDMARKS = 8;
+
+ class Landmarks {
+     public:
+         // Constructor
+         Landmarks();
+
+         // Pick k landmarks and compute their distance tables for the metric g reads
+         void build(const CompactGraph& g, int k, LandmarkSelection selection);
+
+         // Write the landmarks and tables to a binary file
+         bool save(const string& filename) const;
+
+         // Read landmarks from a file; fails if the file was built for a different graph
+         bool load(const string& filename, const CompactGraph& g);
+
+         // Add the landmarks and tables to a snapshot
+         void writeSnapshot(SnapshotWriter& writer) const;
+
+         // Copy landmarks out of a snapshot of g; false if it has none
+         bool loadSnapshot(const Snapshot& snapshot, const CompactGraph& g);
+
+         // Drop all landmarks
+         void clear();
+
+         // Check if there are no landmarks
+         bool isEmpty() const;
+
+         // Get the metric the distance tables hold
+         Metric getMetric() const;
+
+         // Get the number of landmarks and a landmark's vertex
+         int getNumLandmarks() const;
+         VertexId getLandmark(int i) const;
+
+         // Lower bound on the distance between two vertices via the triangle inequality
+         int lowerBound(VertexId v, VertexId target) const;
+
+     private:
+         int numVertices;
+         Metric metric;
+         unsigned long long graphSignature; // Fingerprint of the graph the tables belong to
+         vector<VertexId> landmarks;
+         shared_ptr<const vector<int> > table; // Holds the distances; copies share it, as it is only ever replaced whole
+         const int* distances; // distances[v * k + i] = d(landmark i, v); the k bounds of a vertex are adjacent
+
+         // Helper to fingerprint a graph so stale files are rejected
+         static unsigned long long signatureOf(const CompactGraph& g);
+
+         // Landmark selection strategies; avoid fills in the distance tables as it goes
+         void selectFarthest(const CompactGraph& g, int k);
+         void selectAvoid(const CompactGraph& g, int k, vector<vector<int> >& tables);
+
+         // Compute the distance tables of all landmarks, one thread per landmark at a time
+         void computeTables(const CompactGraph& g, vector<vector<int> >& tables);
+ };
+
+ // Lower bound on the distance between two vertices via the triangle inequality:
+ // |d(L,t) - d(L,v)| <= d(v,t) for every landmark L of an undirected graph
+ inline int Landmarks::lowerBound(VertexId v, VertexId target) const {
+     int k = landmarks.size();
+     if (k == 0) {
+         return 0;
+     }
+
+     const int* fromV = &distances[(size_t)v * k];
+     const int* fromTarget = &distances[(size_t)target * k];
+     int best = 0;
+     for (int i = 0; i < k; i++) {
+         // A landmark that cannot reach one of the two vertices gives no bound
+         if (fromV[i] == INT_MAX || fromTarget[i] == INT_MAX) {
+             continue;
+         }
+         int difference = (fromV[i] > fromTarget[i]) ? fromV[i] - fromTarget[i] : fromTarget[i] - fromV[i];
+         if (difference > best) {
+             best = difference;
+         }
+     }
+     return best;
+ }
+
+ // A* heuristic backed by landmark distance tables
+ class LandmarkHeuristic {
+     public:
+         LandmarkHeuristic(const Landmarks& l, VertexId t) : landmarks(l), target(t) {}
+
+         int operator()(VertexId v) const {
+             return landmarks.lowerBound(v, target);
+         }
+
+     private:
+         const Landmarks& landmarks;
+         VertexId target;
+ };
+
+ #endif // LANDMARKS_H
@@ -0,0 +1,70 @@
+/* File: mappedfile.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the MappedFile class.
+ *
+ */
+
+ #include "mappedfile.h"
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+
+ // Constructor
+ MappedFile::MappedFile() : data(nullptr), size(0) {}
+
+ // Destructor
+ MappedFile::~MappedFile() {
+     close();
+ }
+
+ // Map a file; an empty file maps to no data
+ bool MappedFile::open(const string& filename) {
+     close();
+
+     int fd = ::open(filename.c_str(), O_RDONLY);
+     if (fd < 0) {
+         cerr << "Error: Could not open file " << filename << endl;
+         return false;
+     }
+     struct stat info;
+     if (fstat(fd, &info) != 0) {
+         cerr << "Error: Could not open file " << filename << endl;
+         ::close(fd);
+         return false;
+     }
+     if (info.st_size == 0) {
+         ::close(fd);
+         return true;
+     }
+
+     // A shared read-only mapping lets every process that opens the file use the same pages
+     void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+     ::close(fd);
+     if (mapping == MAP_FAILED) {
+         cerr << "Error: Could not map file " << filename << endl;
+         return false;
+     }
+     data = (const char*)mapping;
+     size = info.st_size;
+     return true;
+ }
+
+ // Unmap the file
+ void MappedFile::close() {
+     if (data) {
+         munmap((void*)data, size);
+     }
+     data = nullptr;
+     size = 0;
+ }
+
+ // Get the mapped bytes and their count
+ const char* MappedFile::getData() const {
+     return data;
+ }
+
+ size_t MappedFile::getSize() const {
+     return size;
+ }
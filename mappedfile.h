@@ -0,0 +1,41 @@
+/* File: mappedfile.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the MappedFile class, a whole file mapped read-only into memory.
+ *          The mapping is shared, so processes reading the same file use the same pages.
+ *
+ */
+
+ #ifndef MAPPEDFILE_H
+ #define MAPPEDFILE_H
+ #include <iostream>
+ #include <string>
+
+ using namespace std;
+
+ class MappedFile {
+     public:
+         // Constructor and destructor (the destructor unmaps the file)
+         MappedFile();
+         ~MappedFile();
+
+         // Map a file; an empty file maps to no data
+         bool open(const string& filename);
+
+         // Unmap the file
+         void close();
+
+         // Get the mapped bytes and their count
+         const char* getData() const;
+         size_t getSize() const;
+
+     private:
+         // The mapping is owned, so copies are not allowed
+         MappedFile(const MappedFile& other);
+         MappedFile& operator=(const MappedFile& other);
+
+         const char* data; // Start of the mapping, or nullptr
+         size_t size;      // Length of the mapping
+ };
+
+ #endif // MAPPEDFILE_H
@@ -6,13 +6,146 @@
  */
 
  #include "navigator.h"
+ #include "fastloader.h"
  #include <algorithm>
  #include <limits>
+ #include <climits>
+ #include <thread>
+ #include <atomic>
+ #include <functional>
+
+ // Query lines read and answered together before their results are written
+ const size_t BATCH_BLOCK_SIZE = 1 << 16;
+
+ // One batch query line and its answer
+ struct BatchQuery {
+     string start;
+     string end;
+     string algorithmName;
+     Algorithm algorithm;
+     Metric metric;
+     string error;        // Set instead of a path when the line cannot be answered
+     bool cached;         // Answered from the route cache before the block went to the workers
+     size_t sameAs;       // Earlier query of the block it repeats, or its own index if it is searched
+     unsigned long long version; // Number of the version the answer was searched on
+     vector<string> path;
+     long long weight;
+ };
+
+ // Helper to strip spaces, tabs and carriage returns around a field
+ static string trimField(const string& text) {
+     size_t start = text.find_first_not_of(" \t\r\n");
+     if (start == string::npos) {
+         return "";
+     }
+     size_t end = text.find_last_not_of(" \t\r\n");
+     return text.substr(start, end - start + 1);
+ }
+
+ // Helper to map a command name to its algorithm; false if it is not one
+ static bool parseAlgorithm(const string& name, Algorithm& algorithm) {
+     if (name == "bfs") {
+         algorithm = ALGORITHM_BFS;
+     } else if (name == "dijkstra") {
+         algorithm = ALGORITHM_DIJKSTRA;
+     } else if (name == "bibfs") {
+         algorithm = ALGORITHM_BIDIRECTIONAL_BFS;
+     } else if (name == "bidijkstra") {
+         algorithm = ALGORITHM_BIDIRECTIONAL_DIJKSTRA;
+     } else if (name == "astar") {
+         algorithm = ALGORITHM_ASTAR;
+     } else if (name == "alt") {
+         algorithm = ALGORITHM_ALT;
+     } else if (name == "ch") {
+         algorithm = ALGORITHM_CH;
+     } else {
+         return false;
+     }
+     return true;
+ }
+
+ // Helper to map a metric name to its metric; false if it is not one
+ static bool parseMetric(const string& name, Metric& metric) {
+     if (name == "length") {
+         metric = METRIC_LENGTH;
+     } else if (name == "time") {
+         metric = METRIC_TIME;
+     } else {
+         return false;
+     }
+     return true;
+ }
+
+ // Helper to key a remembered route by its endpoints and metric
+ static string routeKey(const vector<string>& path, Metric metric) {
+     string key = path.front();
+     key += '\0';
+     key += path.back();
+     key += '\0';
+     key += to_string((int)metric);
+     return key;
+ }
+
+ // Helper to key a batch query by what its answer depends on
+ static string queryKey(const BatchQuery& query) {
+     string key = query.start;
+     key += '\0';
+     key += query.end;
+     key += '\0';
+     key += to_string((int)query.algorithm);
+     key += '\0';
+     key += to_string((int)query.metric);
+     return key;
+ }
+
+ // Worker that answers queries until none are left; each worker owns its finder's search state and
+ // adds the statistics of the searches it ran to its own totals. Every query is answered against the
+ // version that was published when it started, which the worker keeps pinned through its reader slot
+ // until the answer is in.
+ // Workers take no locks: the route cache is read before the block and filled after it
+ static void batchWorker(PathFinder* finder, int slot, vector<BatchQuery>& queries, atomic<size_t>& next,
+                         atomic<size_t>& started, VersionManager& versions, SearchStats& totals) {
+     while (true) {
+         size_t i = next.fetch_add(1);
+         if (i >= queries.size()) {
+             break;
+         }
+
+         // Queries answered before the block or by a repeat of them read no version
+         BatchQuery& query = queries[i];
+         if (!query.error.empty() || query.cached || query.sameAs != i) {
+             started.fetch_add(1);
+             continue;
+         }
+
+         // Pin before counting the query as started, so a writer waiting on the count publishes after it
+         const GraphVersion* version = versions.pin(slot);
+         started.fetch_add(1);
+         query.version = version->number;
+         finder->attach(version);
+         query.path = finder->findPath(query.start, query.end, query.algorithm, query.metric);
+         if (StatsPolicy::ENABLED) {
+             totals.add(finder->getLastStats());
+         }
+         CompactGraph compact(version->compact, query.metric, false);
+         query.weight = 0;
+         for (size_t j = 0; j + 1 < query.path.size(); j++) {
+             query.weight += compact.getEdgeWeight(compact.getVertexId(query.path[j]), compact.getVertexId(query.path[j + 1]));
+         }
+         versions.unpin(slot);
+     }
+ }
  
  // Constructor
- Navigator::Navigator() {
+ Navigator::Navigator()
+     : verbose(false), routeCache(ROUTE_CACHE_CAPACITY, ROUTE_CACHE_SHARDS), versions(DEFAULT_MAX_READERS) {
      pathFinder = new PathFinder(graph);
  }
+
+ // Print every edge as it is loaded
+ void Navigator::setVerbose(bool enabled) {
+     verbose = enabled;
+ }
  
  // Load data from files
  bool Navigator::loadData(const string& verticesFile, const string& edgesFile) {
@@ -27,72 +160,81 @@
          cerr << "Failed to load edges from " << edgesFile << endl;
          return false;
      }
+
+     // Freeze the loaded graph into the compact form used by the searches
+     pathFinder->rebuild();
+     dataFileName = edgesFile;
      
      cout << "Data loaded successfully: " << graph.getNumNodes() << " locations and " 
           << graph.getNumEdges() << " paths." << endl;
      return true;
  }
+
+ // Load a binary snapshot instead of the text files; the graph is mapped, not parsed
+ bool Navigator::loadSnapshot(const string& snapshotFile) {
+     if (!pathFinder->loadSnapshot(snapshotFile)) {
+         cerr << "Failed to load snapshot " << snapshotFile << endl;
+         return false;
+     }
+     dataFileName = snapshotFile;
+
+     // Routes found in the previous data do not carry over
+     routeCache.clear();
+
+     const CompactGraph& compact = pathFinder->getCompact();
+     int numLocations = 0;
+     for (int v = 0; v < compact.getNumVertices(); v++) {
+         if (compact.isLive(v)) {
+             numLocations++;
+         }
+     }
+     cout << "Snapshot loaded successfully: " << numLocations << " locations and "
+          << compact.getNumEdges() << " paths." << endl;
+     return true;
+ }
+
+ // Write the loaded data and any prepared landmarks and hierarchy to a binary snapshot
+ bool Navigator::saveSnapshot(const string& snapshotFile) {
+     if (!pathFinder->saveSnapshot(snapshotFile)) {
+         return false;
+     }
+     cout << "Snapshot written to " << snapshotFile << "." << endl;
+     return true;
+ }
  
+ // Renumber the loaded locations in bfs, rcm or hilbert order
+ bool Navigator::reorderVertices(const string& ordering) {
+     VertexOrdering parsed;
+     if (!VertexOrder::parse(ordering, parsed)) {
+         cerr << "Error: Unknown ordering '" << ordering << "' (use bfs, rcm or hilbert)" << endl;
+         return false;
+     }
+     if (!pathFinder->reorderVertices(parsed)) {
+         return false;
+     }
+
+     // Cached routes were found under the old numbering
+     routeCache.clear();
+     cout << "Locations renumbered in " << ordering << " order." << endl;
+     return true;
+ }
+
  // Helper method to load vertices
  bool Navigator::loadVertices(const string& filename) {
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Error: Could not open file " << filename << endl;
-        return false;
-    }
-    
-    string line;
-    while (getline(file, line)) {
-        // Skip empty lines
-        if (!line.empty()) {
-            // Clean the line to remove hidden characters
-            string cleanLine = normalizeLocationName(line);
-            // Add node to graph
-            graph.addNode(cleanLine);
-        }
-    }
-    
-    file.close();
-    return true;
-}
+     FastLoader loader(0);
+     return loader.loadVertices(filename, graph);
+ }
  
  // Helper method to load edges
  bool Navigator::loadEdges(const string& filename) {
-     ifstream file(filename);
-     if (!file.is_open()) {
-         cerr << "Error: Could not open file " << filename << endl;
-         return false;
-     }
-     
-     string line;
-     while (getline(file, line)) {
-         stringstream ss(line);
-         string from, to, weightStr;
-         
-         // Parse the CSV line
-         if (getline(ss, from, ',') && getline(ss, to, ',') && getline(ss, weightStr)) {
-             try {
-                 int weight = stoi(weightStr);
-                 // Add edge to graph
-                 graph.addEdge(from, to, weight);
-                 cout << "Loaded edge: " << from << " to " << to << " with weight " << weight << endl;
-             } catch (const exception& e) {
-                 cerr << "Error parsing weight '" << weightStr << "': " << e.what() << endl;
-                 return false;
-             }
-         } else {
-             cerr << "Error: Malformed edge line: " << line << endl;
-             return false;
-         }
-     }
-     
-     file.close();
-     return true;
+     FastLoader loader(0);
+     loader.setVerbose(verbose);
+     return loader.loadEdges(filename, graph);
  }
  
  // Show available locations
  void Navigator::showLocations() const {
-    vector<string> locations = graph.getAllNodeIds();
+    vector<string> locations = getLocationNames();
     
     // Sort locations alphabetically
     sort(locations.begin(), locations.end());
@@ -108,7 +250,7 @@
 }
  
  // Find route between locations
- void Navigator::findRoute(const string& start, const string& end, bool useDijkstra) {
+ void Navigator::findRoute(const string& start, const string& end, Algorithm algorithm) {
     // Clean both input locations and convert to lowercase
     string cleanStart = normalizeLocationName(start);
     string lowercaseStart = cleanStart;
@@ -122,7 +264,7 @@
     string actualStart = "";
     string actualEnd = "";
     
-    vector<string> locations = graph.getAllNodeIds();
+    vector<string> locations = getLocationNames();
     for (size_t i = 0; i < locations.size(); ++i) {
         // Clean the location to remove hidden characters
         string cleanLoc = normalizeLocationName(locations[i]);
@@ -151,20 +293,78 @@
         return;
     }
     
+    // Landmark bounds and the hierarchy both assume every edge can be driven either way
+    if ((algorithm == ALGORITHM_ALT || algorithm == ALGORITHM_CH) && pathFinder->getCompact().isDirected()) {
+        cerr << "Error: " << (algorithm == ALGORITHM_ALT ? "ALT" : "CH")
+             << " needs a map without one-way paths. Try dijkstra or astar." << endl;
+        return;
+    }
+    Metric metric = pathFinder->getMetric();
+
     // Find the path
-    vector<string> path;
-    if (useDijkstra) {
+    if (algorithm == ALGORITHM_DIJKSTRA) {
         cout << "\nFinding route using Dijkstra's algorithm..." << endl;
-        path = pathFinder->findPathDijkstra(actualStart, actualEnd);
+    } else if (algorithm == ALGORITHM_BIDIRECTIONAL_DIJKSTRA) {
+        cout << "\nFinding route using bidirectional Dijkstra's algorithm..." << endl;
+    } else if (algorithm == ALGORITHM_ASTAR) {
+        cout << "\nFinding route using A* search..." << endl;
+    } else if (algorithm == ALGORITHM_ALT) {
+        // Landmarks are prepared once per metric and then reused by every ALT query
+        if (pathFinder->getLandmarks().isEmpty() || pathFinder->getLandmarks().getMetric() != metric) {
+            prepareLandmarks(DEFAULT_NUM_LANDMARKS, LANDMARKS_FARTHEST);
+        }
+        cout << "\nFinding route using A* search with landmarks..." << endl;
+    } else if (algorithm == ALGORITHM_CH) {
+        // The graph is contracted once per metric and then every CH query reuses the hierarchy
+        if (pathFinder->getContractionHierarchy().isEmpty() || pathFinder->getContractionHierarchy().getMetric() != metric) {
+            prepareContractionHierarchy();
+        }
+        cout << "\nFinding route using the contraction hierarchy..." << endl;
+    } else if (algorithm == ALGORITHM_BIDIRECTIONAL_BFS) {
+        cout << "\nFinding route using bidirectional BFS algorithm..." << endl;
     } else {
         cout << "\nFinding route using BFS algorithm..." << endl;
-        path = pathFinder->findPathBFS(actualStart, actualEnd);
+    }
+    // Popular routes are answered from the cache until the graph changes
+    vector<string> path;
+    long long weight = 0;
+    if (routeCache.lookup(actualStart, actualEnd, algorithm, metric, graph.getVersion(), path, weight)) {
+        cout << "(Found in the route cache)" << endl;
+    } else {
+        path = pathFinder->findPath(actualStart, actualEnd, algorithm);
+        const CompactGraph& compact = pathFinder->getCompact();
+        for (size_t i = 0; i + 1 < path.size(); i++) {
+            weight += compact.getEdgeWeight(compact.getVertexId(path[i]), compact.getVertexId(path[i + 1]));
+        }
+        routeCache.insert(actualStart, actualEnd, algorithm, metric, graph.getVersion(), path, weight);
+    }
+
+    // Remember weighted routes so traffic updates can say which ones went stale
+    if (!path.empty() && PathFinder::isWeighted(algorithm)) {
+        rememberRoute(path, metric);
     }
     
     // Display the path
-    displayPath(path, useDijkstra);
+    displayPath(path, PathFinder::isWeighted(algorithm));
 }
  
+ // Helper method to remember a shown route, replacing the one with the same endpoints and metric
+ void Navigator::rememberRoute(const vector<string>& path, Metric metric) {
+     string key = routeKey(path, metric);
+     unordered_map<string, list<RememberedRoute>::iterator>::iterator found = recentIndex.find(key);
+     if (found != recentIndex.end()) {
+         recentRoutes.erase(found->second);
+         recentIndex.erase(found);
+     } else if (recentRoutes.size() >= ROUTE_CACHE_CAPACITY) {
+         const RememberedRoute& oldest = recentRoutes.back();
+         recentIndex.erase(routeKey(oldest.path, oldest.metric));
+         recentRoutes.pop_back();
+     }
+     RememberedRoute route = {path, metric};
+     recentRoutes.push_front(route);
+     recentIndex[key] = recentRoutes.begin();
+ }
+
  // Helper method to display a path
  void Navigator::displayPath(const vector<string>& path, bool showWeights) {
      if (path.empty()) {
@@ -181,8 +381,8 @@
          // Add weight if not the last node and we want to show weights
          if (i < path.size() - 1) {
              if (showWeights) {
-                 Node* node = graph.getNode(path[i]);
-                 int weight = node->getNeighborWeight(path[i+1]);
+                 const CompactGraph& compact = pathFinder->getCompact();
+                 int weight = compact.getEdgeWeight(compact.getVertexId(path[i]), compact.getVertexId(path[i+1]));
                  totalWeight += weight;
                  cout << " --(" << weight << ")--> ";
              } else {
@@ -193,7 +393,8 @@
      cout << endl;
      
      if (showWeights) {
-         cout << "Total journey distance: " << totalWeight << endl;
+         cout << (pathFinder->getMetric() == METRIC_TIME ? "Total journey time: " : "Total journey distance: ")
+              << totalWeight << endl;
      }
  }
  
@@ -212,7 +413,7 @@
     string actualStart = "";
     string actualEnd = "";
     
-    vector<string> locations = graph.getAllNodeIds();
+    vector<string> locations = getLocationNames();
     for (size_t i = 0; i < locations.size(); ++i) {
         // Clean the location to remove hidden characters
         string cleanLoc = normalizeLocationName(locations[i]);
@@ -245,6 +446,416 @@
     pathFinder->compareAlgorithms(actualStart, actualEnd);
  }
  
+ // Show the distances between comma-separated lists of sources and targets
+ void Navigator::showDistanceMatrix(const string& sources, const string& targets, const string& outputFile) {
+     // Split both lists and check every name before searching
+     vector<string> lists[2];
+     const string* inputs[2] = { &sources, &targets };
+     for (int side = 0; side < 2; side++) {
+         stringstream ss(*inputs[side]);
+         string name;
+         while (getline(ss, name, ',')) {
+             name = normalizeLocationName(name);
+             if (name.empty()) {
+                 continue;
+             }
+             string suggestion;
+             if (!locationExists(name, suggestion)) {
+                 cerr << "Error: Location '" << name << "' does not exist.";
+                 if (!suggestion.empty()) {
+                     cerr << " Did you mean '" << suggestion << "'?";
+                 }
+                 cerr << endl;
+                 return;
+             }
+             lists[side].push_back(name);
+         }
+     }
+     if (lists[0].empty() || lists[1].empty()) {
+         cerr << "Error: Enter at least one source and one target." << endl;
+         return;
+     }
+
+     vector<int> matrix = pathFinder->distanceMatrix(lists[0], lists[1], 0);
+     if (matrix.empty()) {
+         return;
+     }
+
+     // One line per source, one distance per target
+     cout << "\nDistances (" << lists[0].size() << " sources by " << lists[1].size() << " targets):" << endl;
+     for (size_t i = 0; i < lists[0].size(); i++) {
+         cout << lists[0][i] << ":";
+         for (size_t j = 0; j < lists[1].size(); j++) {
+             int distance = matrix[i * lists[1].size() + j];
+             cout << " " << lists[1][j] << "=";
+             if (distance < 0) {
+                 cout << "none";
+             } else {
+                 cout << distance;
+             }
+         }
+         cout << endl;
+     }
+
+     string fileName = normalizeLocationName(outputFile);
+     if (!fileName.empty() && PathFinder::saveDistanceMatrix(fileName, matrix, lists[0].size(), lists[1].size())) {
+         cout << "Matrix written to " << fileName << "." << endl;
+     }
+ }
+
+ // List every location reachable from start within maxDistance, nearest first
+ void Navigator::showReachable(const string& start, const string& maxDistance) {
+     string name = normalizeLocationName(start);
+     string suggestion;
+     if (!locationExists(name, suggestion)) {
+         cerr << "Error: Location '" << name << "' does not exist.";
+         if (!suggestion.empty()) {
+             cerr << " Did you mean '" << suggestion << "'?";
+         }
+         cerr << endl;
+         return;
+     }
+     int limit = INT_MAX;
+     string limitText = normalizeLocationName(maxDistance);
+     if (!limitText.empty()) {
+         try {
+             limit = stoi(limitText);
+         } catch (const exception& e) {
+             cerr << "Error parsing distance '" << maxDistance << "': " << e.what() << endl;
+             return;
+         }
+     }
+
+     // The whole shortest path tree comes from one parallel search
+     vector<int> distances;
+     vector<VertexId> predecessors;
+     if (!pathFinder->shortestPathTree(name, distances, predecessors, 0, 0)) {
+         return;
+     }
+     vector<pair<int, VertexId> > reached;
+     for (size_t v = 0; v < distances.size(); v++) {
+         if (distances[v] <= limit && distances[v] != INT_MAX) {
+             reached.push_back(make_pair(distances[v], VertexId(v)));
+         }
+     }
+     sort(reached.begin(), reached.end());
+
+     const CompactGraph& compact = pathFinder->getCompact();
+     cout << "\n" << reached.size() << " locations reachable from " << name;
+     if (limit != INT_MAX) {
+         cout << " within " << limit;
+     }
+     cout << ":" << endl;
+     for (size_t i = 0; i < reached.size(); i++) {
+         VertexId v = reached[i].second;
+         cout << compact.getName(v) << " (" << reached[i].first << ")";
+         if (predecessors[v] != INVALID_VERTEX) {
+             cout << " via " << compact.getName(predecessors[v]);
+         }
+         cout << endl;
+     }
+ }
+
+ // Show up to count alternative routes from start to end, shortest first
+ void Navigator::showAlternatives(const string& start, const string& end, const string& count) {
+     string names[2] = {normalizeLocationName(start), normalizeLocationName(end)};
+     for (int i = 0; i < 2; i++) {
+         string suggestion;
+         if (!locationExists(names[i], suggestion)) {
+             cerr << "Error: Location '" << names[i] << "' does not exist.";
+             if (!suggestion.empty()) {
+                 cerr << " Did you mean '" << suggestion << "'?";
+             }
+             cerr << endl;
+             return;
+         }
+     }
+     int k = 0;
+     try {
+         k = stoi(normalizeLocationName(count));
+     } catch (const exception& e) {
+         cerr << "Error parsing route count '" << count << "': " << e.what() << endl;
+         return;
+     }
+
+     // The spur searches of each round share the cores when parallel searching is on
+     int numThreads = pathFinder->isParallel() ? 0 : 1;
+     vector<vector<string> > routes = pathFinder->findKShortestPaths(names[0], names[1], k, numThreads);
+     if (routes.empty()) {
+         cout << "No path found!" << endl;
+         return;
+     }
+     for (size_t i = 0; i < routes.size(); i++) {
+         cout << "\nRoute " << i + 1 << ":" << endl;
+         displayPath(routes[i], true);
+     }
+ }
+
+ // Apply a batch of from,to,weight[,metric] edge updates separated by semicolons
+ void Navigator::applyTrafficUpdates(const string& updates) {
+     const CompactGraph& compact = pathFinder->getCompact();
+     vector<WeightUpdate> batch;
+     if (!parseTrafficUpdates(updates, batch)) {
+         return;
+     }
+
+     unsigned long long versionBefore = graph.getVersion();
+     vector<const RememberedRoute*> routes;
+     vector<list<RememberedRoute>::iterator> positions;
+     for (list<RememberedRoute>::iterator it = recentRoutes.begin(); it != recentRoutes.end(); ++it) {
+         routes.push_back(&*it);
+         positions.push_back(it);
+     }
+     vector<size_t> invalidated;
+     if (!pathFinder->updateEdgeWeights(batch, routes, invalidated)) {
+         return;
+     }
+     // A snapshot's weights change without the graph's version moving, so its cached routes go now
+     if (graph.getVersion() == versionBefore) {
+         routeCache.clear();
+     }
+     cout << "Updated " << batch.size() << (batch.size() == 1 ? " edge." : " edges.") << endl;
+     for (int i = 0; i < pathFinder->getNumTrackedSources(); i++) {
+         const DynamicSSSP& tree = pathFinder->getTrackedTree(i);
+         cout << "Repaired routes from " << compact.getName(tree.getSource()) << ": "
+              << tree.getChanged().size() << " locations changed distance." << endl;
+     }
+
+     // Stale routes are reported once and forgotten, most recently shown first
+     if (!invalidated.empty()) {
+         cout << invalidated.size() << " remembered routes may no longer be shortest:" << endl;
+     }
+     for (size_t i = 0; i < invalidated.size(); i++) {
+         list<RememberedRoute>::iterator stale = positions[invalidated[i]];
+         cout << "  " << stale->path.front() << " to " << stale->path.back() << endl;
+         recentIndex.erase(routeKey(stale->path, stale->metric));
+         recentRoutes.erase(stale);
+     }
+ }
+
+ // Helper to read from,to,weight[,metric] edge updates separated by semicolons; false, after reporting
+ // why, if one cannot be read or there are none
+ bool Navigator::parseTrafficUpdates(const string& updates, vector<WeightUpdate>& batch) {
+     const CompactGraph& compact = pathFinder->getCompact();
+     batch.clear();
+     stringstream ss(updates);
+     string item;
+     while (getline(ss, item, ';')) {
+         if (normalizeLocationName(item).empty()) {
+             continue;
+         }
+         stringstream fields(item);
+         string from, to, weightText, metricText;
+         getline(fields, from, ',');
+         getline(fields, to, ',');
+         getline(fields, weightText, ',');
+         getline(fields, metricText);
+         WeightUpdate update;
+         update.metric = pathFinder->getMetric();
+         metricText = normalizeLocationName(metricText);
+         transform(metricText.begin(), metricText.end(), metricText.begin(), ::tolower);
+         if (!metricText.empty() && !parseMetric(metricText, update.metric)) {
+             cerr << "Error: Unknown metric '" << metricText << "'. Use length or time." << endl;
+             return false;
+         }
+         update.from = compact.getVertexId(normalizeLocationName(from));
+         update.to = compact.getVertexId(normalizeLocationName(to));
+         if (update.from == INVALID_VERTEX || update.to == INVALID_VERTEX) {
+             cerr << "Error: Update '" << item << "' names a location that does not exist." << endl;
+             return false;
+         }
+         try {
+             update.weight = stoi(weightText);
+         } catch (const exception& e) {
+             cerr << "Error parsing weight '" << weightText << "': " << e.what() << endl;
+             return false;
+         }
+         batch.push_back(update);
+     }
+     if (batch.empty()) {
+         cerr << "Error: Enter at least one update." << endl;
+         return false;
+     }
+     return true;
+ }
+
+ // Close the named locations, removing them and their paths from the map in one batch
+ bool Navigator::closeLocations(const vector<string>& names) {
+     vector<string> normalized;
+     for (size_t i = 0; i < names.size(); i++) {
+         string name = normalizeLocationName(names[i]);
+         if (!name.empty()) {
+             normalized.push_back(name);
+         }
+     }
+     if (normalized.empty()) {
+         cerr << "Error: Enter at least one location." << endl;
+         return false;
+     }
+     int removed = pathFinder->removeLocations(normalized);
+     if (removed < 0) {
+         return false;
+     }
+     cout << "Closed " << removed << (removed == 1 ? " location" : " locations");
+     if ((size_t)removed < normalized.size()) {
+         cout << "; " << normalized.size() - removed << " were unknown or already closed";
+     }
+     cout << "." << endl;
+     return true;
+ }
+
+ // Keep a shortest path tree from start that traffic updates repair
+ void Navigator::trackLocation(const string& start) {
+     string name = normalizeLocationName(start);
+     string suggestion;
+     if (!locationExists(name, suggestion)) {
+         cerr << "Error: Location '" << name << "' does not exist.";
+         if (!suggestion.empty()) {
+             cerr << " Did you mean '" << suggestion << "'?";
+         }
+         cerr << endl;
+         return;
+     }
+     if (pathFinder->trackSource(name)) {
+         cout << "Routes from " << name << " will be repaired after traffic updates." << endl;
+     }
+ }
+
+ // Show how many routes the cache holds and how often it has been used
+ void Navigator::showCacheStats() {
+     unsigned long long hits = routeCache.getHits();
+     unsigned long long misses = routeCache.getMisses();
+     cout << "Route cache: " << routeCache.size() << " routes held, " << hits << " hits, " << misses
+          << " misses, " << routeCache.getEvictions() << " evictions";
+     if (hits + misses > 0) {
+         cout << " (" << (100.0 * hits / (hits + misses)) << "% hit rate)";
+     }
+     cout << "." << endl;
+ }
+
+ // List the locations grouped by the number of hops from start
+ void Navigator::showHops(const string& start) {
+     string name = normalizeLocationName(start);
+     string suggestion;
+     if (!locationExists(name, suggestion)) {
+         cerr << "Error: Location '" << name << "' does not exist.";
+         if (!suggestion.empty()) {
+             cerr << " Did you mean '" << suggestion << "'?";
+         }
+         cerr << endl;
+         return;
+     }
+
+     // One parallel BFS labels every location
+     vector<int> hops;
+     vector<VertexId> parents;
+     if (!pathFinder->hopDistances(name, hops, parents, 0)) {
+         return;
+     }
+     vector<vector<string> > levels;
+     const CompactGraph& compact = pathFinder->getCompact();
+     for (size_t v = 0; v < hops.size(); v++) {
+         if (hops[v] < 0) {
+             continue;
+         }
+         if (hops[v] >= (int)levels.size()) {
+             levels.resize(hops[v] + 1);
+         }
+         levels[hops[v]].push_back(string(compact.getName(VertexId(v))));
+     }
+
+     cout << endl;
+     for (size_t i = 0; i < levels.size(); i++) {
+         sort(levels[i].begin(), levels[i].end());
+         cout << i << (i == 1 ? " hop: " : " hops: ");
+         for (size_t j = 0; j < levels[i].size(); j++) {
+             cout << (j > 0 ? ", " : "") << levels[i][j];
+         }
+         cout << endl;
+     }
+ }
+
+ // Select the priority queue used by Dijkstra's algorithm (auto, heap, radix or bucket)
+ void Navigator::setQueueType(const string& type) {
+     string lowercaseType = normalizeLocationName(type);
+     transform(lowercaseType.begin(), lowercaseType.end(), lowercaseType.begin(), ::tolower);
+
+     if (lowercaseType == "auto") {
+         pathFinder->setQueueType(QUEUE_AUTO);
+     } else if (lowercaseType == "heap") {
+         pathFinder->setQueueType(QUEUE_DARY_HEAP);
+     } else if (lowercaseType == "radix") {
+         pathFinder->setQueueType(QUEUE_RADIX_HEAP);
+     } else if (lowercaseType == "bucket") {
+         pathFinder->setQueueType(QUEUE_BUCKET);
+     } else {
+         cerr << "Error: Unknown queue type '" << type << "'. Use auto, heap, radix or bucket." << endl;
+         return;
+     }
+
+     // Report which backend will actually run
+     QueueType resolved = pathFinder->resolveQueueType();
+     cout << "Dijkstra will use the ";
+     if (resolved == QUEUE_BUCKET) {
+         cout << "bucket queue";
+     } else if (resolved == QUEUE_RADIX_HEAP) {
+         cout << "radix heap";
+     } else {
+         cout << "4-ary heap";
+     }
+     cout << "." << endl;
+     if (lowercaseType == "bucket" && resolved == QUEUE_RADIX_HEAP) {
+         cout << "Note: The bucket queue needs weights of at most " << BUCKET_QUEUE_FORCED_MAX_WEIGHT
+              << ", so the radix heap runs until the map's weights are lower." << endl;
+     }
+ }
+ 
+ // Pick landmarks for ALT searches, reusing the landmark file next to the edges file when it matches
+ void Navigator::prepareLandmarks(int count, LandmarkSelection selection) {
+     pathFinder->prepareLandmarks(count, selection, landmarkCacheFile(pathFinder->getMetric()));
+
+     // Maps with one-way paths get no landmarks, which the path finder has already reported
+     const Landmarks& landmarks = pathFinder->getLandmarks();
+     if (landmarks.isEmpty()) {
+         return;
+     }
+     cout << "Using " << landmarks.getNumLandmarks() << " landmarks:";
+     for (int i = 0; i < landmarks.getNumLandmarks(); i++) {
+         cout << " " << pathFinder->getCompact().getName(landmarks.getLandmark(i));
+     }
+     cout << endl;
+ }
+
+ // Contract the graph for CH queries
+ void Navigator::prepareContractionHierarchy() {
+     cout << "Contracting the graph..." << endl;
+     pathFinder->prepareContractionHierarchy();
+     if (!pathFinder->getContractionHierarchy().isEmpty()) {
+         cout << "Added " << pathFinder->getContractionHierarchy().getNumShortcuts() << " shortcuts." << endl;
+     }
+ }
+
+ // Helper to get the landmark file kept next to the data for a metric; lengths keep the original name
+ string Navigator::landmarkCacheFile(Metric metric) const {
+     if (dataFileName.empty()) {
+         return "";
+     }
+     return dataFileName + (metric == METRIC_TIME ? ".time.landmarks" : ".landmarks");
+ }
+
+ // Select what routes minimize (length or time)
+ bool Navigator::setMetric(const string& name) {
+     string lowercaseName = normalizeLocationName(name);
+     transform(lowercaseName.begin(), lowercaseName.end(), lowercaseName.begin(), ::tolower);
+     Metric metric;
+     if (!parseMetric(lowercaseName, metric)) {
+         cerr << "Error: Unknown metric '" << name << "'. Use length or time." << endl;
+         return false;
+     }
+     pathFinder->setMetric(metric);
+     return true;
+ }
+ 
  // Run the navigator interface
  void Navigator::run() {
      string command;
@@ -267,7 +878,25 @@
              cout << "  locations     - Show all available locations" << endl;
              cout << "  bfs           - Find route using BFS algorithm" << endl;
              cout << "  dijkstra      - Find route using Dijkstra's algorithm" << endl;
+             cout << "  bibfs         - Find route using BFS from both ends" << endl;
+             cout << "  bidijkstra    - Find route using Dijkstra's algorithm from both ends" << endl;
+             cout << "  astar         - Find route using A* search (needs vertex coordinates to beat Dijkstra)" << endl;
+             cout << "  alt           - Find route using A* search with landmark distance bounds" << endl;
+             cout << "  landmarks     - Choose the number of landmarks and how they are selected" << endl;
+             cout << "  ch            - Find route using the contraction hierarchy (contracts the graph on first use)" << endl;
              cout << "  compare       - Compare both algorithms for a route" << endl;
+             cout << "  matrix        - Show the distances between lists of sources and targets" << endl;
+             cout << "  reachable     - List the locations within a distance of a start, nearest first" << endl;
+             cout << "  hops          - List the locations by the number of hops from a start" << endl;
+             cout << "  alternatives  - Show the k shortest routes between two locations" << endl;
+             cout << "  traffic       - Change the weights of existing paths and report the routes that went stale" << endl;
+             cout << "  track         - Keep the routes from a location up to date across traffic updates" << endl;
+             cout << "  close         - Remove locations and their paths from the map" << endl;
+             cout << "  cache         - Show how often routes were answered from the route cache" << endl;
+             cout << "  queue         - Choose Dijkstra's priority queue (auto, heap, radix, bucket)" << endl;
+             cout << "  metric        - Choose what routes minimize (length, time)" << endl;
+             cout << "  parallel      - Toggle running bidirectional searches on two threads and BFS on every core" << endl;
+             cout << "  snapshot      - Save the map, landmarks and hierarchy to a binary snapshot file" << endl;
              cout << "  exit/quit     - Exit the program" << endl;
          } else if (command == "locations") {
              showLocations();
@@ -277,14 +906,62 @@
             getline(cin, start);
             cout << "Enter end location: ";
             getline(cin, end);
-            findRoute(start, end, false);
+            findRoute(start, end, ALGORITHM_BFS);
          } else if (command == "dijkstra") {
             string start, end;
             cout << "Enter start location: ";
             getline(cin, start);
             cout << "Enter end location: ";
             getline(cin, end);
-            findRoute(start, end, true);
+            findRoute(start, end, ALGORITHM_DIJKSTRA);
+         } else if (command == "bibfs") {
+            string start, end;
+            cout << "Enter start location: ";
+            getline(cin, start);
+            cout << "Enter end location: ";
+            getline(cin, end);
+            findRoute(start, end, ALGORITHM_BIDIRECTIONAL_BFS);
+         } else if (command == "bidijkstra") {
+            string start, end;
+            cout << "Enter start location: ";
+            getline(cin, start);
+            cout << "Enter end location: ";
+            getline(cin, end);
+            findRoute(start, end, ALGORITHM_BIDIRECTIONAL_DIJKSTRA);
+         } else if (command == "astar") {
+            string start, end;
+            cout << "Enter start location: ";
+            getline(cin, start);
+            cout << "Enter end location: ";
+            getline(cin, end);
+            findRoute(start, end, ALGORITHM_ASTAR);
+         } else if (command == "alt") {
+            string start, end;
+            cout << "Enter start location: ";
+            getline(cin, start);
+            cout << "Enter end location: ";
+            getline(cin, end);
+            findRoute(start, end, ALGORITHM_ALT);
+         } else if (command == "ch") {
+            string start, end;
+            cout << "Enter start location: ";
+            getline(cin, start);
+            cout << "Enter end location: ";
+            getline(cin, end);
+            findRoute(start, end, ALGORITHM_CH);
+         } else if (command == "landmarks") {
+            string countStr, selection;
+            cout << "Enter number of landmarks: ";
+            getline(cin, countStr);
+            cout << "Enter selection method (farthest, avoid): ";
+            getline(cin, selection);
+            transform(selection.begin(), selection.end(), selection.begin(), ::tolower);
+            try {
+                int count = stoi(countStr);
+                prepareLandmarks(count, normalizeLocationName(selection) == "avoid" ? LANDMARKS_AVOID : LANDMARKS_FARTHEST);
+            } catch (const exception& e) {
+                cerr << "Error parsing landmark count '" << countStr << "': " << e.what() << endl;
+            }
          } else if (command == "compare") {
             string start, end;
             cout << "Enter start location: ";
@@ -292,6 +969,83 @@
             cout << "Enter end location: ";
             getline(cin, end);
             compareAlgorithms(start, end);
+         } else if (command == "matrix") {
+            string sources, targets, outputFile;
+            cout << "Enter source locations separated by commas: ";
+            getline(cin, sources);
+            cout << "Enter target locations separated by commas: ";
+            getline(cin, targets);
+            cout << "Enter a file to save the matrix to (blank to skip): ";
+            getline(cin, outputFile);
+            showDistanceMatrix(sources, targets, outputFile);
+         } else if (command == "reachable") {
+            string start, maxDistance;
+            cout << "Enter start location: ";
+            getline(cin, start);
+            cout << "Enter maximum distance (blank for no limit): ";
+            getline(cin, maxDistance);
+            showReachable(start, maxDistance);
+         } else if (command == "hops") {
+            string start;
+            cout << "Enter start location: ";
+            getline(cin, start);
+            showHops(start);
+         } else if (command == "alternatives") {
+            string start, end, count;
+            cout << "Enter start location: ";
+            getline(cin, start);
+            cout << "Enter end location: ";
+            getline(cin, end);
+            cout << "Enter number of routes: ";
+            getline(cin, count);
+            showAlternatives(start, end, count);
+         } else if (command == "traffic") {
+            string updates;
+            cout << "Enter updates as from,to,weight[,metric] separated by semicolons: ";
+            getline(cin, updates);
+            applyTrafficUpdates(updates);
+         } else if (command == "track") {
+            string start;
+            cout << "Enter start location: ";
+            getline(cin, start);
+            trackLocation(start);
+         } else if (command == "close") {
+            string locations;
+            cout << "Enter locations to close separated by commas: ";
+            getline(cin, locations);
+            vector<string> names;
+            stringstream ss(locations);
+            string name;
+            while (getline(ss, name, ',')) {
+                names.push_back(name);
+            }
+            closeLocations(names);
+         } else if (command == "cache") {
+            showCacheStats();
+         } else if (command == "queue") {
+            string type;
+            cout << "Enter queue type (auto, heap, radix, bucket): ";
+            getline(cin, type);
+            setQueueType(type);
+         } else if (command == "metric") {
+            string name;
+            cout << "Enter metric (length, time): ";
+            getline(cin, name);
+            if (setMetric(name)) {
+                cout << "Routes will minimize " << (pathFinder->getMetric() == METRIC_TIME ? "travel time." : "length.") << endl;
+            }
+         } else if (command == "parallel") {
+            pathFinder->setParallel(!pathFinder->isParallel());
+            if (pathFinder->isParallel()) {
+                cout << "Bidirectional searches will run on two threads and BFS levels on every core." << endl;
+            } else {
+                cout << "Searches will run on one thread." << endl;
+            }
+         } else if (command == "snapshot") {
+            string filename;
+            cout << "Enter snapshot file name: ";
+            getline(cin, filename);
+            saveSnapshot(normalizeLocationName(filename));
          } else {
              cout << "Unknown command. Type 'help' for a list of commands." << endl;
          }
@@ -300,7 +1054,20 @@
      cout << "Thank you for using Middle Earth Navigator. Goodbye!" << endl;
  }
 
- string Navigator::normalizeLocationName(const string& location) {
+ // Helper to list the names of all locations in the map being searched
+vector<string> Navigator::getLocationNames() const {
+    // The compact view covers both text data and snapshots
+    const CompactGraph& compact = pathFinder->getCompact();
+    vector<string> locations;
+    for (int v = 0; v < compact.getNumVertices(); v++) {
+        if (compact.isLive(v)) {
+            locations.push_back(string(compact.getName(v)));
+        }
+    }
+    return locations;
+}
+
+string Navigator::normalizeLocationName(const string& location) {
     string normalized = location;
     
     // Trim leading whitespace, carriage returns, and newlines
@@ -322,12 +1089,12 @@
 
 bool Navigator::locationExists(const string& location, string& suggestion) {
     string normalizedLocation = normalizeLocationName(location);
-    if (graph.getNode(normalizedLocation)) {
+    if (pathFinder->getCompact().getVertexId(normalizedLocation) != INVALID_VERTEX) {
         return true;
     }
     
     // Location doesn't exist, try to find a similar one
-    vector<string> locations = graph.getAllNodeIds();
+    vector<string> locations = getLocationNames();
     string closest;
     int minDistance = INT_MAX;
     
@@ -341,4 +1108,321 @@ bool Navigator::locationExists(const string& location, string& suggestion) {
     }
     
     return false;
-}
\ No newline at end of file
+}
+
+ // Answer start,end[,algorithm[,metric]] query lines from in without prompting, on numThreads workers
+ bool Navigator::runBatch(istream& in, ostream& out, int numThreads) {
+     if (numThreads <= 0) {
+         numThreads = thread::hardware_concurrency();
+     }
+     if (numThreads <= 0) {
+         numThreads = 1;
+     }
+     if (numThreads > DEFAULT_MAX_READERS) {
+         numThreads = DEFAULT_MAX_READERS;
+     }
+     const CompactGraph& compact = pathFinder->getCompact();
+     unsigned long long hitsBefore = routeCache.getHits();
+     size_t repeats = 0;
+
+     size_t lineNumber = 0;
+     size_t answered = 0;
+     size_t failed = 0;
+     size_t updatesApplied = 0;
+     SearchStats batchStats;
+     vector<BatchQuery> queries;
+     queries.reserve(BATCH_BLOCK_SIZE);
+     string line;
+     bool more = true;
+     bool stale = true; // Whether the published version lags behind the path finder
+     while (more) {
+         // Read and check a block of queries, up to the next update; names must match exactly
+         queries.clear();
+         string update;
+         size_t updateLine = 0;
+         bool needsLandmarks = false;
+         bool needsHierarchy = false;
+         Metric landmarkMetric = METRIC_LENGTH;
+         Metric hierarchyMetric = METRIC_LENGTH;
+         while (queries.size() < BATCH_BLOCK_SIZE) {
+             if (!getline(in, line)) {
+                 more = false;
+                 break;
+             }
+             lineNumber++;
+             string text = trimField(line);
+
+             // Skip empty lines and comments
+             if (text.empty() || text[0] == '#') {
+                 continue;
+             }
+
+             // An update applies to the queries after it
+             if (text.compare(0, 7, "update ") == 0) {
+                 update = text.substr(7);
+                 updateLine = lineNumber;
+                 break;
+             }
+
+             BatchQuery query;
+             query.cached = false;
+             query.sameAs = queries.size();
+             query.version = 0;
+             query.algorithm = ALGORITHM_DIJKSTRA;
+             query.algorithmName = "dijkstra";
+             query.metric = pathFinder->getMetric();
+             query.weight = -1;
+             stringstream ss(text);
+             string field;
+             vector<string> fields;
+             while (getline(ss, field, ',')) {
+                 fields.push_back(trimField(field));
+             }
+             string metricName;
+             if (fields.size() < 2 || fields.size() > 4) {
+                 query.error = "Malformed query on line " + to_string(lineNumber);
+             } else {
+                 query.start = fields[0];
+                 query.end = fields[1];
+                 if (fields.size() >= 3) {
+                     query.algorithmName = fields[2];
+                     transform(query.algorithmName.begin(), query.algorithmName.end(), query.algorithmName.begin(), ::tolower);
+                 }
+                 if (fields.size() == 4) {
+                     metricName = fields[3];
+                     transform(metricName.begin(), metricName.end(), metricName.begin(), ::tolower);
+                 }
+                 if (!parseAlgorithm(query.algorithmName, query.algorithm)) {
+                     query.error = "Unknown algorithm '" + query.algorithmName + "'";
+                 } else if (!metricName.empty() && !parseMetric(metricName, query.metric)) {
+                     query.error = "Unknown metric '" + metricName + "'";
+                 } else if ((query.algorithm == ALGORITHM_ALT || query.algorithm == ALGORITHM_CH) && compact.isDirected()) {
+                     query.error = "The map has one-way paths, which " + query.algorithmName + " cannot search";
+                 } else if (compact.getVertexId(query.start) == INVALID_VERTEX) {
+                     query.error = "Location '" + query.start + "' does not exist";
+                 } else if (compact.getVertexId(query.end) == INVALID_VERTEX) {
+                     query.error = "Location '" + query.end + "' does not exist";
+                 }
+             }
+             // A version holds preprocessing for one metric, which the block's first query that needs
+             // it picks; workers would have to redo it for any other
+             if (query.error.empty() && query.algorithm == ALGORITHM_ALT) {
+                 if (!needsLandmarks) {
+                     needsLandmarks = true;
+                     landmarkMetric = query.metric;
+                 } else if (query.metric != landmarkMetric) {
+                     query.error = "ALT queries of a block must share one metric";
+                 }
+             }
+             if (query.error.empty() && query.algorithm == ALGORITHM_CH) {
+                 if (!needsHierarchy) {
+                     needsHierarchy = true;
+                     hierarchyMetric = query.metric;
+                 } else if (query.metric != hierarchyMetric) {
+                     query.error = "CH queries of a block must share one metric";
+                 }
+             }
+             queries.push_back(query);
+         }
+
+         // The workers only read the preprocessing, so it is built here first, for the metric it is used with
+         Metric selected = pathFinder->getMetric();
+         if (needsLandmarks && (pathFinder->getLandmarks().isEmpty() || pathFinder->getLandmarks().getMetric() != landmarkMetric)) {
+             cerr << "Preparing landmarks..." << endl;
+             pathFinder->setMetric(landmarkMetric);
+             pathFinder->prepareLandmarks(DEFAULT_NUM_LANDMARKS, LANDMARKS_FARTHEST, landmarkCacheFile(landmarkMetric));
+             stale = true;
+         }
+         if (needsHierarchy && (pathFinder->getContractionHierarchy().isEmpty() ||
+                                pathFinder->getContractionHierarchy().getMetric() != hierarchyMetric)) {
+             cerr << "Contracting the graph..." << endl;
+             pathFinder->setMetric(hierarchyMetric);
+             pathFinder->prepareContractionHierarchy();
+             stale = true;
+         }
+         pathFinder->setMetric(selected);
+         if (stale) {
+             versions.publish(pathFinder->createVersion(graph.getVersion()));
+             stale = false;
+         }
+
+         // Serve what the route cache holds and spot repeated queries here, so the workers only search
+         unsigned long long publishedNumber = versions.current()->number;
+         unordered_map<string, size_t> firstOf;
+         for (size_t i = 0; i < queries.size(); i++) {
+             BatchQuery& query = queries[i];
+             if (!query.error.empty()) {
+                 continue;
+             }
+             string key = queryKey(query);
+             unordered_map<string, size_t>::iterator seen = firstOf.find(key);
+             if (seen != firstOf.end()) {
+                 query.sameAs = seen->second;
+             } else if (routeCache.lookup(query.start, query.end, query.algorithm, query.metric, publishedNumber,
+                                          query.path, query.weight)) {
+                 query.cached = true;
+             } else {
+                 firstOf[key] = i;
+             }
+         }
+
+         // Answer the block. Worker 0 runs on this thread unless there is an update to apply, in which
+         // case this thread is the writer: it changes the path finder's own copy of the map while the
+         // workers search the published one, then publishes once every query of the block has started
+         size_t threadCount = numThreads;
+         if (threadCount > queries.size()) {
+             threadCount = queries.size();
+         }
+
+         // Claim the workers' reader slots before any starts; fewer workers run if some are taken, and
+         // the block's searches fail if none is left
+         vector<int> slots;
+         while (slots.size() < threadCount) {
+             int slot = versions.registerReader();
+             if (slot == -1) {
+                 break;
+             }
+             slots.push_back(slot);
+         }
+         if (slots.empty() && threadCount > 0) {
+             for (size_t i = 0; i < queries.size(); i++) {
+                 if (queries[i].error.empty() && !queries[i].cached) {
+                     queries[i].error = "No reader slot was free to answer it";
+                 }
+             }
+         }
+         threadCount = slots.size();
+         size_t firstThread = update.empty() ? 1 : 0;
+         vector<PathFinder*> finders;
+         for (size_t i = 0; i < threadCount; i++) {
+             finders.push_back(pathFinder->createWorker());
+         }
+         atomic<size_t> next(0);
+         atomic<size_t> started(0);
+         vector<SearchStats> workerStats(threadCount);
+         vector<thread> workers;
+         for (size_t i = firstThread; i < threadCount; i++) {
+             workers.push_back(thread(batchWorker, finders[i], slots[i], ref(queries), ref(next), ref(started), ref(versions),
+                                      ref(workerStats[i])));
+         }
+         unsigned long long versionBefore = graph.getVersion();
+         if (!update.empty()) {
+             GraphVersion* updated = prepareUpdatedVersion(update);
+             while (threadCount > 0 && started.load() < queries.size()) {
+                 this_thread::yield();
+             }
+             if (updated) {
+                 versions.publish(updated);
+                 updatesApplied++;
+             } else {
+                 cerr << "Error: Could not apply the update on line " << updateLine << endl;
+                 failed++;
+             }
+         } else if (threadCount > 0) {
+             batchWorker(finders[0], slots[0], queries, next, started, versions, workerStats[0]);
+         }
+         for (size_t i = 0; i < workers.size(); i++) {
+             workers[i].join();
+         }
+         for (size_t i = 0; i < finders.size(); i++) {
+             batchStats.add(workerStats[i]);
+             delete finders[i];
+             versions.unregisterReader(slots[i]);
+         }
+
+         // Copy answers to the repeats and remember the searched ones for later blocks
+         for (size_t i = 0; i < queries.size(); i++) {
+             BatchQuery& query = queries[i];
+             if (!query.error.empty() || query.cached) {
+                 continue;
+             }
+             if (query.sameAs != i) {
+                 const BatchQuery& first = queries[query.sameAs];
+                 query.path = first.path;
+                 query.weight = first.weight;
+                 repeats++;
+             } else {
+                 routeCache.insert(query.start, query.end, query.algorithm, query.metric, query.version, query.path, query.weight);
+             }
+         }
+
+         // Versions the workers held can go now. A snapshot's weights change without the graph's
+         // version moving, so its cached routes are dropped once nothing can add old ones
+         versions.reclaim();
+         if (!update.empty() && graph.getVersion() == versionBefore) {
+             routeCache.clear();
+         }
+
+         // Write the answers in input order
+         for (size_t i = 0; i < queries.size(); i++) {
+             const BatchQuery& query = queries[i];
+             out << query.start << "," << query.end << "," << query.algorithmName << ",";
+             if (!query.error.empty()) {
+                 out << "error," << query.error << "\n";
+                 failed++;
+                 continue;
+             }
+             if (query.path.empty()) {
+                 out << "-1,\n";
+             } else {
+                 out << query.weight << ",";
+                 for (size_t j = 0; j < query.path.size(); j++) {
+                     if (j > 0) {
+                         out << ";";
+                     }
+                     out << query.path[j];
+                 }
+                 out << "\n";
+             }
+             answered++;
+         }
+     }
+     out.flush();
+
+     cerr << "Answered " << answered << " queries";
+     if (failed > 0) {
+         cerr << " (" << failed << " could not be read)";
+     }
+     if (updatesApplied > 0) {
+         cerr << " and applied " << updatesApplied << (updatesApplied == 1 ? " update" : " updates");
+     }
+     cerr << " on " << numThreads << " threads, " << routeCache.getHits() - hitsBefore + repeats << " from the route cache." << endl;
+     if (StatsPolicy::ENABLED) {
+         cerr << "Search statistics over the queries not served from the cache (times are summed over threads):" << endl;
+         batchStats.print(cerr, "  ");
+     }
+     return failed == 0;
+ }
+
+ // Helper to apply a batch update line to the graph and build the version that shows it, rebuilding the
+ // preprocessing the update dropped so that readers of the new version do not have to
+ GraphVersion* Navigator::prepareUpdatedVersion(const string& updates) {
+     vector<WeightUpdate> batch;
+     if (!parseTrafficUpdates(updates, batch)) {
+         return nullptr;
+     }
+     int numLandmarks = pathFinder->getLandmarks().getNumLandmarks();
+     Metric landmarkMetric = pathFinder->getLandmarks().getMetric();
+     LandmarkSelection landmarkSelection = pathFinder->getLandmarkSelection();
+     string landmarkFile = pathFinder->getLandmarkCacheFile();
+     bool hadHierarchy = !pathFinder->getContractionHierarchy().isEmpty();
+     Metric hierarchyMetric = pathFinder->getContractionHierarchy().getMetric();
+     vector<const RememberedRoute*> noRoutes;
+     vector<size_t> invalidated;
+     if (!pathFinder->updateEdgeWeights(batch, noRoutes, invalidated)) {
+         return nullptr;
+     }
+
+     // Rebuild for the metric each was built for, the way it was built, whatever routes are found by now
+     Metric selected = pathFinder->getMetric();
+     if (numLandmarks > 0 && pathFinder->getLandmarks().isEmpty()) {
+         pathFinder->setMetric(landmarkMetric);
+         pathFinder->prepareLandmarks(numLandmarks, landmarkSelection, landmarkFile);
+     }
+     if (hadHierarchy && pathFinder->getContractionHierarchy().isEmpty()) {
+         pathFinder->setMetric(hierarchyMetric);
+         pathFinder->prepareContractionHierarchy();
+     }
+     pathFinder->setMetric(selected);
+     return pathFinder->createVersion(graph.getVersion());
+ }
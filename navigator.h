@@ -12,8 +12,11 @@
  #include <vector>
  #include <fstream>
  #include <sstream>
+ #include <list>
+ #include <unordered_map>
  #include "graph.h"
  #include "pathfinder.h"
+ #include "routecache.h"
  
  using namespace std;
  
@@ -22,24 +25,91 @@
          // Constructor
          Navigator();
          
+         // Print every edge as it is loaded
+         void setVerbose(bool enabled);
+
          // Load data from files
          bool loadData(const string& verticesFile, const string& edgesFile);
+
+         // Load a binary snapshot instead of the text files; the graph is mapped, not parsed
+         bool loadSnapshot(const string& snapshotFile);
+
+         // Write the loaded data and any prepared landmarks and hierarchy to a binary snapshot
+         bool saveSnapshot(const string& snapshotFile);
+
+         // Renumber the loaded locations in bfs, rcm or hilbert order so that searches touch less memory
+         bool reorderVertices(const string& ordering);
          
          // Show available locations
          void showLocations() const;
          
          // Find route between locations
-         void findRoute(const string& start, const string& end, bool useDijkstra);
+         void findRoute(const string& start, const string& end, Algorithm algorithm);
          
          // Compare algorithms
          void compareAlgorithms(const string& start, const string& end);
+
+         // Show the distances between comma-separated lists of sources and targets, and save them
+         // to a binary matrix file when one is named
+         void showDistanceMatrix(const string& sources, const string& targets, const string& outputFile);
+         
+         // List every location reachable from start within maxDistance (blank for no limit), nearest
+         // first, with the stop before it on a shortest route
+         void showReachable(const string& start, const string& maxDistance);
+
+         // Show up to count alternative routes from start to end, shortest first
+         void showAlternatives(const string& start, const string& end, const string& count);
+
+         // List the locations grouped by the number of hops from start
+         void showHops(const string& start);
+
+         // Apply a batch of from,to,weight[,metric] edge updates separated by semicolons, then report the
+         // tracked trees' repairs and the remembered routes the updates invalidated. An update without a
+         // metric changes the one routes are currently found by
+         void applyTrafficUpdates(const string& updates);
+
+         // Close the named locations, removing them and their paths from the map in one batch
+         bool closeLocations(const vector<string>& names);
+
+         // Keep a shortest path tree from start that traffic updates repair
+         void trackLocation(const string& start);
+
+         // Show how many routes the cache holds and how often it has been used
+         void showCacheStats();
+
+         // Select the priority queue used by Dijkstra's algorithm (auto, heap, radix or bucket)
+         void setQueueType(const string& type);
+
+         // Select what routes minimize (length or time); false if the name is not a metric
+         bool setMetric(const string& name);
+         
+         // Pick landmarks for ALT searches, reusing the landmark file next to the edges file when it matches
+         void prepareLandmarks(int count, LandmarkSelection selection);
+
+         // Contract the graph for CH queries
+         void prepareContractionHierarchy();
          
          // Run the navigator interface
          void run();
+
+         // Answer start,end[,algorithm[,metric]] query lines from in without prompting, on numThreads
+         // workers (0 uses one per hardware core); the metric defaults to the selected one. Results are
+         // written to out in input order as start,end,algorithm,weight,path with path names separated by
+         // semicolons. A line "update from,to,weight[,metric];..." changes edge weights for the queries
+         // after it; it is applied while the queries before it are still being answered, so the workers
+         // never stop for it
+         bool runBatch(istream& in, ostream& out, int numThreads);
          
      private:
          Graph graph;
          PathFinder* pathFinder;
+         bool verbose;        // Whether loading prints every edge
+         string dataFileName; // Edges file or snapshot the data came from; landmark tables are cached next to it
+         list<RememberedRoute> recentRoutes; // Routes shown since the last update that changed them, most recent
+                                             // first and at most ROUTE_CACHE_CAPACITY of them
+         unordered_map<string, list<RememberedRoute>::iterator> recentIndex; // The same routes by endpoints and metric
+         RouteCache routeCache; // Routes already found for this version of the graph, shared by batch workers
+         VersionManager versions; // Published copies of the map that batch workers search without locking
          
          // Helper method to load vertices
          bool loadVertices(const string& filename);
@@ -47,9 +117,26 @@
          // Helper method to load edges
          bool loadEdges(const string& filename);
          
+         // Helper method to read from,to,weight[,metric] edge updates separated by semicolons
+         bool parseTrafficUpdates(const string& updates, vector<WeightUpdate>& batch);
+
+         // Helper method to apply a batch update line and build the version that shows it (nullptr if
+         // the update cannot be applied)
+         GraphVersion* prepareUpdatedVersion(const string& updates);
+
+         // Helper method to get the landmark file kept next to the data for a metric ("" without one)
+         string landmarkCacheFile(Metric metric) const;
+
+         // Helper method to remember a shown route, replacing the one with the same endpoints and metric
+         // and forgetting the least recently shown route when the list is full
+         void rememberRoute(const vector<string>& path, Metric metric);
+
          // Helper method to display a path
          void displayPath(const vector<string>& path, bool showWeights);
 
+         // Helper method to list the names of all locations in the map being searched
+         vector<string> getLocationNames() const;
+
          // Helper method to normalize location names
          // This method will remove leading and trailing spaces and convert to lowercase
          string normalizeLocationName(const string& location);
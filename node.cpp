@@ -8,38 +8,60 @@
  #include "node.h"
 
  // Constructors
- Node::Node() : id("") {}
+ Node::Node() : id(INVALID_VERTEX) {}
  
- Node::Node(const string& nodeId) : id(nodeId) {}
+ Node::Node(VertexId nodeId) : id(nodeId) {}
+
+ Node::Node(VertexId nodeId, pmr::memory_resource* resource) : id(nodeId), neighbors(resource) {}
  
  // Getters
- string Node::getId() const {
+ VertexId Node::getId() const {
      return id;
  }
  
- const unordered_map<string, int>& Node::getNeighbors() const {
+ const NeighborMap& Node::getNeighbors() const {
      return neighbors;
  }
+
+ // Setter used when the graph assigns the interned ID
+ void Node::setId(VertexId nodeId) {
+     id = nodeId;
+ }
  
  // Neighbor operations
- void Node::addNeighbor(const string& neighborId, int weight) {
-     neighbors[neighborId] = weight;
+ void Node::addNeighbor(VertexId neighborId, EdgeId edge) {
+     neighbors.insert(make_pair(neighborId, edge));
  }
  
- void Node::removeNeighbor(const string& neighborId) {
+ // Make room for count neighbors so bulk loading does not rehash
+ void Node::reserveNeighbors(size_t count) {
+     neighbors.reserve(count);
+ }
+
+ // Replace every neighbor ID with newIds[ID] when the graph renumbers its nodes
+ void Node::renumberNeighbors(const vector<VertexId>& newIds) {
+     // The new map draws from the same resource, so the swap only exchanges pointers
+     NeighborMap renumbered(neighbors.size(), neighbors.get_allocator());
+     for (NeighborMap::const_iterator it = neighbors.begin(); it != neighbors.end(); ++it) {
+         renumbered.insert(make_pair(newIds[it->first], it->second));
+     }
+     neighbors.swap(renumbered);
+ }
+ 
+ void Node::removeNeighbor(VertexId neighborId) {
      neighbors.erase(neighborId);
  }
+
+ void Node::removeNeighbor(VertexId neighborId, EdgeId edge) {
+     pair<NeighborMap::iterator, NeighborMap::iterator> range = neighbors.equal_range(neighborId);
+     for (NeighborMap::iterator it = range.first; it != range.second; ++it) {
+         if (it->second == edge) {
+             neighbors.erase(it);
+             return;
+         }
+     }
+ }
  
- bool Node::hasNeighbor(const string& neighborId) const {
+ bool Node::hasNeighbor(VertexId neighborId) const {
      return neighbors.find(neighborId) != neighbors.end();
  }
- 
- int Node::getNeighborWeight(const string& neighborId) const {
-    unordered_map<string, int>::const_iterator it = neighbors.find(neighborId);
-     if (it == neighbors.end()) {
-         // Error handling - neighbor not found
-         cerr << "Error: Neighbor '" << neighborId << "' not found for node '" << id << "'" << endl;
-         return -1; // Return a sentinel value to indicate error
-     }
-     return it->second;
- }
\ No newline at end of file
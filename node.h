@@ -9,29 +9,48 @@
  #define NODE_H
  #include <string>
  #include <unordered_map>
+ #include <vector>
+ #include <memory_resource>
  #include <iostream>
+ #include "symboltable.h"
  
  using namespace std;
+
+ // The edges at a node: the ID of the node at the other end mapped to the edge's ID in the graph's
+ // edge table. Parallel edges share a key, and an edge is listed at both of its ends whichever way it
+ // runs. The map allocates from the memory resource its node was given, so a graph can keep every map
+ // in its own arena
+ typedef pmr::unordered_multimap<VertexId, EdgeId> NeighborMap;
  
  class Node {
      public:
-         // Constructors
+         // Constructors; without a resource the neighbor map uses the default heap
          Node();
-         Node(const string& nodeId);
+         Node(VertexId nodeId);
+         Node(VertexId nodeId, pmr::memory_resource* resource);
          
          // Getters
-         string getId() const;
-         const unordered_map<string, int>& getNeighbors() const;
+         VertexId getId() const;
+         const NeighborMap& getNeighbors() const;
+
+         // Setter used when the graph assigns the interned ID
+         void setId(VertexId nodeId);
          
-         // Neighbor operations
-         void addNeighbor(const string& neighborId, int weight);
-         void removeNeighbor(const string& neighborId);
-         bool hasNeighbor(const string& neighborId) const;
-         int getNeighborWeight(const string& neighborId) const;
+         // Neighbor operations; removing by neighbor alone drops every edge to it
+         void addNeighbor(VertexId neighborId, EdgeId edge);
+         void removeNeighbor(VertexId neighborId);
+         void removeNeighbor(VertexId neighborId, EdgeId edge);
+         bool hasNeighbor(VertexId neighborId) const;
+
+         // Make room for count neighbors so bulk loading does not rehash
+         void reserveNeighbors(size_t count);
+
+         // Replace every neighbor ID with newIds[ID] when the graph renumbers its nodes
+         void renumberNeighbors(const vector<VertexId>& newIds);
  
      private:
-         string id;
-         unordered_map<string, int> neighbors; // Maps neighbor node IDs to weights
+         VertexId id; // Interned ID; the name lives once in the graph's symbol table
+         NeighborMap neighbors; // Maps neighbor node IDs to the edges shared with them
  };
  
  #endif // NODE_H
\ No newline at end of file
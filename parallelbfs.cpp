@@ -0,0 +1,288 @@
+/* File: parallelbfs.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the ParallelBFS class.
+ *
+ */
+
+ #include "parallelbfs.h"
+ #include "spinbarrier.h"
+ #include <atomic>
+ #include <thread>
+ #include <functional>
+ #include <cstdint>
+ #include <climits>
+
+ // Top-down levels hand out frontier vertices, and bottom-up levels bitmap words, in chunks of these
+ static const size_t BFS_VERTEX_CHUNK = 64;
+ static const size_t BFS_WORD_CHUNK = 16;
+
+ // State shared by the threads of one run. Everything written during a level and read after its
+ // barrier is kept twice, indexed by level parity, so the next level can start writing at once
+ struct BFSShared {
+     const CompactGraph* graph;
+     const CompactGraph* reverse;        // In-arcs, scanned by bottom-up levels
+     int numThreads;
+     VertexId target;
+     vector<atomic<VertexId> > parents;  // INVALID_VERTEX until visited; the source is its own parent
+     vector<int>& hops;                  // Written by the thread that visits the vertex
+     vector<vector<VertexId> > lists[2]; // lists[p][t] is thread t's part of a top-down frontier
+     vector<atomic<uint64_t> > bitmaps[2]; // Frontier and next frontier of bottom-up levels
+     atomic<size_t> claimed[2];          // Next chunk of the level to claim
+     vector<long long> visited[2];       // Vertices each thread visited in the level
+     vector<long long> visitedArcs[2];   // Arcs out of those vertices (top-down levels only)
+     atomic<int> targetHops;             // Hop count of the target once a level has visited it
+     SpinBarrier barrier;
+     int numLevels;
+     int bottomUpLevels;
+
+     BFSShared(const CompactGraph& g, const CompactGraph& r, int threads, VertexId target, vector<int>& hops)
+         : graph(&g), reverse(&r), numThreads(threads), target(target), parents(g.getNumVertices()), hops(hops),
+           barrier(threads), numLevels(0), bottomUpLevels(0) {
+         targetHops.store(INT_MAX);
+         size_t numWords = (g.getNumVertices() + 63) / 64;
+         for (int p = 0; p < 2; p++) {
+             lists[p].resize(threads);
+             bitmaps[p] = vector<atomic<uint64_t> >(numWords);
+             claimed[p].store(0);
+             visited[p].assign(threads, 0);
+             visitedArcs[p].assign(threads, 0);
+         }
+         for (size_t v = 0; v < parents.size(); v++) {
+             parents[v].store(INVALID_VERTEX, memory_order_relaxed);
+         }
+     }
+ };
+
+ // Helper to get a vertex's degree
+ static inline long long degreeOf(const CompactGraph& g, VertexId v) {
+     return g.edgeEnd(v) - g.edgeBegin(v);
+ }
+
+ // Helper to expand a top-down level: every frontier vertex claims its unvisited neighbors
+ static void topDownStep(BFSShared& shared, int id, int parity, int level) {
+     const CompactGraph& g = *shared.graph;
+     vector<vector<VertexId> >& frontier = shared.lists[parity];
+     vector<VertexId>& next = shared.lists[1 - parity][id];
+     next.clear();
+     long long arcs = 0;
+
+     size_t total = 0;
+     for (int t = 0; t < shared.numThreads; t++) {
+         total += frontier[t].size();
+     }
+     while (true) {
+         size_t start = shared.claimed[parity].fetch_add(BFS_VERTEX_CHUNK);
+         if (start >= total) {
+             break;
+         }
+         size_t end = (start + BFS_VERTEX_CHUNK < total) ? start + BFS_VERTEX_CHUNK : total;
+         int t = 0;
+         size_t offset = 0;
+         for (size_t i = start; i < end; i++) {
+             while (i - offset >= frontier[t].size()) {
+                 offset += frontier[t].size();
+                 t++;
+             }
+             VertexId current = frontier[t][i - offset];
+             for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+                 VertexId neighbor = g.edgeTarget(e);
+                 if (shared.parents[neighbor].load(memory_order_relaxed) != INVALID_VERTEX) {
+                     continue;
+                 }
+                 VertexId expected = INVALID_VERTEX;
+                 if (shared.parents[neighbor].compare_exchange_strong(expected, current)) {
+                     shared.hops[neighbor] = level + 1;
+                     if (neighbor == shared.target) {
+                         shared.targetHops.store(level + 1);
+                     }
+                     next.push_back(neighbor);
+                     arcs += degreeOf(g, neighbor);
+                 }
+             }
+         }
+     }
+     shared.visited[parity][id] = next.size();
+     shared.visitedArcs[parity][id] = arcs;
+ }
+
+ // Helper to expand a bottom-up level: every unvisited vertex looks for an in-neighbor in the frontier
+ // bitmap. A thread owns whole words of the next bitmap, so it writes them without atomics
+ static void bottomUpStep(BFSShared& shared, int id, int parity, int level, int frontIndex) {
+     const CompactGraph& g = *shared.reverse;
+     vector<atomic<uint64_t> >& front = shared.bitmaps[frontIndex];
+     vector<atomic<uint64_t> >& next = shared.bitmaps[1 - frontIndex];
+     size_t n = g.getNumVertices();
+     long long count = 0;
+
+     while (true) {
+         size_t start = shared.claimed[parity].fetch_add(BFS_WORD_CHUNK);
+         if (start >= next.size()) {
+             break;
+         }
+         size_t end = (start + BFS_WORD_CHUNK < next.size()) ? start + BFS_WORD_CHUNK : next.size();
+         for (size_t w = start; w < end; w++) {
+             uint64_t mask = 0;
+             size_t last = (w * 64 + 64 < n) ? w * 64 + 64 : n;
+             for (size_t v = w * 64; v < last; v++) {
+                 if (shared.parents[v].load(memory_order_relaxed) != INVALID_VERTEX) {
+                     continue;
+                 }
+                 for (EdgeId e = g.edgeBegin(v); e < g.edgeEnd(v); e++) {
+                     VertexId neighbor = g.edgeTarget(e);
+                     if (front[neighbor >> 6].load(memory_order_relaxed) & (1ULL << (neighbor & 63))) {
+                         shared.parents[v].store(neighbor, memory_order_relaxed);
+                         shared.hops[v] = level + 1;
+                         if (v == shared.target) {
+                             shared.targetHops.store(level + 1);
+                         }
+                         mask |= 1ULL << (v & 63);
+                         count++;
+                         break;
+                     }
+                 }
+             }
+             next[w].store(mask, memory_order_relaxed);
+         }
+     }
+     shared.visited[parity][id] = count;
+     shared.visitedArcs[parity][id] = 0;
+ }
+
+ // One thread of a BFS run. Every thread makes the same direction decisions from the same totals
+ static void bfsWorker(BFSShared& shared, int id, VertexId source) {
+     const CompactGraph& g = *shared.graph;
+     long long n = g.getNumVertices();
+     size_t numWords = shared.bitmaps[0].size();
+     size_t wordBegin = numWords * id / shared.numThreads;
+     size_t wordEnd = numWords * (id + 1) / shared.numThreads;
+
+     bool bottomUp = false;
+     int frontIndex = 0;
+     long long unexplored = g.getNumArcs(); // Arcs not yet looked at by a top-down level
+     long long frontierArcs = degreeOf(g, source);
+     long long frontierSize = 1;
+     long long previousSize = 0;
+
+     for (int level = 0; ; level++) {
+         int parity = level & 1;
+
+         // Switch direction, converting the frontier between a vertex list and a bitmap
+         if (!bottomUp && frontierArcs > unexplored / BFS_TOP_DOWN_ALPHA) {
+             for (size_t w = wordBegin; w < wordEnd; w++) {
+                 shared.bitmaps[frontIndex][w].store(0, memory_order_relaxed);
+             }
+             shared.barrier.wait();
+             vector<VertexId>& own = shared.lists[parity][id];
+             for (size_t i = 0; i < own.size(); i++) {
+                 shared.bitmaps[frontIndex][own[i] >> 6].fetch_or(1ULL << (own[i] & 63), memory_order_relaxed);
+             }
+             shared.barrier.wait();
+             bottomUp = true;
+         } else if (bottomUp && frontierSize < previousSize && frontierSize <= n / BFS_BOTTOM_UP_BETA) {
+             vector<VertexId>& own = shared.lists[parity][id];
+             own.clear();
+             for (size_t w = wordBegin; w < wordEnd; w++) {
+                 uint64_t bits = shared.bitmaps[frontIndex][w].load(memory_order_relaxed);
+                 while (bits) {
+                     own.push_back(VertexId(w * 64 + __builtin_ctzll(bits)));
+                     bits &= bits - 1;
+                 }
+             }
+             shared.barrier.wait();
+             bottomUp = false;
+             frontierArcs = 1;
+         }
+
+         // Expand the level
+         if (bottomUp) {
+             bottomUpStep(shared, id, parity, level, frontIndex);
+         } else {
+             unexplored -= frontierArcs;
+             topDownStep(shared, id, parity, level);
+         }
+         if (id == 0) {
+             shared.claimed[1 - parity].store(0);
+             shared.numLevels++;
+             if (bottomUp) {
+                 shared.bottomUpLevels++;
+             }
+         }
+         shared.barrier.wait();
+
+         // Total the level
+         previousSize = frontierSize;
+         frontierSize = 0;
+         frontierArcs = 0;
+         for (int t = 0; t < shared.numThreads; t++) {
+             frontierSize += shared.visited[parity][t];
+             frontierArcs += shared.visitedArcs[parity][t];
+         }
+         if (bottomUp) {
+             frontIndex = 1 - frontIndex;
+         }
+         // A faster thread may already be visiting the next level, so only a target reached by this
+         // one counts; otherwise the threads could disagree about stopping
+         if (frontierSize == 0 || shared.targetHops.load() <= level + 1) {
+             break;
+         }
+     }
+ }
+
+ // Constructor; numThreads 0 uses one thread per hardware core
+ ParallelBFS::ParallelBFS(const CompactGraph& g, const CompactGraph& r, int threads)
+     : graph(g), reverse(r), numThreads(threads), numLevels(0), bottomUpLevels(0) {
+     if (numThreads <= 0) {
+         numThreads = thread::hardware_concurrency();
+     }
+     if (numThreads <= 0) {
+         numThreads = 1;
+     }
+ }
+
+ // Search from source, stopping after the level that reaches target unless it is INVALID_VERTEX
+ void ParallelBFS::run(VertexId source, VertexId target, vector<int>& hops, vector<VertexId>& parents) {
+     int n = graph.getNumVertices();
+     hops.assign(n, -1);
+     parents.assign(n, INVALID_VERTEX);
+     numLevels = 0;
+     bottomUpLevels = 0;
+     if (source >= (VertexId)n) {
+         return;
+     }
+     hops[source] = 0;
+     if (source == target) {
+         return;
+     }
+
+     // The source marks itself visited so bottom-up levels never give it a parent
+     BFSShared shared(graph, reverse, numThreads, target, hops);
+     shared.parents[source].store(source);
+     shared.lists[0][0].push_back(source);
+
+     // The first thread runs on this one
+     vector<thread> workers;
+     for (int t = 1; t < numThreads; t++) {
+         workers.push_back(thread(bfsWorker, ref(shared), t, source));
+     }
+     bfsWorker(shared, 0, source);
+     for (size_t i = 0; i < workers.size(); i++) {
+         workers[i].join();
+     }
+
+     for (int v = 0; v < n; v++) {
+         parents[v] = shared.parents[v].load(memory_order_relaxed);
+     }
+     parents[source] = INVALID_VERTEX;
+     numLevels = shared.numLevels;
+     bottomUpLevels = shared.bottomUpLevels;
+ }
+
+ // Get the number of levels the last run expanded, and how many of them ran bottom-up
+ int ParallelBFS::getNumLevels() const {
+     return numLevels;
+ }
+
+ int ParallelBFS::getBottomUpLevels() const {
+     return bottomUpLevels;
+ }
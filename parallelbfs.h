@@ -0,0 +1,49 @@
+/* File: parallelbfs.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the ParallelBFS class, a level-synchronous breadth-first search over
+ *          the compact graph that runs each level on several threads. Small levels are expanded
+ *          top-down from a vertex list; once the frontier's arcs outnumber a fraction of the arcs
+ *          still unexplored, levels run bottom-up instead, with each unvisited vertex looking for
+ *          any parent in a bitmap of the frontier (Beamer's direction-optimizing BFS).
+ *
+ */
+
+ #ifndef PARALLELBFS_H
+ #define PARALLELBFS_H
+ #include <iostream>
+ #include <vector>
+ #include "compactgraph.h"
+
+ using namespace std;
+
+ // Go bottom-up when the frontier's arcs exceed the unexplored arcs divided by this
+ const int BFS_TOP_DOWN_ALPHA = 15;
+
+ // Go back top-down when a shrinking frontier holds fewer than the vertices divided by this
+ const int BFS_BOTTOM_UP_BETA = 18;
+
+ class ParallelBFS {
+     public:
+         // Constructor; reverse is g with its arcs reversed (g itself if no edge is one-way), and
+         // numThreads 0 uses one thread per hardware core
+         ParallelBFS(const CompactGraph& g, const CompactGraph& reverse, int numThreads);
+
+         // Search from source: hops[v] is the hop count to v (-1 if unreachable) and parents[v] the
+         // vertex before it (INVALID_VERTEX for the source and unreachable vertices). With a target,
+         // the search stops after the level that reaches it and farther vertices read as unreachable
+         void run(VertexId source, VertexId target, vector<int>& hops, vector<VertexId>& parents);
+
+         // Get the number of levels the last run expanded, and how many of them ran bottom-up
+         int getNumLevels() const;
+         int getBottomUpLevels() const;
+
+     private:
+         const CompactGraph& graph;
+         const CompactGraph& reverse;
+         int numThreads;
+         int numLevels;
+         int bottomUpLevels;
+ };
+
+ #endif // PARALLELBFS_H
@@ -7,12 +7,595 @@
  */
 
  #include "pathfinder.h"
- #include <queue>
+ #include <climits>
+ #include <thread>
+ #include <atomic>
+ #include <mutex>
+ #include <functional>
+ #include <fstream>
  #include <unordered_set>
- #include <limits>
  
  // Constructor
- PathFinder::PathFinder(Graph& g) : graph(g) {}
+ PathFinder::PathFinder(Graph& g)
+     : graph(&g), compactReady(false), queueType(QUEUE_AUTO), parallel(false), landmarkSelection(LANDMARKS_FARTHEST),
+       view(&compact), landmarkView(&landmarks), hierarchyView(&hierarchy), metric(METRIC_LENGTH) {}
+
+ // Destructor
+ PathFinder::~PathFinder() {
+     for (size_t i = 0; i < trackedTrees.size(); i++) {
+         delete trackedTrees[i];
+     }
+ }
+
+ // Constructor for workers
+ PathFinder::PathFinder(PathFinder& master)
+     : graph(nullptr), compactReady(true), queueType(master.queueType), parallel(false),
+       landmarkSelection(master.landmarkSelection), landmarkCacheFile(master.landmarkCacheFile), view(&master.getBase()), landmarkView(master.landmarkView), hierarchyView(master.hierarchyView),
+       metric(master.metric), metricView(*view, metric, false), reverseView(*view, metric, true) {}
+
+ // Create a finder for another thread that shares this finder's data read-only
+ PathFinder* PathFinder::createWorker() {
+     return new PathFinder(*this);
+ }
+
+ // Copy the compact view and any prepared landmarks and hierarchy into a version for readers
+ GraphVersion* PathFinder::createVersion(unsigned long long number) {
+     GraphVersion* version = new GraphVersion();
+     version->compact = getBase();
+     version->landmarks = *landmarkView;
+     version->hierarchy = *hierarchyView;
+     version->number = number;
+     return version;
+ }
+
+ // Point a worker at a published version
+ bool PathFinder::attach(const GraphVersion* version) {
+     if (graph) {
+         cerr << "Error: Only a worker can search a published version" << endl;
+         return false;
+     }
+     view = &version->compact;
+     landmarkView = &version->landmarks;
+     hierarchyView = &version->hierarchy;
+     refreshViews();
+     return true;
+ }
+
+ // Rebuild the compact view after the graph has been modified
+ void PathFinder::rebuild() {
+     if (!graph) {
+         cerr << "Error: A worker cannot rebuild the shared graph" << endl;
+         return;
+     }
+     compact.build(*graph);
+     compactReady = true;
+     view = &compact;
+     refreshViews();
+
+     // Landmark tables and the hierarchy describe the old view
+     landmarks.clear();
+     hierarchy.clear();
+     landmarkView = &landmarks;
+     hierarchyView = &hierarchy;
+     rebuildTrackedTrees();
+ }
+
+ // Renumber the graph's vertices in the given ordering and rebuild the compact view
+ bool PathFinder::reorderVertices(VertexOrdering ordering) {
+     if (!graph) {
+         cerr << "Error: A worker cannot reorder the shared graph" << endl;
+         return false;
+     }
+     const CompactGraph& g = getCompact();
+     vector<VertexId> order;
+     if (!VertexOrder::compute(g, ordering, order)) {
+         return false;
+     }
+
+     // Find where the tracked sources are going before the old IDs are gone
+     vector<VertexId> newIds(g.getNumVertices(), INVALID_VERTEX);
+     for (size_t i = 0; i < order.size(); i++) {
+         newIds[order[i]] = i;
+     }
+     vector<VertexId> sources;
+     for (size_t i = 0; i < trackedTrees.size(); i++) {
+         sources.push_back(newIds[trackedTrees[i]->getSource()]);
+     }
+
+     // A snapshot's graph is empty, so the order cannot match it
+     if (!graph->renumber(order)) {
+         cerr << "Error: Only a graph loaded from text files can be reordered" << endl;
+         return false;
+     }
+     for (size_t i = 0; i < trackedTrees.size(); i++) {
+         delete trackedTrees[i];
+     }
+     trackedTrees.clear();
+     rebuild();
+
+     for (size_t i = 0; i < sources.size(); i++) {
+         DynamicSSSP* tree = new DynamicSSSP(compact, metric);
+         if (tree->build(sources[i])) {
+             trackedTrees.push_back(tree);
+         } else {
+             delete tree;
+         }
+     }
+     return true;
+ }
+
+ // Remove the named locations and their edges from the graph, then rebuild the compact view once
+ int PathFinder::removeLocations(const vector<string>& names) {
+     if (!graph) {
+         cerr << "Error: A worker cannot change the shared graph" << endl;
+         return -1;
+     }
+
+     // A snapshot's graph is empty, so its names are not the graph's
+     if (graph->getNumNodes() == 0 && getBase().getNumVertices() > 0) {
+         cerr << "Error: Only a graph loaded from text files can have locations removed" << endl;
+         return -1;
+     }
+     vector<VertexId> ids;
+     ids.reserve(names.size());
+     for (size_t i = 0; i < names.size(); i++) {
+         VertexId id = graph->getVertexId(names[i]);
+         if (id != INVALID_VERTEX) {
+             ids.push_back(id);
+         }
+     }
+     int removed = graph->removeNodes(ids);
+     if (removed > 0) {
+         rebuild();
+     }
+     return removed;
+ }
+
+ // Helper to rebuild the tracked trees after the compact view was replaced
+ void PathFinder::rebuildTrackedTrees() {
+     size_t kept = 0;
+     for (size_t i = 0; i < trackedTrees.size(); i++) {
+         if (trackedTrees[i]->build(trackedTrees[i]->getSource())) {
+             trackedTrees[kept++] = trackedTrees[i];
+         } else {
+             delete trackedTrees[i];
+         }
+     }
+     trackedTrees.resize(kept);
+ }
+
+ // Change the weights of existing edges as one batch without rebuilding the compact view
+ bool PathFinder::updateEdgeWeights(const vector<WeightUpdate>& updates, const vector<const RememberedRoute*>& routes,
+                                    vector<size_t>& invalidated) {
+     invalidated.clear();
+     if (!graph) {
+         cerr << "Error: A worker cannot change the shared graph" << endl;
+         return false;
+     }
+     const CompactGraph& g = getBase();
+
+     // Note which edges really change, and which metrics any edge gets lighter in, before the weights
+     // move. An edge is keyed by its two ends whichever way it runs
+     unordered_set<unsigned long long> changedEdges;
+     bool changed[NUM_METRICS] = {};
+     bool lighter[NUM_METRICS] = {};
+     for (size_t i = 0; i < updates.size(); i++) {
+         const WeightUpdate& update = updates[i];
+         CompactGraph weights(g, update.metric, false);
+         int oldWeight = (g.isLive(update.from) && g.isLive(update.to)) ? weights.getEdgeWeight(update.from, update.to) : -1;
+         if (oldWeight >= 0 && oldWeight != update.weight) {
+             VertexId low = (update.from < update.to) ? update.from : update.to;
+             VertexId high = (update.from < update.to) ? update.to : update.from;
+             changedEdges.insert(((unsigned long long)low << 32) | high);
+             changed[update.metric] = true;
+             if (update.weight < oldWeight) {
+                 lighter[update.metric] = true;
+             }
+         }
+     }
+     if (!compact.updateEdgeWeights(updates)) {
+         return false;
+     }
+     graph->updateEdgeWeights(updates);
+     refreshViews();
+
+     // Shortcut weights are sums of the old weights; landmark bounds only survive heavier edges. Either
+     // survives changes to the other metrics
+     if (changed[hierarchy.getMetric()]) {
+         hierarchy.clear();
+         hierarchyView = &hierarchy;
+     }
+     if (lighter[landmarks.getMetric()]) {
+         landmarks.clear();
+         landmarkView = &landmarks;
+     }
+     for (size_t i = 0; i < trackedTrees.size(); i++) {
+         trackedTrees[i]->repair(updates);
+     }
+
+     // A route is stale if its own weight changed, or if an edge of its metric got lighter and a
+     // shorter path now exists. That is checked exactly, with a tracked tree from the route's start
+     // when there is one and a bidirectional search otherwise; heavier edges off the route cannot
+     // make another path shorter
+     for (size_t r = 0; r < routes.size(); r++) {
+         const vector<string>& route = routes[r]->path;
+         Metric routeMetric = routes[r]->metric;
+         CompactGraph weights(g, routeMetric, false);
+         bool stale = route.empty() || g.getVertexId(route.front()) == INVALID_VERTEX;
+         long long weight = 0;
+         for (size_t j = 0; !stale && j + 1 < route.size(); j++) {
+             VertexId from = g.getVertexId(route[j]);
+             VertexId to = g.getVertexId(route[j + 1]);
+             VertexId low = (from < to) ? from : to;
+             VertexId high = (from < to) ? to : from;
+             int arcWeight = (from != INVALID_VERTEX && to != INVALID_VERTEX) ? weights.getEdgeWeight(from, to) : -1;
+             stale = arcWeight < 0 || changedEdges.count(((unsigned long long)low << 32) | high) > 0;
+             weight += arcWeight;
+         }
+         if (!stale && lighter[routeMetric]) {
+             VertexId start = g.getVertexId(route.front());
+             VertexId end = g.getVertexId(route.back());
+             long long distance = -1;
+             for (size_t i = 0; i < trackedTrees.size(); i++) {
+                 if (trackedTrees[i]->getSource() == start && trackedTrees[i]->getMetric() == routeMetric) {
+                     distance = trackedTrees[i]->getDistance(end);
+                     break;
+                 }
+             }
+             if (distance < 0) {
+                 distance = shortestDistance(start, end, routeMetric);
+             }
+             stale = distance < weight;
+         }
+         if (stale) {
+             invalidated.push_back(r);
+         }
+     }
+     return true;
+ }
+
+ // Keep a shortest path tree from source that weight updates repair instead of recomputing
+ bool PathFinder::trackSource(const string& source) {
+     if (!graph) {
+         cerr << "Error: A worker cannot track sources of the shared graph" << endl;
+         return false;
+     }
+     const CompactGraph& g = getCompact();
+     VertexId start = g.getVertexId(source);
+     if (start == INVALID_VERTEX) {
+         cout << "Error: Start node does not exist" << endl;
+         return false;
+     }
+     for (size_t i = 0; i < trackedTrees.size(); i++) {
+         if (trackedTrees[i]->getSource() == start && trackedTrees[i]->getMetric() == metric) {
+             return true;
+         }
+     }
+     DynamicSSSP* tree = new DynamicSSSP(compact, metric);
+     if (!tree->build(start)) {
+         delete tree;
+         return false;
+     }
+     trackedTrees.push_back(tree);
+     return true;
+ }
+
+ // Get the number of tracked sources and the maintained tree of each
+ int PathFinder::getNumTrackedSources() const {
+     return trackedTrees.size();
+ }
+
+ const DynamicSSSP& PathFinder::getTrackedTree(int index) const {
+     return *trackedTrees[index];
+ }
+
+ // Get the compact view weighted by the current metric, building it on first use
+ const CompactGraph& PathFinder::getCompact() {
+     getBase();
+     return metricView;
+ }
+
+ // Helper to get the view with all metrics, building it on first use
+ const CompactGraph& PathFinder::getBase() {
+     if (!compactReady) {
+         rebuild();
+     }
+     return *view;
+ }
+
+ // Helper to make the metric views of the current view again
+ void PathFinder::refreshViews() {
+     metricView = CompactGraph(*view, metric, false);
+     reverseView = CompactGraph(*view, metric, true);
+ }
+
+ // Select the edge attribute the weighted searches minimize
+ void PathFinder::setMetric(Metric newMetric) {
+     if (newMetric != metric) {
+         metric = newMetric;
+         if (compactReady) {
+             refreshViews();
+         }
+     }
+ }
+
+ Metric PathFinder::getMetric() const {
+     return metric;
+ }
+ 
+ // Select the priority queue used by Dijkstra's algorithm
+ void PathFinder::setQueueType(QueueType type) {
+     queueType = type;
+ }
+
+ QueueType PathFinder::getQueueType() const {
+     return queueType;
+ }
+
+ // Get the backend that will actually run (resolves QUEUE_AUTO against the graph)
+ QueueType PathFinder::resolveQueueType() {
+     const CompactGraph& g = getCompact();
+
+     // Monotone integer queues are only valid for non-negative weights
+     if (g.getMinWeight() < 0) {
+         return QUEUE_DARY_HEAP;
+     }
+     if (queueType == QUEUE_BUCKET && g.getMaxWeight() > BUCKET_QUEUE_FORCED_MAX_WEIGHT) {
+         return QUEUE_RADIX_HEAP;
+     }
+     if (queueType != QUEUE_AUTO) {
+         return queueType;
+     }
+
+     // Dial's queue scans one bucket per distance value, which pays off while the weights are small;
+     // beyond that the radix heap's log(maxWeight) redistribution cost is lower
+     if (g.getMaxWeight() <= BUCKET_QUEUE_MAX_WEIGHT) {
+         return QUEUE_BUCKET;
+     }
+     return QUEUE_RADIX_HEAP;
+ }
+ 
+ // Run the two halves of bidirectional searches on separate threads, and BFS levels on every
+ // core, when called through findPath
+ void PathFinder::setParallel(bool enabled) {
+     parallel = enabled;
+ }
+
+ bool PathFinder::isParallel() const {
+     return parallel;
+ }
+
+ // Find a path with the given algorithm, minimizing metric for this query only
+ vector<string> PathFinder::findPath(const string& startNode, const string& endNode, Algorithm algorithm,
+                                     Metric queryMetric) {
+     Metric previous = metric;
+     setMetric(queryMetric);
+     vector<string> path = findPath(startNode, endNode, algorithm);
+     setMetric(previous);
+     return path;
+ }
+
+ // Find a path with the given algorithm (bidirectional searches honor the parallel setting)
+ vector<string> PathFinder::findPath(const string& startNode, const string& endNode, Algorithm algorithm) {
+     switch (algorithm) {
+         case ALGORITHM_BFS:
+             if (parallel) {
+                 return findPathParallelBFS(startNode, endNode, 0);
+             }
+             return findPathBFS(startNode, endNode);
+         case ALGORITHM_BIDIRECTIONAL_BFS:
+             return findPathBidirectionalBFS(startNode, endNode, parallel);
+         case ALGORITHM_BIDIRECTIONAL_DIJKSTRA:
+             return findPathBidirectionalDijkstra(startNode, endNode, parallel);
+         case ALGORITHM_ASTAR:
+             return findPathAStar(startNode, endNode);
+         case ALGORITHM_ALT:
+             return findPathALT(startNode, endNode);
+         case ALGORITHM_CH:
+             return findPathCH(startNode, endNode);
+         case ALGORITHM_DIJKSTRA:
+         default:
+             return findPathDijkstra(startNode, endNode);
+     }
+ }
+
+ // Count the vertices the last findPath with algorithm settled, or labeled for the BFS variants
+ long long PathFinder::countSettled(Algorithm algorithm) const {
+     if (algorithm == ALGORITHM_CH || (algorithm == ALGORITHM_BFS && parallel)) {
+         return -1;
+     }
+     if (algorithm == ALGORITHM_BFS) {
+         return workspaces[0].countLabeled();
+     }
+     if (algorithm == ALGORITHM_BIDIRECTIONAL_BFS) {
+         return (long long)workspaces[0].countLabeled() + workspaces[1].countLabeled();
+     }
+     if (algorithm == ALGORITHM_BIDIRECTIONAL_DIJKSTRA) {
+         return (long long)workspaces[0].countSettled() + workspaces[1].countSettled();
+     }
+     return workspaces[0].countSettled();
+ }
+
+ // Get what the last findPath did; both sides of a bidirectional search are added together
+ SearchStats PathFinder::getLastStats() const {
+     SearchStats stats = workspaces[0].getStats().get();
+     stats.add(workspaces[1].getStats().get());
+     return stats;
+ }
+
+ // Helper to clear both workspaces' statistics and start timing a query's setup; phase times are
+ // kept by the first workspace
+ void PathFinder::startStats() {
+     workspaces[0].getStats().clear();
+     workspaces[1].getStats().clear();
+     workspaces[0].getStats().startPhase();
+ }
+
+ // Check whether an algorithm minimizes total weight (the others minimize hops)
+ bool PathFinder::isWeighted(Algorithm algorithm) {
+     return algorithm != ALGORITHM_BFS && algorithm != ALGORITHM_BIDIRECTIONAL_BFS;
+ }
+
+ // Find shortest path using A* with the Euclidean heuristic, or Dijkstra's order without coordinates
+ vector<string> PathFinder::findPathAStar(const string& startNode, const string& endNode) {
+     if (getCompact().hasCoordinates()) {
+         return findPathAStar<EuclideanHeuristic>(startNode, endNode);
+     }
+     return findPathAStar<ZeroHeuristic>(startNode, endNode);
+ }
+
+ // Find shortest path using A* with landmark lower bounds (builds default landmarks if none are prepared)
+ vector<string> PathFinder::findPathALT(const string& startNode, const string& endNode) {
+     startStats();
+     const CompactGraph& g = getCompact();
+     VertexId start = g.getVertexId(startNode);
+     VertexId end = g.getVertexId(endNode);
+
+     // Check if both nodes exist
+     if (start == INVALID_VERTEX || end == INVALID_VERTEX) {
+         cout << "Error: Start or end node does not exist" << endl;
+         return vector<string>();
+     }
+
+     // A landmark's distances to a vertex and from it differ once edges are one-way
+     if (g.isDirected()) {
+         cout << "Error: ALT needs a map without one-way edges" << endl;
+         return vector<string>();
+     }
+     if (landmarkView->isEmpty() || landmarkView->getMetric() != metric) {
+         prepareLandmarks(DEFAULT_NUM_LANDMARKS, LANDMARKS_FARTHEST, "");
+     }
+     return aStarSearch(g, start, end, LandmarkHeuristic(*landmarkView, end));
+ }
+
+ // Load landmarks from cacheFile if it matches this graph, otherwise pick and compute them
+ // and save them there (an empty cacheFile skips the file)
+ void PathFinder::prepareLandmarks(int k, LandmarkSelection selection, const string& cacheFile) {
+     const CompactGraph& g = getCompact();
+     if (g.isDirected()) {
+         cerr << "Error: Landmarks need a map without one-way edges" << endl;
+         return;
+     }
+     landmarkSelection = selection;
+     landmarkCacheFile = cacheFile;
+     landmarkView = &landmarks;
+     if (!cacheFile.empty() && landmarks.load(cacheFile, g) &&
+         (landmarks.getNumLandmarks() == k || landmarks.getNumLandmarks() == g.getNumVertices())) {
+         return;
+     }
+
+     landmarks.build(g, k, selection);
+     if (!cacheFile.empty()) {
+         landmarks.save(cacheFile);
+     }
+ }
+
+ // Get the prepared landmarks
+ const Landmarks& PathFinder::getLandmarks() const {
+     return *landmarkView;
+ }
+
+ // Get how landmarks were last prepared and the file they are kept in
+ LandmarkSelection PathFinder::getLandmarkSelection() const {
+     return landmarkSelection;
+ }
+
+ const string& PathFinder::getLandmarkCacheFile() const {
+     return landmarkCacheFile;
+ }
+
+ // Find shortest path with the contraction hierarchy (contracts the graph first if needed)
+ vector<string> PathFinder::findPathCH(const string& startNode, const string& endNode) {
+     startStats();
+     StatsPolicy& stats = workspaces[0].getStats();
+     const CompactGraph& g = getCompact();
+     VertexId start = g.getVertexId(startNode);
+     VertexId end = g.getVertexId(endNode);
+
+     // Check if both nodes exist
+     if (start == INVALID_VERTEX || end == INVALID_VERTEX) {
+         cout << "Error: Start or end node does not exist" << endl;
+         return vector<string>();
+     }
+
+     // The upward graph is searched from both ends, which only holds while every edge is two-way
+     if (g.isDirected()) {
+         cout << "Error: CH needs a map without one-way edges" << endl;
+         return vector<string>();
+     }
+     if (hierarchyView->isEmpty() || hierarchyView->getMetric() != metric) {
+         prepareContractionHierarchy();
+     }
+     stats.endPhase(PHASE_SETUP);
+
+     // Shortcuts are already unpacked, so the names map one to one onto original edges
+     vector<VertexId> ids = hierarchyView->findPath(start, end, hierarchyQuery);
+     stats.endPhase(PHASE_SEARCH);
+     vector<string> path;
+     path.reserve(ids.size());
+     for (size_t i = 0; i < ids.size(); i++) {
+         path.push_back(string(g.getName(ids[i])));
+     }
+     stats.endPhase(PHASE_PATH);
+     return path;
+ }
+
+ // Contract the graph for findPathCH; the hierarchy stays valid until the next rebuild
+ void PathFinder::prepareContractionHierarchy() {
+     prepareContractionHierarchy(0.0);
+ }
+
+ // Same, giving up with no hierarchy once contraction has run for maxSeconds (0 for no limit)
+ bool PathFinder::prepareContractionHierarchy(double maxSeconds) {
+     const CompactGraph& g = getCompact();
+     if (g.isDirected()) {
+         cerr << "Error: A contraction hierarchy needs a map without one-way edges" << endl;
+         return false;
+     }
+     bool built = hierarchy.build(g, maxSeconds);
+     hierarchyView = &hierarchy;
+     return built;
+ }
+
+ // Get the prepared contraction hierarchy
+ const ContractionHierarchy& PathFinder::getContractionHierarchy() const {
+     return *hierarchyView;
+ }
+
+ // Write the compact view and any prepared landmarks and hierarchy to a snapshot file
+ bool PathFinder::saveSnapshot(const string& filename) {
+     SnapshotWriter writer;
+     getBase().writeSnapshot(writer);
+     if (!landmarkView->isEmpty()) {
+         landmarkView->writeSnapshot(writer);
+     }
+     if (!hierarchyView->isEmpty()) {
+         hierarchyView->writeSnapshot(writer);
+     }
+     return writer.write(filename);
+ }
+
+ // Search a snapshot file instead of the graph; preprocessing stored in it is reused
+ bool PathFinder::loadSnapshot(const string& filename) {
+     shared_ptr<Snapshot> snapshot = make_shared<Snapshot>();
+     if (!snapshot->open(filename) || !compact.loadSnapshot(snapshot)) {
+         return false;
+     }
+     compactReady = true;
+     view = &compact;
+     refreshViews();
+
+     if (!landmarks.loadSnapshot(*snapshot, compact)) {
+         landmarks.clear();
+     }
+     if (!hierarchy.loadSnapshot(*snapshot, compact.getNumVertices())) {
+         hierarchy.clear();
+     }
+     landmarkView = &landmarks;
+     hierarchyView = &hierarchy;
+     rebuildTrackedTrees();
+     return true;
+ }
  
  // Manually reverse a vector instead of using algorithm's reverse
  void reverseVector(vector<string>& vec) {
@@ -27,34 +610,33 @@
      }
  }
  
- // Reconstruct the path from start to end using the predecessors map
+ // Reconstruct the path from start to end using the predecessors array
  vector<string> PathFinder::reconstructPath(
-     const string& startNode, 
-     const string& endNode, 
-     const unordered_map<string, string>& predecessors) {
+     VertexId startNode, 
+     VertexId endNode, 
+     const SearchWorkspace& workspace) {
      
      vector<string> path;
-     string current = endNode;
+     VertexId current = endNode;
      
      // Check if a path was found
-     if (predecessors.find(endNode) == predecessors.end() && startNode != endNode) {
+     if (workspace.getPredecessor(endNode) == INVALID_VERTEX && startNode != endNode) {
          return path; // Return empty path if no path exists
      }
      
      // Reconstruct the path from end to start
      while (current != startNode) {
-         path.push_back(current);
-         unordered_map<string, string>::const_iterator it = predecessors.find(current);
-         if (it == predecessors.end()) {
+         path.push_back(string(view->getName(current)));
+         current = workspace.getPredecessor(current);
+         if (current == INVALID_VERTEX) {
              // This should never happen if the path exists
              path.clear();
              return path;
          }
-         current = it->second;
      }
      
      // Add the start node
-     path.push_back(startNode);
+     path.push_back(string(view->getName(startNode)));
      
      // Reverse the path to get it from start to end
      reverseVector(path);
@@ -64,145 +646,818 @@
  
  // Find shortest path using BFS
  vector<string> PathFinder::findPathBFS(const string& startNode, const string& endNode) {
+     startStats();
+     const CompactGraph& g = getCompact();
+     VertexId start = g.getVertexId(startNode);
+     VertexId end = g.getVertexId(endNode);
+
      // Check if both nodes exist
-     if (!graph.getNode(startNode) || !graph.getNode(endNode)) {
+     if (start == INVALID_VERTEX || end == INVALID_VERTEX) {
          cout << "Error: Start or end node does not exist" << endl;
          return vector<string>();
      }
      
-     queue<string> q;
-     unordered_set<string> visited;
-     unordered_map<string, string> predecessors;
+     // The queue is a flat array with a read cursor; every vertex enters it at most once
+     SearchWorkspace& workspace = workspaces[0];
+     StatsPolicy& stats = workspace.getStats();
+     workspace.reset(g.getNumVertices());
+     vector<VertexId>& q = workspace.getFrontier();
+     stats.endPhase(PHASE_SETUP);
      
-     // Initialize BFS
-     q.push(startNode);
-     visited.insert(startNode);
+     // Initialize BFS; a vertex is visited once it has a hop count
+     q.push_back(start);
+     workspace.setLabel(start, 0, INVALID_VERTEX);
+     stats.push();
      
      // BFS loop
-    while (!q.empty()) {
-        string current = q.front();
-        q.pop();
+    for (size_t head = 0; head < q.size(); head++) {
+        VertexId current = q[head];
+        stats.pop();
         
         // Check if we reached the destination
-        if (current == endNode) {
+        if (current == end) {
             break;
         }
         
-        // Get the current node
-        Node* currentNode = graph.getNode(current);
-        if (!currentNode) {
-            continue;
-        }
-        
         // Process all neighbors
-        const unordered_map<string, int>& neighbors = currentNode->getNeighbors();
-        for (unordered_map<string, int>::const_iterator it = neighbors.begin(); it != neighbors.end(); ++it) {
-            const string& neighborId = it->first;
+        stats.settle();
+        for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+            VertexId neighbor = g.edgeTarget(e);
+            stats.relax();
             
-            if (visited.find(neighborId) == visited.end()) {
-                visited.insert(neighborId);
-                predecessors[neighborId] = current;
-                q.push(neighborId);
+            if (workspace.getDistance(neighbor) == INT_MAX) {
+                workspace.setLabel(neighbor, workspace.getDistance(current) + 1, current);
+                q.push_back(neighbor);
+                stats.push();
             }
         }
     }
+     stats.endPhase(PHASE_SEARCH);
      
      // Reconstruct the path
-     return reconstructPath(startNode, endNode, predecessors);
+     vector<string> path = reconstructPath(start, end, workspace);
+     stats.endPhase(PHASE_PATH);
+     return path;
  }
  
+ // Find a fewest-hops path with the direction-optimizing BFS, each level on numThreads threads
+ vector<string> PathFinder::findPathParallelBFS(const string& startNode, const string& endNode, int numThreads) {
+     startStats();
+     StatsPolicy& stats = workspaces[0].getStats();
+     const CompactGraph& g = getCompact();
+     VertexId start = g.getVertexId(startNode);
+     VertexId end = g.getVertexId(endNode);
+
+     // Check if both nodes exist
+     if (start == INVALID_VERTEX || end == INVALID_VERTEX) {
+         cout << "Error: Start or end node does not exist" << endl;
+         return vector<string>();
+     }
+
+     // The search stops after the level that reaches the end
+     ParallelBFS search(g, reverseView, numThreads);
+     vector<int> hops;
+     vector<VertexId> parents;
+     stats.endPhase(PHASE_SETUP);
+     search.run(start, end, hops, parents);
+     stats.endPhase(PHASE_SEARCH);
+     if (hops[end] < 0) {
+         return vector<string>();
+     }
+
+     // Walk the parents back from the end
+     vector<string> path(hops[end] + 1);
+     VertexId current = end;
+     for (int i = hops[end]; i >= 0; i--) {
+         path[i] = string(g.getName(current));
+         current = parents[current];
+     }
+     stats.endPhase(PHASE_PATH);
+     return path;
+ }
+
+ // Get the hop count from source to every compact vertex and the vertex before each on a fewest-hops path
+ bool PathFinder::hopDistances(const string& source, vector<int>& hops, vector<VertexId>& parents, int numThreads) {
+     const CompactGraph& g = getCompact();
+     VertexId start = g.getVertexId(source);
+     if (start == INVALID_VERTEX) {
+         cout << "Error: Start node does not exist" << endl;
+         return false;
+     }
+
+     ParallelBFS search(g, reverseView, numThreads);
+     search.run(start, INVALID_VERTEX, hops, parents);
+     return true;
+ }
+
  // Find shortest path using Dijkstra's algorithm
  vector<string> PathFinder::findPathDijkstra(const string& startNode, const string& endNode) {
+     startStats();
+     const CompactGraph& g = getCompact();
+     VertexId start = g.getVertexId(startNode);
+     VertexId end = g.getVertexId(endNode);
+
      // Check if both nodes exist
-     if (!graph.getNode(startNode) || !graph.getNode(endNode)) {
+     if (start == INVALID_VERTEX || end == INVALID_VERTEX) {
          cout << "Error: Start or end node does not exist" << endl;
          return vector<string>();
      }
      
-     // Initialize distances to infinity
-     unordered_map<string, int> distances;
-     unordered_map<string, string> predecessors;
-     unordered_set<string> visited;
-     
-     // Get all nodes
-     vector<string> allNodes = graph.getAllNodeIds();
+     // Run the search on the selected priority queue
+     SearchWorkspace& workspace = workspaces[0];
+     StatsPolicy& stats = workspace.getStats();
+     workspace.reset(g.getNumVertices());
+     QueueType type = resolveQueueType();
+     stats.endPhase(PHASE_SETUP);
+     if (type == QUEUE_BUCKET) {
+         dijkstraSearch(g, start, end, workspace.getBucketQueue(g.getMaxWeight()), workspace);
+     } else if (type == QUEUE_RADIX_HEAP) {
+         dijkstraSearch(g, start, end, workspace.getRadixHeap(), workspace);
+     } else {
+         dijkstraSearch(g, start, end, workspace.getHeap(), workspace);
+     }
+     stats.endPhase(PHASE_SEARCH);
      
-     // Set all distances to infinity
-     unordered_set<string> uniqueNodes(allNodes.begin(), allNodes.end());
-    for (unordered_set<string>::iterator it = uniqueNodes.begin(); it != uniqueNodes.end(); ++it) {
-        distances[*it] = numeric_limits<int>::max();
-    } 
-     // Distance to start is 0
-     distances[startNode] = 0;
+     // Reconstruct the path
+     vector<string> path = reconstructPath(start, end, workspace);
+     stats.endPhase(PHASE_PATH);
+     return path;
+ }
+
+ // Dijkstra's main loop, shared by all queue backends
+ template <class Queue>
+ void PathFinder::dijkstraSearch(const CompactGraph& g, VertexId start, VertexId end,
+                                 Queue& pq, SearchWorkspace& workspace) {
+     StatsPolicy& stats = workspace.getStats();
+
+     // Distance to start is 0; every vertex the workspace has not labeled is at infinity
+     workspace.setLabel(start, 0, INVALID_VERTEX);
      
-     // Create a priority queue
-     BinaryHeap pq;
-     pq.insert(startNode, 0);
+     // Seed the priority queue
+     pq.insert(start, 0);
+     stats.push();
      
      // Dijkstra's algorithm
     while (!pq.isEmpty()) {
         // Get the node with the smallest distance
-        string current = pq.extractMin();
+        VertexId current = pq.extractMin();
+        stats.pop();
         
         // If we've reached the destination, we're done
-        if (current == endNode) {
+        if (current == end) {
             break;
         }
         
         // Skip if already visited
-        if (visited.find(current) != visited.end()) {
+        if (workspace.isSettled(current)) {
             continue;
         }
         
         // Mark as visited
-        visited.insert(current);
-        
-        // Get the current node
-        Node* currentNode = graph.getNode(current);
-        if (!currentNode) {
-            continue;
-        }
+        workspace.settle(current);
+        stats.settle();
         
         // Process all neighbors
-        const unordered_map<string, int>& neighbors = currentNode->getNeighbors();
-        for (unordered_map<string, int>::const_iterator it = neighbors.begin(); it != neighbors.end(); ++it) {
-            const string& neighborId = it->first;
-            int weight = it->second;
+        for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+            VertexId neighbor = g.edgeTarget(e);
+            stats.relax();
             
             // Skip if already visited
-            if (visited.find(neighborId) != visited.end()) {
+            if (workspace.isSettled(neighbor)) {
                 continue;
             }
             
             // Calculate new distance
-            int newDistance = distances[current] + weight;
+            int newDistance = workspace.getDistance(current) + g.edgeWeight(e);
             
             // Update if this is a shorter path
-            if (newDistance < distances[neighborId]) {
-                distances[neighborId] = newDistance;
-                predecessors[neighborId] = current;
+            if (newDistance < workspace.getDistance(neighbor)) {
+                workspace.setLabel(neighbor, newDistance, current);
                 
                 // Update priority queue
-                if (pq.contains(neighborId)) {
-                    pq.decreaseKey(neighborId, newDistance);
+                if (pq.contains(neighbor)) {
+                    pq.decreaseKey(neighbor, newDistance);
+                    stats.decreaseKey();
                 } else {
-                    pq.insert(neighborId, newDistance);
+                    pq.insert(neighbor, newDistance);
+                    stats.push();
                 }
             }
         }
     }
-     
+ }
+ 
+ // Helper function to join a forward and a backward search tree at their meeting vertex
+ vector<string> PathFinder::reconstructBidirectionalPath(
+     VertexId startNode,
+     VertexId meetNode,
+     VertexId endNode,
+     const SearchWorkspace& forward,
+     const SearchWorkspace& backward) {
+
+     // No meeting means no path
+     if (meetNode == INVALID_VERTEX) {
+         return vector<string>();
+     }
+
+     // The forward tree gives start -> meet
+     vector<string> path = reconstructPath(startNode, meetNode, forward);
+     if (path.empty()) {
+         return path;
+     }
+
+     // The backward tree's predecessors lead from meet on towards the end
+     VertexId current = meetNode;
+     while (current != endNode) {
+         current = backward.getPredecessor(current);
+         if (current == INVALID_VERTEX) {
+             // This should never happen if the path exists
+             path.clear();
+             return path;
+         }
+         path.push_back(string(view->getName(current)));
+     }
+
+     return path;
+ }
+
+ // Helper to expand one BFS level: label the unvisited neighbors of frontier one hop deeper
+ static void expandLevel(const CompactGraph& g, const vector<VertexId>& frontier,
+                         SearchWorkspace& workspace, vector<VertexId>& next) {
+     StatsPolicy& stats = workspace.getStats();
+     next.clear();
+     for (size_t i = 0; i < frontier.size(); i++) {
+         VertexId current = frontier[i];
+         stats.pop();
+         stats.settle();
+         for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+             VertexId neighbor = g.edgeTarget(e);
+             stats.relax();
+             if (workspace.getDistance(neighbor) == INT_MAX) {
+                 workspace.setLabel(neighbor, workspace.getDistance(current) + 1, current);
+                 next.push_back(neighbor);
+                 stats.push();
+             }
+         }
+     }
+ }
+
+ // One side's level of a parallel bidirectional BFS, handed to the helper thread
+ struct LevelTask {
+     const CompactGraph* graph;
+     const vector<VertexId>* frontier;
+     SearchWorkspace* workspace;
+     vector<VertexId>* next;
+ };
+
+ static void expandLevelTask(void* argument) {
+     LevelTask* task = (LevelTask*)argument;
+     expandLevel(*task->graph, *task->frontier, *task->workspace, *task->next);
+ }
+
+ // Helper to find the shortest meeting among vertices newly labeled by one side of a bidirectional BFS
+ static void findMeeting(const vector<VertexId>& labeled, const SearchWorkspace& workspace,
+                         const SearchWorkspace& other, VertexId& meet, int& bestHops) {
+     for (size_t i = 0; i < labeled.size(); i++) {
+         VertexId v = labeled[i];
+         int otherDepth = other.getDistance(v);
+         if (otherDepth != INT_MAX && workspace.getDistance(v) + otherDepth < bestHops) {
+             bestHops = workspace.getDistance(v) + otherDepth;
+             meet = v;
+         }
+     }
+ }
+
+ // Find shortest path with BFS grown from both ends; parallel runs the two frontiers on separate threads
+ vector<string> PathFinder::findPathBidirectionalBFS(const string& startNode, const string& endNode, bool parallel) {
+     startStats();
+     StatsPolicy& stats = workspaces[0].getStats();
+     const CompactGraph& g = getCompact();
+     VertexId start = g.getVertexId(startNode);
+     VertexId end = g.getVertexId(endNode);
+
+     // Check if both nodes exist
+     if (start == INVALID_VERTEX || end == INVALID_VERTEX) {
+         cout << "Error: Start or end node does not exist" << endl;
+         return vector<string>();
+     }
+
+     // The depth of a vertex is its distance label in that side's workspace
+     SearchWorkspace& forward = workspaces[0];
+     SearchWorkspace& backward = workspaces[1];
+     forward.reset(g.getNumVertices());
+     backward.reset(g.getNumVertices());
+     vector<VertexId>& forwardFrontier = forward.getFrontier();
+     vector<VertexId>& backwardFrontier = backward.getFrontier();
+     vector<VertexId>& forwardNext = forward.getNextFrontier();
+     vector<VertexId>& backwardNext = backward.getNextFrontier();
+     forwardFrontier.push_back(start);
+     backwardFrontier.push_back(end);
+     forward.setLabel(start, 0, INVALID_VERTEX);
+     backward.setLabel(end, 0, INVALID_VERTEX);
+     forward.getStats().push();
+     backward.getStats().push();
+     stats.endPhase(PHASE_SETUP);
+
+     VertexId meet = (start == end) ? start : INVALID_VERTEX;
+     int bestHops = INT_MAX;
+
+     // Grow one level at a time until the two balls touch or one side runs out of vertices; the
+     // backward side follows arcs against their direction
+     const CompactGraph& reverse = reverseView;
+     while (meet == INVALID_VERTEX && !forwardFrontier.empty() && !backwardFrontier.empty()) {
+         // On one thread, grow the smaller frontier; in parallel mode, grow both at once
+         bool expandForward = parallel || forwardFrontier.size() <= backwardFrontier.size();
+         bool expandBackward = parallel || !expandForward;
+
+         if (parallel) {
+             // Each side only writes its own arrays, so the threads need no synchronization beyond
+             // handing the backward level to the helper thread and waiting for it
+             LevelTask task = {&reverse, &backwardFrontier, &backward, &backwardNext};
+             helper.run(expandLevelTask, &task);
+             expandLevel(g, forwardFrontier, forward, forwardNext);
+             helper.wait();
+         } else if (expandForward) {
+             expandLevel(g, forwardFrontier, forward, forwardNext);
+         } else {
+             expandLevel(reverse, backwardFrontier, backward, backwardNext);
+         }
+
+         // Any vertex labeled by both sides was newly labeled by one of them in this round; once
+         // the first meeting appears, the best one of this round is a shortest path
+         if (expandForward) {
+             findMeeting(forwardNext, forward, backward, meet, bestHops);
+             forwardFrontier.swap(forwardNext);
+         }
+         if (expandBackward) {
+             findMeeting(backwardNext, backward, forward, meet, bestHops);
+             backwardFrontier.swap(backwardNext);
+         }
+     }
+     stats.endPhase(PHASE_SEARCH);
+
      // Reconstruct the path
-     return reconstructPath(startNode, endNode, predecessors);
+     vector<string> path = reconstructBidirectionalPath(start, meet, end, forward, backward);
+     stats.endPhase(PHASE_PATH);
+     return path;
+ }
+
+ // Find shortest path with Dijkstra's algorithm grown from both ends; parallel runs the two searches on separate threads
+ vector<string> PathFinder::findPathBidirectionalDijkstra(const string& startNode, const string& endNode, bool parallel) {
+     startStats();
+     StatsPolicy& stats = workspaces[0].getStats();
+     const CompactGraph& g = getCompact();
+     VertexId start = g.getVertexId(startNode);
+     VertexId end = g.getVertexId(endNode);
+
+     // Check if both nodes exist
+     if (start == INVALID_VERTEX || end == INVALID_VERTEX) {
+         cout << "Error: Start or end node does not exist" << endl;
+         return vector<string>();
+     }
+
+     workspaces[0].reset(g.getNumVertices());
+     workspaces[1].reset(g.getNumVertices());
+     stats.endPhase(PHASE_SETUP);
+     VertexId meet;
+     if (start == end) {
+         meet = start;
+     } else if (parallel) {
+         meet = bidirectionalDijkstraParallel(g, reverseView, start, end);
+     } else {
+         meet = bidirectionalDijkstraSequential(g, reverseView, start, end);
+     }
+     stats.endPhase(PHASE_SEARCH);
+
+     // Reconstruct the path
+     vector<string> path = reconstructBidirectionalPath(start, meet, end, workspaces[0], workspaces[1]);
+     stats.endPhase(PHASE_PATH);
+     return path;
+ }
+
+ // Bidirectional Dijkstra with the forward and backward searches alternating on one thread
+ VertexId PathFinder::bidirectionalDijkstraSequential(const CompactGraph& g, const CompactGraph& reverse,
+                                                      VertexId start, VertexId end) {
+     DijkstraHeap* heaps[2] = { &workspaces[0].getHeap(), &workspaces[1].getHeap() };
+     const CompactGraph* arcs[2] = { &g, &reverse };
+     StatsPolicy* stats[2] = { &workspaces[0].getStats(), &workspaces[1].getStats() };
+
+     // Side 0 searches forward from start, side 1 backward from end
+     workspaces[0].setLabel(start, 0, INVALID_VERTEX);
+     workspaces[1].setLabel(end, 0, INVALID_VERTEX);
+     heaps[0]->insert(start, 0);
+     heaps[1]->insert(end, 0);
+     stats[0]->push();
+     stats[1]->push();
+
+     long long best = LLONG_MAX; // Length of the shortest start-end path seen so far
+     VertexId meet = INVALID_VERTEX;
+
+     while (!heaps[0]->isEmpty() && !heaps[1]->isEmpty()) {
+         // Stop once no path through an unsettled vertex can beat the best meeting
+         long long forwardKey = heaps[0]->minPriority();
+         long long backwardKey = heaps[1]->minPriority();
+         if (forwardKey + backwardKey >= best) {
+             break;
+         }
+
+         // Advance the side whose next vertex is closer, so both radii grow evenly
+         int side = (forwardKey <= backwardKey) ? 0 : 1;
+         SearchWorkspace& mine = workspaces[side];
+         SearchWorkspace& theirs = workspaces[1 - side];
+         VertexId current = heaps[side]->extractMin();
+         mine.settle(current);
+         stats[side]->pop();
+         stats[side]->settle();
+
+         // The backward search walks the reversed arcs, which are the same ones without one-way edges
+         const CompactGraph& sideGraph = *arcs[side];
+         for (EdgeId e = sideGraph.edgeBegin(current); e < sideGraph.edgeEnd(current); e++) {
+             VertexId neighbor = sideGraph.edgeTarget(e);
+             stats[side]->relax();
+             if (mine.isSettled(neighbor)) {
+                 continue;
+             }
+
+             // Relax the arc
+             int newDistance = mine.getDistance(current) + sideGraph.edgeWeight(e);
+             if (newDistance < mine.getDistance(neighbor)) {
+                 mine.setLabel(neighbor, newDistance, current);
+                 if (heaps[side]->contains(neighbor)) {
+                     heaps[side]->decreaseKey(neighbor, newDistance);
+                     stats[side]->decreaseKey();
+                 } else {
+                     heaps[side]->insert(neighbor, newDistance);
+                     stats[side]->push();
+                 }
+             }
+
+             // A vertex labeled by both searches closes a start-end path
+             if (theirs.getDistance(neighbor) != INT_MAX) {
+                 long long candidate = (long long)mine.getDistance(neighbor) + theirs.getDistance(neighbor);
+                 if (candidate < best) {
+                     best = candidate;
+                     meet = neighbor;
+                 }
+             }
+         }
+     }
+
+     return meet;
+ }
+
+ // Helper to get the shortest distance from start to end in a metric (LLONG_MAX if unreachable)
+ long long PathFinder::shortestDistance(VertexId start, VertexId end, Metric distanceMetric) {
+     if (start == end) {
+         return 0;
+     }
+     const CompactGraph& g = getBase();
+     CompactGraph forward(g, distanceMetric, false);
+     CompactGraph backward(g, distanceMetric, true);
+     workspaces[0].reset(g.getNumVertices());
+     workspaces[1].reset(g.getNumVertices());
+     VertexId meet = bidirectionalDijkstraSequential(forward, backward, start, end);
+     if (meet == INVALID_VERTEX) {
+         return LLONG_MAX;
+     }
+     return (long long)workspaces[0].getDistance(meet) + workspaces[1].getDistance(meet);
+ }
+
+ // State shared by the two threads of a parallel bidirectional Dijkstra search; each side's distances
+ // are published in its own workspace, whose generation stamps make them free to start over
+ struct SharedMeeting {
+     atomic<int> radius[2]; // Each side's smallest queued key, published after it finishes scanning a vertex
+     atomic<long long> best; // Length of the shortest start-end path seen so far
+     atomic<bool> done;      // Set by whichever side detects that the search is over
+     mutex lock;             // Guards updates of best together with meet
+     VertexId meet;          // Vertex where the best path was closed
+
+     SharedMeeting() : best(LLONG_MAX), done(false), meet(INVALID_VERTEX) {
+         radius[0].store(0);
+         radius[1].store(0);
+     }
+ };
+
+ // What one side of a parallel bidirectional Dijkstra search works on
+ struct HalfTask {
+     const CompactGraph* graph;
+     int side;
+     VertexId source;
+     SharedMeeting* shared;
+     SearchWorkspace* workspace; // This side's labels, also published for the other side
+     const SearchWorkspace* other;
+ };
+
+ // One side of a parallel bidirectional Dijkstra search
+ static void searchHalf(void* argument) {
+     HalfTask* task = (HalfTask*)argument;
+     const CompactGraph& g = *task->graph;
+     int side = task->side;
+     SharedMeeting& shared = *task->shared;
+     SearchWorkspace& workspace = *task->workspace;
+     const SearchWorkspace& other = *task->other;
+     DijkstraHeap& heap = workspace.getHeap();
+     StatsPolicy& stats = workspace.getStats();
+     heap.insert(task->source, 0);
+     stats.push();
+
+     while (!shared.done.load()) {
+         // A side that runs out of vertices has seen every path the other side could close
+         if (heap.isEmpty()) {
+             shared.done.store(true);
+             break;
+         }
+
+         // Every vertex closer than the other side's published radius has been fully scanned there,
+         // so once the radii sum to the best meeting nothing shorter is left to find
+         long long key = heap.minPriority();
+         if (key + shared.radius[1 - side].load() >= shared.best.load()) {
+             shared.done.store(true);
+             break;
+         }
+
+         VertexId current = heap.extractMin();
+         workspace.settle(current);
+         stats.pop();
+         stats.settle();
+         int currentDistance = workspace.getDistance(current);
+
+         // The backward half is handed the reversed arcs, so both halves walk their own graph forward
+         for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+             VertexId neighbor = g.edgeTarget(e);
+             stats.relax();
+             if (workspace.isSettled(neighbor)) {
+                 continue;
+             }
+
+             // Relax the arc; only this thread writes its own labels
+             int newDistance = currentDistance + g.edgeWeight(e);
+             if (newDistance < workspace.getDistance(neighbor)) {
+                 workspace.setLabel(neighbor, newDistance, current);
+                 workspace.publishDistance(neighbor, newDistance);
+                 if (heap.contains(neighbor)) {
+                     heap.decreaseKey(neighbor, newDistance);
+                     stats.decreaseKey();
+                 } else {
+                     heap.insert(neighbor, newDistance);
+                     stats.push();
+                 }
+             }
+
+             // A vertex labeled by both searches closes a start-end path
+             int otherDistance = other.getPublishedDistance(neighbor);
+             if (otherDistance != INT_MAX) {
+                 long long candidate = (long long)workspace.getDistance(neighbor) + otherDistance;
+                 if (candidate < shared.best.load()) {
+                     lock_guard<mutex> guard(shared.lock);
+                     if (candidate < shared.best.load()) {
+                         shared.best.store(candidate);
+                         shared.meet = neighbor;
+                     }
+                 }
+             }
+         }
+
+         // Publish how far this side has fully scanned
+         shared.radius[side].store(heap.isEmpty() ? INT_MAX : heap.minPriority());
+     }
+ }
+
+ // Bidirectional Dijkstra with the forward and backward searches on their own threads
+ VertexId PathFinder::bidirectionalDijkstraParallel(const CompactGraph& g, const CompactGraph& reverse,
+                                                    VertexId start, VertexId end) {
+     // Both sources are labeled before either side starts, so neither can miss the other's
+     SharedMeeting shared;
+     for (int side = 0; side < 2; side++) {
+         VertexId source = (side == 0) ? start : end;
+         workspaces[side].reservePublished(g.getNumVertices());
+         workspaces[side].setLabel(source, 0, INVALID_VERTEX);
+         workspaces[side].publishDistance(source, 0);
+     }
+     HalfTask forward = {&g, 0, start, &shared, &workspaces[0], &workspaces[1]};
+     HalfTask backward = {&reverse, 1, end, &shared, &workspaces[1], &workspaces[0]};
+
+     // Run the backward half on the helper thread and the forward half on this one
+     helper.run(searchHalf, &backward);
+     searchHalf(&forward);
+     helper.wait();
+
+     return shared.meet;
  }
  
+ // What the distance matrix workers share; each row is written by exactly one worker
+ struct MatrixJob {
+     const CompactGraph* graph;
+     QueueType queueType;
+     vector<VertexId> sources;
+     vector<VertexId> targets;
+     vector<unsigned char> isTarget; // isTarget[v] is 1 if v is one of the targets
+     int numDistinct;                // Number of different target vertices
+     atomic<size_t> next;            // Next source row to claim
+     vector<int> matrix;
+ };
+
+ // One-to-many Dijkstra from source that stops once every target is settled; fills the source's row
+ template <class Queue>
+ static void oneToManySearch(const MatrixJob& job, VertexId source, Queue& pq, SearchWorkspace& workspace, int* row) {
+     const CompactGraph& g = *job.graph;
+     workspace.setLabel(source, 0, INVALID_VERTEX);
+     pq.insert(source, 0);
+
+     int remaining = job.numDistinct;
+     while (remaining > 0 && !pq.isEmpty()) {
+         VertexId current = pq.extractMin();
+         if (workspace.isSettled(current)) {
+             continue;
+         }
+         workspace.settle(current);
+         if (job.isTarget[current]) {
+             remaining--;
+         }
+
+         // Relax the arcs out of the settled vertex
+         for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+             VertexId neighbor = g.edgeTarget(e);
+             if (workspace.isSettled(neighbor)) {
+                 continue;
+             }
+             int newDistance = workspace.getDistance(current) + g.edgeWeight(e);
+             if (newDistance < workspace.getDistance(neighbor)) {
+                 workspace.setLabel(neighbor, newDistance, current);
+                 if (pq.contains(neighbor)) {
+                     pq.decreaseKey(neighbor, newDistance);
+                 } else {
+                     pq.insert(neighbor, newDistance);
+                 }
+             }
+         }
+     }
+
+     // A target left unsettled was never reached
+     for (size_t j = 0; j < job.targets.size(); j++) {
+         int distance = workspace.getDistance(job.targets[j]);
+         row[j] = (distance == INT_MAX) ? -1 : distance;
+     }
+ }
+
+ // Worker that fills distance matrix rows until none are left
+ static void distanceMatrixWorker(MatrixJob& job, SearchWorkspace& workspace) {
+     const CompactGraph& g = *job.graph;
+     while (true) {
+         size_t i = job.next.fetch_add(1);
+         if (i >= job.sources.size()) {
+             break;
+         }
+         int* row = job.matrix.data() + i * job.targets.size();
+         workspace.reset(g.getNumVertices());
+         if (job.queueType == QUEUE_BUCKET) {
+             oneToManySearch(job, job.sources[i], workspace.getBucketQueue(g.getMaxWeight()), workspace, row);
+         } else if (job.queueType == QUEUE_RADIX_HEAP) {
+             oneToManySearch(job, job.sources[i], workspace.getRadixHeap(), workspace, row);
+         } else {
+             oneToManySearch(job, job.sources[i], workspace.getHeap(), workspace, row);
+         }
+     }
+ }
+
+ // Get the shortest distance from every source to every target as a dense row-major matrix
+ vector<int> PathFinder::distanceMatrix(const vector<string>& sources, const vector<string>& targets, int numThreads) {
+     const CompactGraph& g = getCompact();
+     MatrixJob job;
+     job.graph = &g;
+     job.queueType = resolveQueueType();
+     job.numDistinct = 0;
+     job.next.store(0);
+
+     // Resolve every name up front so a typo fails before any searching
+     for (size_t i = 0; i < sources.size(); i++) {
+         VertexId v = g.getVertexId(sources[i]);
+         if (v == INVALID_VERTEX) {
+             cout << "Error: Location '" << sources[i] << "' does not exist" << endl;
+             return vector<int>();
+         }
+         job.sources.push_back(v);
+     }
+     job.isTarget.assign(g.getNumVertices(), 0);
+     for (size_t j = 0; j < targets.size(); j++) {
+         VertexId v = g.getVertexId(targets[j]);
+         if (v == INVALID_VERTEX) {
+             cout << "Error: Location '" << targets[j] << "' does not exist" << endl;
+             return vector<int>();
+         }
+         job.targets.push_back(v);
+         if (!job.isTarget[v]) {
+             job.isTarget[v] = 1;
+             job.numDistinct++;
+         }
+     }
+     job.matrix.assign(sources.size() * targets.size(), -1);
+     if (targets.empty()) {
+         return job.matrix;
+     }
+
+     // Rows are claimed one at a time; the first worker runs on this thread with this finder's workspace
+     if (numThreads <= 0) {
+         numThreads = thread::hardware_concurrency();
+     }
+     size_t threadCount = (numThreads > 0) ? numThreads : 1;
+     if (threadCount > sources.size()) {
+         threadCount = sources.size();
+     }
+     if (threadCount > 1) {
+         vector<SearchWorkspace> extraWorkspaces(threadCount - 1);
+         vector<thread> workers;
+         for (size_t i = 0; i + 1 < threadCount; i++) {
+             workers.push_back(thread(distanceMatrixWorker, ref(job), ref(extraWorkspaces[i])));
+         }
+         distanceMatrixWorker(job, workspaces[0]);
+         for (size_t i = 0; i < workers.size(); i++) {
+             workers[i].join();
+         }
+     } else {
+         distanceMatrixWorker(job, workspaces[0]);
+     }
+     return job.matrix;
+ }
+
+ // Compute the full shortest path tree from source with parallel delta-stepping
+ bool PathFinder::shortestPathTree(const string& source, vector<int>& distances, vector<VertexId>& predecessors,
+                                   int numThreads, int delta) {
+     const CompactGraph& g = getCompact();
+     VertexId start = g.getVertexId(source);
+     if (start == INVALID_VERTEX) {
+         cout << "Error: Start node does not exist" << endl;
+         return false;
+     }
+
+     DeltaStepping search(g, numThreads);
+     search.setDelta(delta);
+     return search.run(start, distances, predecessors);
+ }
+
+ // Find up to k loopless paths from start to end, shortest first, with Yen's algorithm
+ vector<vector<string> > PathFinder::findKShortestPaths(const string& startNode, const string& endNode, int k, int numThreads) {
+     const CompactGraph& g = getCompact();
+     VertexId start = g.getVertexId(startNode);
+     VertexId end = g.getVertexId(endNode);
+     if (start == INVALID_VERTEX || end == INVALID_VERTEX) {
+         cout << "Error: Start or end node does not exist" << endl;
+         return vector<vector<string> >();
+     }
+
+     // The distances to the end live in the backward workspace and this thread's spurs in the forward one
+     KShortestPaths search(g, reverseView, workspaces[1], workspaces[0], numThreads);
+     vector<vector<VertexId> > found;
+     vector<long long> weights;
+     vector<vector<string> > paths;
+     if (!search.find(start, end, k, found, weights)) {
+         return paths;
+     }
+     paths.resize(found.size());
+     for (size_t i = 0; i < found.size(); i++) {
+         for (size_t j = 0; j < found[i].size(); j++) {
+             paths[i].push_back(string(g.getName(found[i][j])));
+         }
+     }
+     return paths;
+ }
+
+ // Write a distance matrix to a binary file
+ bool PathFinder::saveDistanceMatrix(const string& filename, const vector<int>& matrix, int rows, int cols) {
+     if ((size_t)rows * cols != matrix.size()) {
+         cerr << "Error: Distance matrix is not " << rows << " by " << cols << endl;
+         return false;
+     }
+     ofstream file(filename, ios::binary);
+     if (!file.is_open()) {
+         cerr << "Error: Could not open file " << filename << endl;
+         return false;
+     }
+
+     // Header: magic, row count, column count
+     unsigned int numRows = rows;
+     unsigned int numCols = cols;
+     file.write("DMX1", 4);
+     file.write((const char*)&numRows, sizeof(numRows));
+     file.write((const char*)&numCols, sizeof(numCols));
+     file.write((const char*)matrix.data(), matrix.size() * sizeof(int));
+
+     if (!file) {
+         cerr << "Error: Could not write the distance matrix to " << filename << endl;
+         return false;
+     }
+     return true;
+ }
+
  // Compare the two algorithms
  void PathFinder::compareAlgorithms(const string& startNode, const string& endNode) {
      cout << "Comparing BFS and Dijkstra's algorithm for path from " << startNode << " to " << endNode << ":" << endl;
      
-     // Get paths without timing
+     // Get paths, keeping each search's statistics
      vector<string> bfsPath = findPathBFS(startNode, endNode);
+     SearchStats bfsStats = getLastStats();
      vector<string> dijkstraPath = findPathDijkstra(startNode, endNode);
+     SearchStats dijkstraStats = getLastStats();
      
      // Report results for BFS
      cout << "\nBFS Results:" << endl;
@@ -219,6 +1474,9 @@
          }
          cout << endl;
      }
+     if (StatsPolicy::ENABLED) {
+         bfsStats.print(cout, "- ");
+     }
      
      // Report results for Dijkstra's
      cout << "\nDijkstra Results:" << endl;
@@ -231,8 +1489,8 @@
          for (size_t i = 0; i < dijkstraPath.size(); i++) {
              cout << dijkstraPath[i];
              if (i < dijkstraPath.size() - 1) {
-                 Node* node = graph.getNode(dijkstraPath[i]);
-                 int weight = node->getNeighborWeight(dijkstraPath[i+1]);
+                 int weight = metricView.getEdgeWeight(metricView.getVertexId(dijkstraPath[i]),
+                                                       metricView.getVertexId(dijkstraPath[i+1]));
                  totalWeight += weight;
                  cout << " -> ";
              }
@@ -240,6 +1498,9 @@
          cout << endl;
          cout << "- Total path weight: " << totalWeight << endl;
      }
+     if (StatsPolicy::ENABLED) {
+         dijkstraStats.print(cout, "- ");
+     }
      
      // Compare the results
      cout << "\nComparison:" << endl;
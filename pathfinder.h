@@ -11,33 +11,395 @@
  #include <vector>
  #include <string>
  #include <unordered_map>
+ #include <climits>
  #include "graph.h"
- #include "binaryheap.h"
+ #include "compactgraph.h"
+ #include "daryheap.h"
+ #include "radixheap.h"
+ #include "bucketqueue.h"
+ #include "heuristics.h"
+ #include "landmarks.h"
+ #include "contractionhierarchy.h"
+ #include "snapshot.h"
+ #include "searchworkspace.h"
+ #include "deltastepping.h"
+ #include "parallelbfs.h"
+ #include "kshortestpaths.h"
+ #include "dynamicsssp.h"
+ #include "searchstats.h"
+ #include "vertexorder.h"
+ #include "helperthread.h"
+ #include "versionmanager.h"
  
  using namespace std;
+
+ // Priority queue backends that findPathDijkstra can run on
+ enum QueueType {
+     QUEUE_AUTO,       // Choose from the weight range of the loaded graph
+     QUEUE_DARY_HEAP,  // Comparison-based 4-ary heap; works for any weights
+     QUEUE_RADIX_HEAP, // Monotone radix heap for non-negative integer weights
+     QUEUE_BUCKET      // Dial's bucket queue; best when the largest weight is small
+ };
+
+ // Point-to-point search algorithms that findPath can dispatch to
+ enum Algorithm {
+     ALGORITHM_BFS,
+     ALGORITHM_DIJKSTRA,
+     ALGORITHM_BIDIRECTIONAL_BFS,
+     ALGORITHM_BIDIRECTIONAL_DIJKSTRA,
+     ALGORITHM_ASTAR,
+     ALGORITHM_ALT,
+     ALGORITHM_CH
+ };
+
+ // Largest edge weight for which QUEUE_AUTO picks the bucket queue over the radix heap
+ const int BUCKET_QUEUE_MAX_WEIGHT = 1024;
+
+ // Largest edge weight for which a forced bucket queue is used; beyond it the bucket array would not
+ // fit in memory, so the radix heap runs instead
+ const int BUCKET_QUEUE_FORCED_MAX_WEIGHT = 1 << 20;
+
+ // A route shown to the user and the metric it minimizes, remembered so weight updates can tell
+ // whether it is still shortest
+ struct RememberedRoute {
+     vector<string> path;
+     Metric metric;
+ };
  
  class PathFinder {
      public:
-         // Constructor
+         // Constructor and destructor
          PathFinder(Graph& g);
+         ~PathFinder();
+
+         // Create a finder for another thread. It searches this finder's compact view, landmarks and
+         // hierarchy read-only with its own search state. Prepare whatever the worker will use first;
+         // this finder must outlive the worker and must not change while the worker runs
+         PathFinder* createWorker();
+
+         // Copy the compact view and any prepared landmarks and hierarchy into a version that readers can
+         // search while this finder goes on changing; number is the graph version it shows. The version
+         // shares every array with this finder, which copies the weights an update changes first
+         GraphVersion* createVersion(unsigned long long number);
+
+         // Point a worker at a published version; the caller keeps the version pinned while the worker
+         // searches it, and attaches again after pinning the next one
+         bool attach(const GraphVersion* version);
          
          // Find shortest path using BFS
          vector<string> findPathBFS(const string& startNode, const string& endNode);
+
+         // Find a fewest-hops path with the direction-optimizing BFS, each level on numThreads threads
+         // (0 uses one per hardware core)
+         vector<string> findPathParallelBFS(const string& startNode, const string& endNode, int numThreads);
+
+         // Get the hop count from source to every compact vertex (-1 if unreachable) and the vertex before
+         // each on a fewest-hops path, with the direction-optimizing BFS on numThreads threads
+         bool hopDistances(const string& source, vector<int>& hops, vector<VertexId>& parents, int numThreads);
          
          // Find shortest path using Dijkstra's algorithm
          vector<string> findPathDijkstra(const string& startNode, const string& endNode);
          
+         // Find shortest path with BFS grown from both ends; parallel runs the two frontiers on separate threads
+         vector<string> findPathBidirectionalBFS(const string& startNode, const string& endNode, bool parallel);
+
+         // Find shortest path with Dijkstra's algorithm grown from both ends; parallel runs the two searches on separate threads
+         vector<string> findPathBidirectionalDijkstra(const string& startNode, const string& endNode, bool parallel);
+         
+         // Find shortest path using A* with a heuristic chosen at compile time, e.g.
+         // findPathAStar<EuclideanHeuristic>(start, end); the heuristic must never overestimate
+         template <class Heuristic>
+         vector<string> findPathAStar(const string& startNode, const string& endNode);
+
+         // Find shortest path using A* with the Euclidean heuristic, or Dijkstra's order without coordinates
+         vector<string> findPathAStar(const string& startNode, const string& endNode);
+
+         // Find shortest path using A* with landmark lower bounds (builds default landmarks if none are
+         // prepared for the metric). Landmark bounds assume two-way edges, so directed graphs are refused
+         vector<string> findPathALT(const string& startNode, const string& endNode);
+
+         // Load landmarks from cacheFile if it matches this graph, otherwise pick and compute them
+         // and save them there (an empty cacheFile skips the file)
+         void prepareLandmarks(int k, LandmarkSelection selection, const string& cacheFile);
+
+         // Get the prepared landmarks
+         const Landmarks& getLandmarks() const;
+
+         // Get how landmarks were last prepared and the file they are kept in ("" for none), so landmarks
+         // an update drops can be picked again the same way
+         LandmarkSelection getLandmarkSelection() const;
+         const string& getLandmarkCacheFile() const;
+
+         // Find shortest path with the contraction hierarchy (contracts the graph first if needed). The
+         // hierarchy keeps one upward graph for both directions, so directed graphs are refused
+         vector<string> findPathCH(const string& startNode, const string& endNode);
+
+         // Contract the graph for findPathCH; the hierarchy stays valid until the next rebuild
+         void prepareContractionHierarchy();
+
+         // Same, giving up with no hierarchy once contraction has run for maxSeconds; false if there is
+         // none afterwards
+         bool prepareContractionHierarchy(double maxSeconds);
+
+         // Get the prepared contraction hierarchy
+         const ContractionHierarchy& getContractionHierarchy() const;
+
+         // Find a path with the given algorithm (bidirectional searches honor the parallel setting)
+         vector<string> findPath(const string& startNode, const string& endNode, Algorithm algorithm);
+
+         // Same, minimizing metric for this query only
+         vector<string> findPath(const string& startNode, const string& endNode, Algorithm algorithm, Metric metric);
+
+         // Select the edge attribute the weighted searches minimize; ALT and CH rebuild their
+         // preprocessing for a new metric on first use, so switching often is cheapest without them
+         void setMetric(Metric metric);
+         Metric getMetric() const;
+
+         // Count the vertices the last findPath with algorithm settled, or labeled for the BFS variants, by
+         // scanning the workspaces it used (-1 for CH and the parallel BFS, which keep their own state).
+         // This costs O(|V|), so it is meant for benchmarks rather than the query path
+         long long countSettled(Algorithm algorithm) const;
+
+         // Get what the last findPath did: vertices settled, arcs relaxed, queue operations and the time
+         // of each phase. All zero unless built with PATHFINDER_STATS; CH and the parallel BFS keep their
+         // own search state, so they only report phase times
+         SearchStats getLastStats() const;
+
+         // Check whether an algorithm minimizes total weight (the others minimize hops)
+         static bool isWeighted(Algorithm algorithm);
+
+         // Get the shortest distance from every source to every target as a dense row-major matrix:
+         // entry i * targets.size() + j is the distance from sources[i] to targets[j], or -1 if there is
+         // no path. Each row is one Dijkstra search that stops once every target is settled; the rows are
+         // spread over numThreads threads (0 uses one per hardware core). Empty if a name is unknown
+         vector<int> distanceMatrix(const vector<string>& sources, const vector<string>& targets, int numThreads);
+
+         // Compute the full shortest path tree from source with parallel delta-stepping: distances[v] is
+         // the distance to compact vertex v (INT_MAX if unreachable) and predecessors[v] the vertex before
+         // it on a shortest path (INVALID_VERTEX for the source and unreachable vertices). numThreads 0 uses
+         // one per hardware core, and delta 0 picks the bucket width from the weights
+         bool shortestPathTree(const string& source, vector<int>& distances, vector<VertexId>& predecessors,
+                               int numThreads, int delta);
+
+         // Find up to k loopless paths from start to end, shortest first, with Yen's algorithm; the spur
+         // searches of each round run on numThreads threads (0 uses one per hardware core). Fewer paths
+         // come back when no more exist, and none if a name is unknown
+         vector<vector<string> > findKShortestPaths(const string& startNode, const string& endNode, int k, int numThreads);
+
+         // Write a distance matrix to a binary file: "DMX1", the row and column counts as 32-bit
+         // unsigned ints, then the rows of 32-bit ints
+         static bool saveDistanceMatrix(const string& filename, const vector<int>& matrix, int rows, int cols);
+         
          // Compare the two algorithms
          void compareAlgorithms(const string& startNode, const string& endNode);
+
+         // Rebuild the compact view after the graph has been modified
+         void rebuild();
+
+         // Renumber the graph's vertices in the given ordering and rebuild the compact view, so that
+         // neighbors sit close together in memory. Names move with their vertices, so every result reads
+         // the same; landmarks and the hierarchy are dropped and tracked trees follow their sources.
+         // Fails for workers and snapshots, which have no graph to renumber
+         bool reorderVertices(VertexOrdering ordering);
+
+         // Remove the named locations and their edges from the graph, then rebuild the compact view once.
+         // Unknown names are skipped; landmarks and the hierarchy are dropped, as are tracked trees whose
+         // source was removed. Returns the number removed, or -1 for workers and snapshots
+         int removeLocations(const vector<string>& names);
+
+         // Change the weights of existing edges as one batch without rebuilding the compact view. The
+         // graph and view take the new weights, the trees of tracked sources are repaired, and the
+         // hierarchy is dropped if its metric changed, as are the landmarks if a weight of theirs fell.
+         // Each update names the metric it changes. invalidated gets, in increasing order, the indices of
+         // the routes whose own weight changed or that a shorter path in their metric now undercuts.
+         // Fails, changing nothing, if an edge is missing
+         bool updateEdgeWeights(const vector<WeightUpdate>& updates, const vector<const RememberedRoute*>& routes,
+                                vector<size_t>& invalidated);
+
+         // Keep a shortest path tree from source, minimizing the current metric, that weight updates
+         // repair instead of recomputing
+         bool trackSource(const string& source);
+
+         // Get the number of tracked sources and the maintained tree of each
+         int getNumTrackedSources() const;
+         const DynamicSSSP& getTrackedTree(int index) const;
+
+         // Get the compact view weighted by the current metric, building it on first use
+         const CompactGraph& getCompact();
+
+         // Write the compact view and any prepared landmarks and hierarchy to a snapshot file
+         bool saveSnapshot(const string& filename);
+
+         // Search a snapshot file instead of the graph; preprocessing stored in it is reused
+         // (rebuild() switches back to the graph)
+         bool loadSnapshot(const string& filename);
+
+         // Select the priority queue used by Dijkstra's algorithm
+         void setQueueType(QueueType type);
+         QueueType getQueueType() const;
+
+         // Get the backend that will actually run (resolves QUEUE_AUTO against the graph, and falls back
+         // from a forced bucket queue when the weights are too large for it)
+         QueueType resolveQueueType();
+
+         // Run the two halves of bidirectional searches on separate threads, and BFS levels on every
+         // core, when called through findPath
+         void setParallel(bool enabled);
+         bool isParallel() const;
          
      private:
-         Graph& graph;
-         
+         Graph* graph;         // The graph the compact view is built from; nullptr for workers
+         CompactGraph compact; // Frozen CSR copy of the graph that the searches run on
+         bool compactReady;    // False until the compact view has been built
+         QueueType queueType;  // Priority queue backend selected for Dijkstra
+         bool parallel;        // Whether findPath runs bidirectional searches on two threads
+         Landmarks landmarks;  // Landmark distance tables for ALT; tied to the current compact view
+         ContractionHierarchy hierarchy; // Shortcuts and vertex order for CH queries; tied to the current compact view
+         LandmarkSelection landmarkSelection; // How prepareLandmarks last picked landmarks, and the file it used
+         string landmarkCacheFile;
+
+         // What the searches read: this finder's own data, or a master's for a worker
+         const CompactGraph* view;
+         const Landmarks* landmarkView;
+         const ContractionHierarchy* hierarchyView;
+         Metric metric;             // Edge attribute the weighted searches minimize
+         CompactGraph metricView;   // The view's arcs weighted by metric, and the same arcs reversed for
+         CompactGraph reverseView;  // backward searches; made again whenever the view or metric changes
+         ContractionHierarchy::Query hierarchyQuery; // This finder's CH search state
+         SearchWorkspace workspaces[2]; // Forward and backward search labels and queues, reused by every query
+         vector<DynamicSSSP*> trackedTrees; // Shortest path trees of hot sources, repaired by weight updates
+         HelperThread helper;           // Runs the backward half of parallel bidirectional searches
+
+         // Constructor for workers
+         PathFinder(PathFinder& master);
+
+         // Finders point into themselves, so they are not copied
+         PathFinder& operator=(const PathFinder& other);
+
+         // Helper to clear both workspaces' statistics and start timing a query's setup
+         void startStats();
+
+         // Helper to make the metric views of the current view again
+         void refreshViews();
+
+         // Helper to get the view with all metrics, building it on first use
+         const CompactGraph& getBase();
+
+         // Helper to rebuild the tracked trees after the compact view was replaced, dropping any whose
+         // source is gone
+         void rebuildTrackedTrees();
+
+         // Dijkstra's main loop, shared by all queue backends
+         template <class Queue>
+         void dijkstraSearch(const CompactGraph& g, VertexId start, VertexId end,
+                             Queue& pq, SearchWorkspace& workspace);
+
+         // Bidirectional Dijkstra with the forward and backward searches alternating on one thread; the
+         // backward search walks reverse, g with its arcs reversed
+         VertexId bidirectionalDijkstraSequential(const CompactGraph& g, const CompactGraph& reverse,
+                                                  VertexId start, VertexId end);
+
+         // Helper to get the shortest distance from start to end in a metric (LLONG_MAX if unreachable)
+         // with a sequential bidirectional Dijkstra search
+         long long shortestDistance(VertexId start, VertexId end, Metric distanceMetric);
+
+         // Bidirectional Dijkstra with the forward and backward searches on their own threads
+         VertexId bidirectionalDijkstraParallel(const CompactGraph& g, const CompactGraph& reverse,
+                                                VertexId start, VertexId end);
+
+         // A* main loop, shared by the coordinate and landmark heuristics
+         template <class Heuristic>
+         vector<string> aStarSearch(const CompactGraph& g, VertexId start, VertexId end, const Heuristic& estimate);
+
          // Helper function to reconstruct the path
          vector<string> reconstructPath(
-             const string& startNode, 
-             const string& endNode, 
-             const unordered_map<string, string>& predecessors);
+             VertexId startNode, 
+             VertexId endNode, 
+             const SearchWorkspace& workspace);
+
+         // Helper function to join a forward and a backward search tree at their meeting vertex
+         vector<string> reconstructBidirectionalPath(
+             VertexId startNode,
+             VertexId meetNode,
+             VertexId endNode,
+             const SearchWorkspace& forward,
+             const SearchWorkspace& backward);
  };
  
+ // Find shortest path using A* with a heuristic chosen at compile time
+ template <class Heuristic>
+ vector<string> PathFinder::findPathAStar(const string& startNode, const string& endNode) {
+     startStats();
+     const CompactGraph& g = getCompact();
+     VertexId start = g.getVertexId(startNode);
+     VertexId end = g.getVertexId(endNode);
+
+     // Check if both nodes exist
+     if (start == INVALID_VERTEX || end == INVALID_VERTEX) {
+         cout << "Error: Start or end node does not exist" << endl;
+         return vector<string>();
+     }
+
+     return aStarSearch(g, start, end, Heuristic(g, end));
+ }
+
+ // A* main loop, shared by the coordinate and landmark heuristics
+ template <class Heuristic>
+ vector<string> PathFinder::aStarSearch(const CompactGraph& g, VertexId start, VertexId end, const Heuristic& estimate) {
+     SearchWorkspace& workspace = workspaces[0];
+     StatsPolicy& stats = workspace.getStats();
+     workspace.reset(g.getNumVertices());
+     stats.endPhase(PHASE_SETUP);
+
+     // The open set is ordered by distance so far plus the estimate of the distance left
+     DijkstraHeap& open = workspace.getHeap();
+     workspace.setLabel(start, 0, INVALID_VERTEX);
+     open.insert(start, estimate(start));
+     stats.push();
+
+    while (!open.isEmpty()) {
+        VertexId current = open.extractMin();
+        stats.pop();
+
+        // If we've reached the destination, we're done
+        if (current == end) {
+            break;
+        }
+
+        // With a consistent heuristic a closed vertex never needs to be reopened
+        workspace.settle(current);
+        stats.settle();
+
+        // Process all neighbors
+        for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+            VertexId neighbor = g.edgeTarget(e);
+            stats.relax();
+            if (workspace.isSettled(neighbor)) {
+                continue;
+            }
+
+            // Update if this is a shorter path
+            int newDistance = workspace.getDistance(current) + g.edgeWeight(e);
+            if (newDistance < workspace.getDistance(neighbor)) {
+                workspace.setLabel(neighbor, newDistance, current);
+
+                int priority = newDistance + estimate(neighbor);
+                if (open.contains(neighbor)) {
+                    open.decreaseKey(neighbor, priority);
+                    stats.decreaseKey();
+                } else {
+                    open.insert(neighbor, priority);
+                    stats.push();
+                }
+            }
+        }
+    }
+     stats.endPhase(PHASE_SEARCH);
+
+     // Reconstruct the path
+     vector<string> path = reconstructPath(start, end, workspace);
+     stats.endPhase(PHASE_PATH);
+     return path;
+ }
+ 
  #endif // PATHFINDER_H
\ No newline at end of file
@@ -7,18 +7,123 @@
 
  #include "navigator.h"
  #include <iostream>
+ #include <fstream>
+ #include <string>
+ #include <vector>
  
  using namespace std;
  
- int main() {
+ // Usage: program3 [verticesFile edgesFile] [--snapshot file] [--write-snapshot file] [--verbose]
+ //                 [--batch queryFile|-] [--threads N] [--reorder bfs|rcm|hilbert] [--close locationsFile]
+ //                 [--metric length|time]
+ int main(int argc, char* argv[]) {
      Navigator navigator;
+     string verticesFile = "Data/MiddleEarthVertices.txt";
+     string edgesFile = "Data/MiddleEarthEdges.txt";
+     string snapshotFile;
+     string writeSnapshotFile;
+     string batchFile;
+     string ordering;
+     string closeFile;
+     string metric;
+     int numThreads = 0;
+
+     // Parse the command line
+     vector<string> files;
+     for (int i = 1; i < argc; i++) {
+         string arg = argv[i];
+         if (arg == "--snapshot" && i + 1 < argc) {
+             snapshotFile = argv[++i];
+         } else if (arg == "--write-snapshot" && i + 1 < argc) {
+             writeSnapshotFile = argv[++i];
+         } else if (arg == "--batch" && i + 1 < argc) {
+             batchFile = argv[++i];
+         } else if (arg == "--threads" && i + 1 < argc) {
+             try {
+                 numThreads = stoi(argv[++i]);
+             } catch (const exception& e) {
+                 cerr << "Error parsing thread count '" << argv[i] << "': " << e.what() << endl;
+                 return 1;
+             }
+         } else if (arg == "--reorder" && i + 1 < argc) {
+             ordering = argv[++i];
+         } else if (arg == "--close" && i + 1 < argc) {
+             closeFile = argv[++i];
+         } else if (arg == "--metric" && i + 1 < argc) {
+             metric = argv[++i];
+         } else if (arg == "--verbose") {
+             navigator.setVerbose(true);
+         } else if (arg.compare(0, 2, "--") == 0) {
+             cerr << "Error: Unknown option " << arg << endl;
+             return 1;
+         } else {
+             files.push_back(arg);
+         }
+     }
+     if (files.size() == 2) {
+         verticesFile = files[0];
+         edgesFile = files[1];
+     } else if (!files.empty()) {
+         cerr << "Usage: " << argv[0] << " [verticesFile edgesFile] [--snapshot file] [--write-snapshot file] [--verbose]"
+              << " [--batch queryFile|-] [--threads N] [--reorder bfs|rcm|hilbert] [--close locationsFile]"
+              << " [--metric length|time]" << endl;
+         return 1;
+     }
      
-     // Load the data
-     if (!navigator.loadData("Data/MiddleEarthVertices.txt", "Data/MiddleEarthEdges.txt")) {
+     // Load the data, from the snapshot when one is given
+     bool loaded = snapshotFile.empty() ? navigator.loadData(verticesFile, edgesFile) : navigator.loadSnapshot(snapshotFile);
+     if (!loaded) {
          cout << "Failed to load data. Exiting." << endl;
          return 1;
      }
+
+     // Optionally find routes by another edge attribute than length
+     if (!metric.empty() && !navigator.setMetric(metric)) {
+         return 1;
+     }
+
+     // Optionally close the locations listed one per line, all in one batch
+     if (!closeFile.empty()) {
+         ifstream closures(closeFile);
+         if (!closures.is_open()) {
+             cerr << "Error: Could not open file " << closeFile << endl;
+             return 1;
+         }
+         vector<string> names;
+         string name;
+         while (getline(closures, name)) {
+             if (!name.empty() && name[0] != '#') {
+                 names.push_back(name);
+             }
+         }
+         if (!navigator.closeLocations(names)) {
+             return 1;
+         }
+     }
+
+     // Optionally renumber the locations for locality; a snapshot keeps the order it was written in
+     if (!ordering.empty() && !navigator.reorderVertices(ordering)) {
+         return 1;
+     }
+
+     // Optionally save what was loaded for faster startup next time
+     if (!writeSnapshotFile.empty() && !navigator.saveSnapshot(writeSnapshotFile)) {
+         return 1;
+     }
      
+     // Answer the query file instead of prompting when one is given ("-" reads standard input)
+     if (batchFile == "-") {
+         return navigator.runBatch(cin, cout, numThreads) ? 0 : 1;
+     }
+     if (!batchFile.empty()) {
+         ifstream queries(batchFile);
+         if (!queries.is_open()) {
+             cerr << "Error: Could not open file " << batchFile << endl;
+             return 1;
+         }
+         return navigator.runBatch(queries, cout, numThreads) ? 0 : 1;
+     }
+
      // Run the navigator
      navigator.run();
      
@@ -0,0 +1,143 @@
+/* File: radixheap.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the RadixHeap class.
+ *
+ */
+
+ #include "radixheap.h"
+
+ // Constructors
+ RadixHeap::RadixHeap() : last(0), liveCount(0) {}
+
+ RadixHeap::RadixHeap(int capacity) : last(0), liveCount(0) {
+     reserve(capacity);
+ }
+
+ // Make room for vertex IDs below capacity without growing on insert
+ void RadixHeap::reserve(int capacity) {
+     if (capacity > (int)keys.size()) {
+         keys.resize(capacity, -1);
+     }
+ }
+
+ // Insert a node with a priority no smaller than the last extracted one
+ void RadixHeap::insert(VertexId node, int priority) {
+     if (priority < last) {
+         cout << "Error: Radix heap keys must not be smaller than the last extracted key" << endl;
+         return;
+     }
+     if (node >= keys.size()) {
+         keys.resize(node + 1, -1);
+     }
+     if (keys[node] < 0) {
+         liveCount++;
+     }
+
+     keys[node] = priority;
+     Entry entry;
+     entry.priority = priority;
+     entry.node = node;
+     buckets[bucketFor(priority)].push_back(entry);
+ }
+
+ // Extract the minimum node from the heap
+ VertexId RadixHeap::extractMin() {
+     if (isEmpty()) {
+         cout << "Error: Cannot extract from an empty heap" << endl;
+         return INVALID_VERTEX;
+     }
+
+     // Pop from bucket 0, skipping entries superseded by decreaseKey
+     while (true) {
+         if (buckets[0].empty()) {
+             refill();
+         }
+         Entry entry = buckets[0].back();
+         buckets[0].pop_back();
+         if (keys[entry.node] == entry.priority) {
+             keys[entry.node] = -1;
+             liveCount--;
+             return entry.node;
+         }
+     }
+ }
+
+ // Decrease the key of a node in the heap (the old entry is skipped lazily)
+ void RadixHeap::decreaseKey(VertexId node, int priority) {
+     // Check if the node exists in the heap
+     if (!contains(node)) {
+         cout << "Error: Node not found in the heap" << endl;
+         return;
+     }
+
+     // Only decrease if the new priority is smaller
+     if (priority < keys[node]) {
+         keys[node] = priority;
+         Entry entry;
+         entry.priority = priority;
+         entry.node = node;
+         buckets[bucketFor(priority)].push_back(entry);
+     }
+ }
+
+ // Check if the heap is empty
+ bool RadixHeap::isEmpty() const {
+     return liveCount == 0;
+ }
+
+ // Check if the heap contains a node
+ bool RadixHeap::contains(VertexId node) const {
+     return node < keys.size() && keys[node] >= 0;
+ }
+
+ // Remove every node and reset the monotone lower bound to 0
+ void RadixHeap::clear() {
+     for (int i = 0; i < NUM_BUCKETS; i++) {
+         for (size_t j = 0; j < buckets[i].size(); j++) {
+             keys[buckets[i][j].node] = -1;
+         }
+         buckets[i].clear();
+     }
+     last = 0;
+     liveCount = 0;
+ }
+
+ // Helper to pick the bucket for a key relative to last
+ int RadixHeap::bucketFor(int priority) const {
+     unsigned int diff = (unsigned int)priority ^ (unsigned int)last;
+     return (diff == 0) ? 0 : 32 - __builtin_clz(diff);
+ }
+
+ // Helper to refill bucket 0 from the first non-empty higher bucket
+ void RadixHeap::refill() {
+     for (int i = 1; i < NUM_BUCKETS; i++) {
+         vector<Entry>& bucket = buckets[i];
+         if (bucket.empty()) {
+             continue;
+         }
+
+         // The smallest live key in the bucket becomes the new lower bound
+         int newLast = -1;
+         for (size_t j = 0; j < bucket.size(); j++) {
+             if (keys[bucket[j].node] == bucket[j].priority &&
+                 (newLast < 0 || bucket[j].priority < newLast)) {
+                 newLast = bucket[j].priority;
+             }
+         }
+         if (newLast < 0) {
+             bucket.clear(); // Only stale entries
+             continue;
+         }
+
+         // Redistribute the live entries; each lands in a strictly lower bucket
+         last = newLast;
+         for (size_t j = 0; j < bucket.size(); j++) {
+             if (keys[bucket[j].node] == bucket[j].priority) {
+                 buckets[bucketFor(bucket[j].priority)].push_back(bucket[j]);
+             }
+         }
+         bucket.clear();
+         return;
+     }
+ }
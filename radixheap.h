@@ -0,0 +1,65 @@
+/* File: radixheap.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the RadixHeap class, a monotone priority queue for non-negative
+ *          integer keys. Keys are bucketed by the highest bit in which they differ from the last
+ *          extracted key, so each entry moves down at most 32 times.
+ *
+ */
+
+ #ifndef RADIXHEAP_H
+ #define RADIXHEAP_H
+ #include <iostream>
+ #include <vector>
+ #include "symboltable.h"
+
+ using namespace std;
+
+ class RadixHeap {
+     public:
+         // Constructors
+         RadixHeap();
+         RadixHeap(int capacity);
+
+         // Make room for vertex IDs below capacity without growing on insert
+         void reserve(int capacity);
+
+         // Insert a node with a priority no smaller than the last extracted one
+         void insert(VertexId node, int priority);
+
+         // Extract the minimum node from the heap
+         VertexId extractMin();
+
+         // Decrease the key of a node in the heap (the old entry is skipped lazily)
+         void decreaseKey(VertexId node, int priority);
+
+         // Check if the heap is empty
+         bool isEmpty() const;
+
+         // Check if the heap contains a node
+         bool contains(VertexId node) const;
+
+         // Remove every node and reset the monotone lower bound to 0
+         void clear();
+
+     private:
+         struct Entry {
+             int priority;
+             VertexId node;
+         };
+
+         static const int NUM_BUCKETS = 33; // Bucket 0 holds keys equal to last, bucket i differs at bit i-1
+
+         vector<Entry> buckets[NUM_BUCKETS];
+         vector<int> keys; // Current key of each node in the heap, or -1 if absent
+         int last;         // The last extracted key; every live key is at least this
+         int liveCount;    // Number of nodes in the heap (stale entries are not counted)
+
+         // Helper to pick the bucket for a key relative to last
+         int bucketFor(int priority) const;
+
+         // Helper to refill bucket 0 from the first non-empty higher bucket
+         void refill();
+ };
+
+ #endif // RADIXHEAP_H
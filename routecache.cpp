@@ -0,0 +1,144 @@
+/* File: routecache.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the RouteCache class.
+ *
+ */
+
+ #include "routecache.h"
+ #include <functional>
+
+ // Constructor
+ RouteCache::RouteCache(size_t capacity, int numShards) : shards(numShards > 0 ? numShards : 1) {
+     shardCapacity = (capacity + shards.size() - 1) / shards.size();
+     if (shardCapacity == 0) {
+         shardCapacity = 1;
+     }
+     for (size_t i = 0; i < shards.size(); i++) {
+         shards[i].hits = 0;
+         shards[i].misses = 0;
+         shards[i].evictions = 0;
+     }
+ }
+
+ // Helper to build the key of a query; names cannot contain the separator
+ string RouteCache::makeKey(const string& start, const string& end, Algorithm algorithm, Metric metric) {
+     string key = start;
+     key += '\0';
+     key += end;
+     key += '\0';
+     key += to_string((int)algorithm);
+     key += '\0';
+     key += to_string((int)metric);
+     return key;
+ }
+
+ // Helper to pick the shard a key lives in
+ RouteCache::Shard& RouteCache::shardOf(const string& key) {
+     return shards[hash<string>()(key) % shards.size()];
+ }
+
+ // Look up a route found at the given graph version
+ bool RouteCache::lookup(const string& start, const string& end, Algorithm algorithm, Metric metric,
+                         unsigned long long version, vector<string>& path, long long& weight) {
+     string key = makeKey(start, end, algorithm, metric);
+     Shard& shard = shardOf(key);
+     lock_guard<mutex> guard(shard.lock);
+
+     unordered_map<string, list<Entry>::iterator>::iterator it = shard.index.find(key);
+     if (it == shard.index.end()) {
+         shard.misses++;
+         return false;
+     }
+
+     // A route from another version of the graph may no longer exist or be shortest
+     list<Entry>::iterator entry = it->second;
+     if (entry->version != version) {
+         shard.entries.erase(entry);
+         shard.index.erase(it);
+         shard.misses++;
+         return false;
+     }
+
+     // Move the route to the front of the recency list
+     shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+     path = entry->path;
+     weight = entry->weight;
+     shard.hits++;
+     return true;
+ }
+
+ // Remember a route found at the given graph version
+ void RouteCache::insert(const string& start, const string& end, Algorithm algorithm, Metric metric,
+                         unsigned long long version, const vector<string>& path, long long weight) {
+     string key = makeKey(start, end, algorithm, metric);
+     Shard& shard = shardOf(key);
+     lock_guard<mutex> guard(shard.lock);
+
+     // Another thread may have found the same route meanwhile; keep the newer one
+     unordered_map<string, list<Entry>::iterator>::iterator it = shard.index.find(key);
+     if (it != shard.index.end()) {
+         shard.entries.erase(it->second);
+         shard.index.erase(it);
+     }
+     if (shard.entries.size() >= shardCapacity) {
+         shard.index.erase(shard.entries.back().key);
+         shard.entries.pop_back();
+         shard.evictions++;
+     }
+
+     Entry entry;
+     entry.key = key;
+     entry.version = version;
+     entry.path = path;
+     entry.weight = weight;
+     shard.entries.push_front(entry);
+     shard.index[key] = shard.entries.begin();
+ }
+
+ // Drop every route
+ void RouteCache::clear() {
+     for (size_t i = 0; i < shards.size(); i++) {
+         lock_guard<mutex> guard(shards[i].lock);
+         shards[i].entries.clear();
+         shards[i].index.clear();
+     }
+ }
+
+ // Get the number of routes held
+ size_t RouteCache::size() const {
+     size_t total = 0;
+     for (size_t i = 0; i < shards.size(); i++) {
+         lock_guard<mutex> guard(shards[i].lock);
+         total += shards[i].entries.size();
+     }
+     return total;
+ }
+
+ // Get the lookups served and missed, and the routes evicted so far
+ unsigned long long RouteCache::getHits() const {
+     unsigned long long total = 0;
+     for (size_t i = 0; i < shards.size(); i++) {
+         lock_guard<mutex> guard(shards[i].lock);
+         total += shards[i].hits;
+     }
+     return total;
+ }
+
+ unsigned long long RouteCache::getMisses() const {
+     unsigned long long total = 0;
+     for (size_t i = 0; i < shards.size(); i++) {
+         lock_guard<mutex> guard(shards[i].lock);
+         total += shards[i].misses;
+     }
+     return total;
+ }
+
+ unsigned long long RouteCache::getEvictions() const {
+     unsigned long long total = 0;
+     for (size_t i = 0; i < shards.size(); i++) {
+         lock_guard<mutex> guard(shards[i].lock);
+         total += shards[i].evictions;
+     }
+     return total;
+ }
@@ -0,0 +1,82 @@
+/* File: routecache.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the RouteCache class, a bounded least-recently-used cache of found
+ *          routes keyed by start, end, algorithm and metric. Entries are spread over shards by key hash, each
+ *          with its own lock, list and map, so threads answering queries rarely wait on each other.
+ *          Every entry records the graph version it was found at and is never served for another.
+ *
+ */
+
+ #ifndef ROUTECACHE_H
+ #define ROUTECACHE_H
+ #include <iostream>
+ #include <vector>
+ #include <string>
+ #include <list>
+ #include <unordered_map>
+ #include <mutex>
+ #include "pathfinder.h"
+
+ using namespace std;
+
+ // Default number of routes kept, and of shards they are spread over
+ const size_t ROUTE_CACHE_CAPACITY = 1 << 16;
+ const int ROUTE_CACHE_SHARDS = 16;
+
+ class RouteCache {
+     public:
+         // Constructor; capacity routes are kept in total, split evenly over numShards shards
+         RouteCache(size_t capacity, int numShards);
+
+         // Look up the route from start to end found with algorithm minimizing metric at the given graph
+         // version. An entry from another version counts as a miss and is dropped. An empty path means
+         // there was none
+         bool lookup(const string& start, const string& end, Algorithm algorithm, Metric metric,
+                     unsigned long long version, vector<string>& path, long long& weight);
+
+         // Remember a route found at the given graph version, evicting the least recently used
+         // route of its shard when the shard is full
+         void insert(const string& start, const string& end, Algorithm algorithm, Metric metric,
+                     unsigned long long version, const vector<string>& path, long long weight);
+
+         // Drop every route; the counters keep counting
+         void clear();
+
+         // Get the number of routes held, and the lookups served, missed, and routes evicted so far
+         size_t size() const;
+         unsigned long long getHits() const;
+         unsigned long long getMisses() const;
+         unsigned long long getEvictions() const;
+
+     private:
+         struct Entry {
+             string key;
+             unsigned long long version;
+             vector<string> path;
+             long long weight;
+         };
+
+         // One lock's worth of the cache; the list runs from most to least recently used
+         struct Shard {
+             mutable mutex lock;
+             list<Entry> entries;
+             unordered_map<string, list<Entry>::iterator> index;
+             unsigned long long hits;
+             unsigned long long misses;
+             unsigned long long evictions;
+         };
+
+         vector<Shard> shards;
+         size_t shardCapacity;
+
+         // Helper to build the key of a query and pick its shard
+         static string makeKey(const string& start, const string& end, Algorithm algorithm, Metric metric);
+         Shard& shardOf(const string& key);
+
+         // Shards hold locks, so caches are not copied
+         RouteCache(const RouteCache& other);
+         RouteCache& operator=(const RouteCache& other);
+ };
+
+ #endif // ROUTECACHE_H
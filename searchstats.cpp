@@ -0,0 +1,89 @@
+/* File: searchstats.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the SearchStats record and the stats policies.
+ *
+ */
+
+ #include "searchstats.h"
+
+ // Names of the phases, in SearchPhase order
+ static const char* const PHASE_NAMES[NUM_PHASES] = { "setup", "search", "path" };
+
+ // Constructor; starts at zero
+ SearchStats::SearchStats() {
+     clear();
+ }
+
+ // Set every count and time back to zero
+ void SearchStats::clear() {
+     settled = 0;
+     relaxed = 0;
+     pushes = 0;
+     decreaseKeys = 0;
+     pops = 0;
+     peakQueueSize = 0;
+     for (int i = 0; i < NUM_PHASES; i++) {
+         phaseSeconds[i] = 0.0;
+     }
+ }
+
+ // Add another record's counts and times; the peak becomes the larger of the two
+ void SearchStats::add(const SearchStats& other) {
+     settled += other.settled;
+     relaxed += other.relaxed;
+     pushes += other.pushes;
+     decreaseKeys += other.decreaseKeys;
+     pops += other.pops;
+     if (other.peakQueueSize > peakQueueSize) {
+         peakQueueSize = other.peakQueueSize;
+     }
+     for (int i = 0; i < NUM_PHASES; i++) {
+         phaseSeconds[i] += other.phaseSeconds[i];
+     }
+ }
+
+ // Print one line per statistic, each starting with indent
+ void SearchStats::print(ostream& out, const string& indent) const {
+     out << indent << "Vertices settled: " << settled << endl;
+     out << indent << "Edges relaxed: " << relaxed << endl;
+     out << indent << "Queue pushes/decreaseKeys/pops: " << pushes << "/" << decreaseKeys << "/" << pops << endl;
+     out << indent << "Peak queue size: " << peakQueueSize << endl;
+     out << indent << "Time (ms):";
+     for (int i = 0; i < NUM_PHASES; i++) {
+         out << " " << PHASE_NAMES[i] << " " << phaseSeconds[i] * 1000.0;
+     }
+     out << endl;
+ }
+
+ // Constructor
+ CountingStats::CountingStats() : queued(0), phaseStart(chrono::steady_clock::now()) {}
+
+ // Start a new record
+ void CountingStats::clear() {
+     stats.clear();
+     queued = 0;
+ }
+
+ // Start timing
+ void CountingStats::startPhase() {
+     phaseStart = chrono::steady_clock::now();
+ }
+
+ // Charge the time since the last call to a phase
+ void CountingStats::endPhase(SearchPhase phase) {
+     chrono::steady_clock::time_point now = chrono::steady_clock::now();
+     stats.phaseSeconds[phase] += chrono::duration<double>(now - phaseStart).count();
+     phaseStart = now;
+ }
+
+ // Get the record
+ const SearchStats& CountingStats::get() const {
+     return stats;
+ }
+
+ // Get an all-zero record
+ const SearchStats& NoStats::get() const {
+     static const SearchStats none;
+     return none;
+ }
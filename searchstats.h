@@ -0,0 +1,132 @@
+/* File: searchstats.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the SearchStats record of what one query did, and the two stats
+ *          policies the search loops report to. CountingStats fills in a record; NoStats has only
+ *          empty inline members that compile to nothing. StatsPolicy names CountingStats when the
+ *          build defines PATHFINDER_STATS and NoStats otherwise, so release builds pay nothing.
+ *
+ */
+
+ #ifndef SEARCHSTATS_H
+ #define SEARCHSTATS_H
+ #include <iostream>
+ #include <string>
+ #include <chrono>
+
+ using namespace std;
+
+ // Parts of a query that are timed separately
+ enum SearchPhase {
+     PHASE_SETUP,  // Name lookup, workspace reset and any preprocessing built on demand
+     PHASE_SEARCH, // The search loop itself
+     PHASE_PATH,   // Walking the predecessors back into a list of names
+     NUM_PHASES
+ };
+
+ // What one query did; the two sides of a bidirectional search are added together
+ struct SearchStats {
+     long long settled;
+     long long relaxed;       // Arcs scanned out of settled vertices
+     long long pushes;
+     long long decreaseKeys;
+     long long pops;
+     long long peakQueueSize; // Most vertices queued at once on one side
+     double phaseSeconds[NUM_PHASES];
+
+     // Constructor; starts at zero
+     SearchStats();
+
+     // Set every count and time back to zero
+     void clear();
+
+     // Add another record's counts and times; the peak becomes the larger of the two
+     void add(const SearchStats& other);
+
+     // Print one line per statistic, each starting with indent
+     void print(ostream& out, const string& indent) const;
+ };
+
+ // Stats policy that counts; the queue size is tracked from pushes and pops, so every queue works
+ class CountingStats {
+     public:
+         static const bool ENABLED = true;
+
+         // Constructor
+         CountingStats();
+
+         // Start a new record
+         void clear();
+
+         // Record one settled vertex, scanned arc, queue operation
+         void settle();
+         void relax();
+         void push();
+         void decreaseKey();
+         void pop();
+
+         // Start timing, and charge the time since the last call to a phase
+         void startPhase();
+         void endPhase(SearchPhase phase);
+
+         // Get the record
+         const SearchStats& get() const;
+
+     private:
+         SearchStats stats;
+         long long queued;
+         chrono::steady_clock::time_point phaseStart;
+ };
+
+ // Stats policy that records nothing; every member is empty, so calls compile away
+ class NoStats {
+     public:
+         static const bool ENABLED = false;
+
+         void clear() {}
+         void settle() {}
+         void relax() {}
+         void push() {}
+         void decreaseKey() {}
+         void pop() {}
+         void startPhase() {}
+         void endPhase(SearchPhase phase) {}
+
+         // Get an all-zero record
+         const SearchStats& get() const;
+ };
+
+ // Build with -DPATHFINDER_STATS (make STATS=1) to collect statistics
+ #ifdef PATHFINDER_STATS
+ typedef CountingStats StatsPolicy;
+ #else
+ typedef NoStats StatsPolicy;
+ #endif
+
+ // Inline accessors used in the search inner loops
+ inline void CountingStats::settle() {
+     stats.settled++;
+ }
+
+ inline void CountingStats::relax() {
+     stats.relaxed++;
+ }
+
+ inline void CountingStats::push() {
+     stats.pushes++;
+     queued++;
+     if (queued > stats.peakQueueSize) {
+         stats.peakQueueSize = queued;
+     }
+ }
+
+ inline void CountingStats::decreaseKey() {
+     stats.decreaseKeys++;
+ }
+
+ inline void CountingStats::pop() {
+     stats.pops++;
+     queued--;
+ }
+
+ #endif // SEARCHSTATS_H
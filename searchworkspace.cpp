@@ -0,0 +1,108 @@
+/* File: searchworkspace.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the SearchWorkspace class.
+ *
+ */
+
+ #include "searchworkspace.h"
+
+ // Constructor and destructor
+ SearchWorkspace::SearchWorkspace() : generation(0), publishedSize(0), bucketQueue(nullptr), bucketMaxWeight(-1) {}
+
+ SearchWorkspace::~SearchWorkspace() {
+     delete bucketQueue;
+ }
+
+ // Start a new search over vertex IDs below numVertices; the arrays only grow when the graph did
+ void SearchWorkspace::reset(int numVertices) {
+     if (numVertices > (int)labels.size()) {
+         Label unset = {0, 0, INT_MAX, INVALID_VERTEX};
+         labels.resize(numVertices, unset);
+         heap.reserve(numVertices);
+         radixHeap.reserve(numVertices);
+         if (bucketQueue) {
+             bucketQueue->reserve(numVertices);
+         }
+     }
+
+     // When the counter wraps, stamps from 2^32 searches ago would look current, so clear them once
+     generation++;
+     if (generation == 0) {
+         for (size_t i = 0; i < labels.size(); i++) {
+             labels[i].labeled = 0;
+             labels[i].settled = 0;
+         }
+         for (size_t i = 0; i < publishedSize; i++) {
+             published[i].store(0);
+         }
+         generation = 1;
+     }
+ }
+
+ // Make room to publish distances of vertex IDs below numVertices
+ void SearchWorkspace::reservePublished(int numVertices) {
+     if ((size_t)numVertices <= publishedSize) {
+         return;
+     }
+
+     // Generation 0 is never current, so zeroed entries read as unpublished
+     published.reset(new atomic<uint64_t>[numVertices]);
+     for (int i = 0; i < numVertices; i++) {
+         published[i].store(0, memory_order_relaxed);
+     }
+     publishedSize = numVertices;
+ }
+
+ // Count the vertices the current search has settled, or labeled
+ int SearchWorkspace::countSettled() const {
+     int count = 0;
+     for (size_t i = 0; i < labels.size(); i++) {
+         if (labels[i].settled == generation) {
+             count++;
+         }
+     }
+     return count;
+ }
+
+ int SearchWorkspace::countLabeled() const {
+     int count = 0;
+     for (size_t i = 0; i < labels.size(); i++) {
+         if (labels[i].labeled == generation) {
+             count++;
+         }
+     }
+     return count;
+ }
+
+ // Get the priority queues and vertex lists, emptied; their storage is reused between searches
+ DijkstraHeap& SearchWorkspace::getHeap() {
+     heap.clear();
+     return heap;
+ }
+
+ RadixHeap& SearchWorkspace::getRadixHeap() {
+     radixHeap.clear();
+     return radixHeap;
+ }
+
+ BucketQueue& SearchWorkspace::getBucketQueue(int maxWeight) {
+     if (!bucketQueue || bucketMaxWeight != maxWeight) {
+         delete bucketQueue;
+         bucketQueue = new BucketQueue(maxWeight, labels.size());
+         bucketMaxWeight = maxWeight;
+     } else {
+         bucketQueue->clear();
+     }
+     return *bucketQueue;
+ }
+
+ vector<VertexId>& SearchWorkspace::getFrontier() {
+     frontier.clear();
+     return frontier;
+ }
+
+ vector<VertexId>& SearchWorkspace::getNextFrontier() {
+     nextFrontier.clear();
+     return nextFrontier;
+ }
@@ -0,0 +1,142 @@
+/* File: searchworkspace.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the SearchWorkspace class, the per-vertex labels and queues that one
+ *          side of a search works in. The arrays are allocated once and kept between queries; every
+ *          label carries the generation of the search that wrote it, so starting a new search just
+ *          bumps the generation and old labels read as unset. Setup costs O(1) instead of O(|V|).
+ *
+ */
+
+ #ifndef SEARCHWORKSPACE_H
+ #define SEARCHWORKSPACE_H
+ #include <iostream>
+ #include <vector>
+ #include <climits>
+ #include <cstdint>
+ #include <atomic>
+ #include <memory>
+ #include "symboltable.h"
+ #include "daryheap.h"
+ #include "radixheap.h"
+ #include "bucketqueue.h"
+ #include "searchstats.h"
+
+ using namespace std;
+
+ // Priority queue used by Dijkstra's algorithm; a 4-ary heap is half as deep as a binary
+ // heap and a node's children sit next to each other in memory
+ typedef DaryHeap<4> DijkstraHeap;
+
+ class SearchWorkspace {
+     public:
+         // Constructor and destructor
+         SearchWorkspace();
+         ~SearchWorkspace();
+
+         // Start a new search over vertex IDs below numVertices; the arrays only grow when the graph did
+         void reset(int numVertices);
+
+         // Get a vertex's distance (INT_MAX if this search has not labeled it) and predecessor
+         int getDistance(VertexId v) const;
+         VertexId getPredecessor(VertexId v) const;
+
+         // Label a vertex with its distance so far and the vertex it was reached from
+         void setLabel(VertexId v, int distance, VertexId predecessor);
+
+         // Check whether a vertex has been settled (scanned for good) in this search, and settle it
+         bool isSettled(VertexId v) const;
+         void settle(VertexId v);
+
+         // Make room to publish distances of vertex IDs below numVertices; only searches that share
+         // their labels with another thread need this, so it is not part of reset
+         void reservePublished(int numVertices);
+
+         // Publish a vertex's distance to a search on another thread, and read what this search has
+         // published (INT_MAX if nothing yet). Stamped with the generation, so no reset is needed
+         void publishDistance(VertexId v, int distance);
+         int getPublishedDistance(VertexId v) const;
+
+         // Count the vertices the current search has settled, or labeled; these scan every label
+         int countSettled() const;
+         int countLabeled() const;
+
+         // Get the priority queues and vertex lists, emptied; their storage is reused between searches
+         DijkstraHeap& getHeap();
+         RadixHeap& getRadixHeap();
+         BucketQueue& getBucketQueue(int maxWeight);
+         vector<VertexId>& getFrontier();
+         vector<VertexId>& getNextFrontier();
+
+         // Get the statistics of the search running in this workspace (empty unless built with PATHFINDER_STATS)
+         StatsPolicy& getStats();
+         const StatsPolicy& getStats() const;
+
+     private:
+         // Everything a search reads about a vertex is kept together, so a relaxation touches one cache line
+         struct Label {
+             uint32_t labeled;  // Generation that last set distance and predecessor
+             uint32_t settled;  // Generation that last settled the vertex
+             int distance;
+             VertexId predecessor;
+         };
+
+         vector<Label> labels;
+         uint32_t generation; // Generation of the current search; never 0 once a search has started
+         unique_ptr<atomic<uint64_t>[]> published; // Generation in the high half, distance in the low half
+         size_t publishedSize;
+
+         DijkstraHeap heap;
+         RadixHeap radixHeap;
+         BucketQueue* bucketQueue; // Built on first use, and again when the maximum weight changes
+         int bucketMaxWeight;
+         vector<VertexId> frontier;
+         vector<VertexId> nextFrontier;
+         StatsPolicy stats;
+
+         // The bucket queue and published labels are owned, so workspaces are not copied
+         SearchWorkspace(const SearchWorkspace& other);
+         SearchWorkspace& operator=(const SearchWorkspace& other);
+ };
+
+ // Inline accessors used in the search inner loops
+ inline int SearchWorkspace::getDistance(VertexId v) const {
+     return labels[v].labeled == generation ? labels[v].distance : INT_MAX;
+ }
+
+ inline VertexId SearchWorkspace::getPredecessor(VertexId v) const {
+     return labels[v].labeled == generation ? labels[v].predecessor : INVALID_VERTEX;
+ }
+
+ inline void SearchWorkspace::setLabel(VertexId v, int distance, VertexId predecessor) {
+     labels[v].labeled = generation;
+     labels[v].distance = distance;
+     labels[v].predecessor = predecessor;
+ }
+
+ inline void SearchWorkspace::publishDistance(VertexId v, int distance) {
+     published[v].store(((uint64_t)generation << 32) | (uint32_t)distance);
+ }
+
+ inline int SearchWorkspace::getPublishedDistance(VertexId v) const {
+     uint64_t stamped = published[v].load();
+     return (uint32_t)(stamped >> 32) == generation ? (int)(uint32_t)stamped : INT_MAX;
+ }
+
+ inline bool SearchWorkspace::isSettled(VertexId v) const {
+     return labels[v].settled == generation;
+ }
+
+ inline void SearchWorkspace::settle(VertexId v) {
+     labels[v].settled = generation;
+ }
+
+ inline StatsPolicy& SearchWorkspace::getStats() {
+     return stats;
+ }
+
+ inline const StatsPolicy& SearchWorkspace::getStats() const {
+     return stats;
+ }
+
+ #endif // SEARCHWORKSPACE_H
@@ -0,0 +1,159 @@
+/* File: snapshot.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the Snapshot and SnapshotWriter classes.
+ *
+ */
+
+ #include "snapshot.h"
+ #include <fstream>
+ #include <cstring>
+
+ static const char SNAPSHOT_MAGIC[8] = {'M', 'E', 'N', 'A', 'V', 'S', 'N', 'P'};
+ static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+ // Helper to round a file offset up to the section alignment
+ static uint64_t alignOffset(uint64_t offset) {
+     return (offset + 7) & ~(uint64_t)7;
+ }
+
+ // Constructor
+ SnapshotWriter::SnapshotWriter() : version(SNAPSHOT_MIN_VERSION) {}
+
+ // Raise the version written to at least newVersion
+ void SnapshotWriter::requireVersion(uint32_t newVersion) {
+     if (newVersion > version) {
+         version = newVersion;
+     }
+ }
+
+ // Add a section; the bytes are not copied and must stay alive until write()
+ void SnapshotWriter::addSection(SnapshotSection type, const void* data, size_t size) {
+     PendingSection section = {type, data, size};
+     sections.push_back(section);
+ }
+
+ // Add a section whose bytes the writer owns, returning the buffer for the caller to fill
+ char* SnapshotWriter::allocateSection(SnapshotSection type, size_t size) {
+     ownedData.push_back(vector<char>(size));
+     addSection(type, ownedData.back().data(), size);
+     return ownedData.back().data();
+ }
+
+ // Write the header, directory and sections
+ bool SnapshotWriter::write(const string& filename) const {
+     ofstream file(filename, ios::binary | ios::trunc);
+     if (!file.is_open()) {
+         cerr << "Error: Could not open file " << filename << endl;
+         return false;
+     }
+
+     SnapshotHeader header;
+     memset(&header, 0, sizeof(header));
+     memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+     header.version = version;
+     header.byteOrder = SNAPSHOT_BYTE_ORDER;
+     header.numSections = sections.size();
+
+     // Lay the sections out after the directory, each on an 8-byte boundary
+     vector<SnapshotSectionEntry> directory(sections.size());
+     uint64_t offset = alignOffset(sizeof(SnapshotHeader) + sections.size() * sizeof(SnapshotSectionEntry));
+     for (size_t i = 0; i < sections.size(); i++) {
+         directory[i].type = sections[i].type;
+         directory[i].reserved = 0;
+         directory[i].offset = offset;
+         directory[i].size = sections[i].size;
+         offset = alignOffset(offset + sections[i].size);
+     }
+
+     file.write((const char*)&header, sizeof(header));
+     file.write((const char*)directory.data(), directory.size() * sizeof(SnapshotSectionEntry));
+     uint64_t written = sizeof(header) + directory.size() * sizeof(SnapshotSectionEntry);
+     static const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+     for (size_t i = 0; i < sections.size(); i++) {
+         file.write(padding, directory[i].offset - written);
+         file.write((const char*)sections[i].data, sections[i].size);
+         written = directory[i].offset + sections[i].size;
+     }
+
+     if (!file) {
+         cerr << "Error: Could not write snapshot to " << filename << endl;
+         return false;
+     }
+     return true;
+ }
+
+ // Constructor
+ Snapshot::Snapshot() : directory(nullptr), numSections(0), version(0) {}
+
+ // Map a snapshot file and check its header and directory
+ bool Snapshot::open(const string& filename) {
+     close();
+     if (!file.open(filename)) {
+         return false;
+     }
+     const char* data = file.getData();
+     size_t size = file.getSize();
+
+     const SnapshotHeader* header = (const SnapshotHeader*)data;
+     if (size < sizeof(SnapshotHeader) || memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0) {
+         cerr << "Error: " << filename << " is not a snapshot" << endl;
+         close();
+         return false;
+     }
+     if (header->byteOrder != SNAPSHOT_BYTE_ORDER || header->version < SNAPSHOT_MIN_VERSION ||
+         header->version > SNAPSHOT_VERSION) {
+         cerr << "Error: " << filename << " was written by an incompatible version (" << header->version << ")" << endl;
+         close();
+         return false;
+     }
+
+     // Every section has to lie inside the file
+     version = header->version;
+     numSections = header->numSections;
+     directory = (const SnapshotSectionEntry*)(data + sizeof(SnapshotHeader));
+     if (sizeof(SnapshotHeader) + (uint64_t)numSections * sizeof(SnapshotSectionEntry) > size) {
+         cerr << "Error: Snapshot " << filename << " is truncated" << endl;
+         close();
+         return false;
+     }
+     for (uint32_t i = 0; i < numSections; i++) {
+         if (directory[i].offset % 8 != 0 || directory[i].offset > size || directory[i].size > size - directory[i].offset) {
+             cerr << "Error: Snapshot " << filename << " is truncated" << endl;
+             close();
+             return false;
+         }
+     }
+     return true;
+ }
+
+ // Get a section's bytes and size, or nullptr if the snapshot does not have it
+ const void* Snapshot::getSection(SnapshotSection type, size_t& sectionSize) const {
+     for (uint32_t i = 0; i < numSections; i++) {
+         if (directory[i].type == (uint32_t)type) {
+             sectionSize = directory[i].size;
+             return file.getData() + directory[i].offset;
+         }
+     }
+     sectionSize = 0;
+     return nullptr;
+ }
+
+ // Check if the snapshot has a section
+ bool Snapshot::hasSection(SnapshotSection type) const {
+     size_t sectionSize;
+     return getSection(type, sectionSize) != nullptr;
+ }
+
+ // Get the version the file was written as
+ uint32_t Snapshot::getVersion() const {
+     return version;
+ }
+
+ // Helper to unmap the file
+ void Snapshot::close() {
+     file.close();
+     directory = nullptr;
+     numSections = 0;
+     version = 0;
+ }
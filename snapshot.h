@@ -0,0 +1,138 @@
+/* File: snapshot.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the Snapshot and SnapshotWriter classes. A snapshot is a versioned
+ *          binary file made of a header, a directory of sections and the raw section bytes (CSR
+ *          arrays, the string table, optional preprocessing). Reading memory-maps the file
+ *          read-only and hands out pointers into the mapping, so nothing is parsed and processes
+ *          that open the same snapshot share its pages through the page cache.
+ *
+ */
+
+ #ifndef SNAPSHOT_H
+ #define SNAPSHOT_H
+ #include <iostream>
+ #include <vector>
+ #include <string>
+ #include <deque>
+ #include <cstdint>
+ #include "mappedfile.h"
+
+ using namespace std;
+
+ // Bumped whenever the layout of a section changes. A file is written with the lowest version that
+ // describes it, so readers from before a change still open the files it does not affect; files newer
+ // than the reader, or older than the oldest layout it knows, are rejected
+ const uint32_t SNAPSHOT_VERSION = 2;
+ const uint32_t SNAPSHOT_MIN_VERSION = 1;
+
+ // Version that added one-way edges: the directed flag of the graph info (reserved before) and the
+ // two-way and reverse sections. Older readers would take a directed graph for an undirected one
+ const uint32_t SNAPSHOT_VERSION_ONE_WAY = 2;
+
+ // Section types; a reader ignores sections it does not know
+ enum SnapshotSection {
+     SECTION_GRAPH_INFO = 1,  // CompactGraph scalars (counts, weight range, heuristic scales)
+     SECTION_OFFSETS,         // CSR row offsets, numVertices + 1 EdgeIds
+     SECTION_TARGETS,         // CSR arc targets
+     SECTION_WEIGHTS,         // CSR arc lengths
+     SECTION_LIVE,            // One byte per vertex ID, 0 for removed nodes
+     SECTION_X_COORDS,        // Optional vertex coordinates
+     SECTION_Y_COORDS,
+     SECTION_NAME_OFFSETS,    // numVertices + 1 byte offsets into the name data
+     SECTION_NAME_DATA,       // All vertex names back to back, without terminators
+     SECTION_NAME_ORDER,      // Vertex IDs sorted by name, for lookup by binary search
+     SECTION_LANDMARKS,       // Optional ALT landmark vertices
+     SECTION_LANDMARK_DISTANCES,
+     SECTION_CH_RANK,         // Optional contraction hierarchy
+     SECTION_CH_OFFSETS,
+     SECTION_CH_ARCS,
+     SECTION_METRIC_INFO,     // Weight range and heuristic scales of every metric; absent in length-only files
+     SECTION_METRIC_WEIGHTS,  // CSR arc weights of the metrics after length, one array after another
+     SECTION_CLASSES,         // One edge class byte per arc
+     SECTION_TWO_WAY,         // One byte per arc, 0 for one-way edges; only in directed graphs
+     SECTION_REVERSE_OFFSETS, // In-arc CSR of a directed graph, laid out like the forward one
+     SECTION_REVERSE_TARGETS,
+     SECTION_REVERSE_WEIGHTS, // Every metric, lengths first
+     SECTION_REVERSE_CLASSES,
+     SECTION_REVERSE_TWO_WAY,
+     SECTION_LANDMARK_METRIC, // Metric the landmark distances were computed for; length if absent
+     SECTION_CH_METRIC        // Metric the hierarchy was contracted for; length if absent
+ };
+
+ // Fixed-size file header
+ struct SnapshotHeader {
+     char magic[8];        // "MENAVSNP"
+     uint32_t version;     // Lowest version whose layout describes the file (see SNAPSHOT_VERSION)
+     uint32_t byteOrder;   // 0x01020304 as stored by the writer; rejects files from other byte orders
+     uint32_t numSections; // Entries in the directory that follows the header
+     uint32_t reserved;
+ };
+
+ // Directory entry locating one section in the file
+ struct SnapshotSectionEntry {
+     uint32_t type;
+     uint32_t reserved;
+     uint64_t offset; // From the start of the file, a multiple of 8 so any array type is aligned
+     uint64_t size;   // In bytes
+ };
+
+ // Collects sections and writes them to a snapshot file
+ class SnapshotWriter {
+     public:
+         // Constructor; the file is written as SNAPSHOT_MIN_VERSION unless a section needs a later one
+         SnapshotWriter();
+
+         // Raise the version written to at least version, for sections older readers would misread
+         void requireVersion(uint32_t version);
+
+         // Add a section; the bytes are not copied and must stay alive until write()
+         void addSection(SnapshotSection type, const void* data, size_t size);
+
+         // Add a section whose bytes the writer owns, returning the buffer for the caller to fill
+         char* allocateSection(SnapshotSection type, size_t size);
+
+         // Write the header, directory and sections
+         bool write(const string& filename) const;
+
+     private:
+         struct PendingSection {
+             SnapshotSection type;
+             const void* data;
+             size_t size;
+         };
+
+         uint32_t version; // Version the header will carry
+         vector<PendingSection> sections;
+         deque<vector<char> > ownedData; // Buffers handed out by allocateSection; a deque never moves them
+ };
+
+ // A snapshot file mapped read-only into memory
+ class Snapshot {
+     public:
+         // Constructor
+         Snapshot();
+
+         // Map a snapshot file and check its header and directory
+         bool open(const string& filename);
+
+         // Get a section's bytes and size, or nullptr if the snapshot does not have it
+         const void* getSection(SnapshotSection type, size_t& size) const;
+
+         // Check if the snapshot has a section
+         bool hasSection(SnapshotSection type) const;
+
+         // Get the version the file was written as
+         uint32_t getVersion() const;
+
+     private:
+         MappedFile file; // The whole snapshot, mapped read-only
+         const SnapshotSectionEntry* directory;
+         uint32_t numSections;
+         uint32_t version;
+
+         // Helper to unmap the file
+         void close();
+ };
+
+ #endif // SNAPSHOT_H
@@ -0,0 +1,25 @@
+/* File: spinbarrier.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the SpinBarrier class.
+ *
+ */
+
+ #include "spinbarrier.h"
+ #include <thread>
+
+ // Constructor
+ SpinBarrier::SpinBarrier(int threads) : count(threads), waiting(0), phase(0) {}
+
+ // Wait until all count threads have called wait; the barrier can be used again right away
+ void SpinBarrier::wait() {
+     int current = phase.load();
+     if (waiting.fetch_add(1) + 1 == count) {
+         waiting.store(0);
+         phase.fetch_add(1);
+         return;
+     }
+     while (phase.load() == current) {
+         this_thread::yield();
+     }
+ }
@@ -0,0 +1,30 @@
+/* File: spinbarrier.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the SpinBarrier class, which holds a fixed group of threads until
+ *          all of them have arrived. The level- and bucket-synchronous searches cross one per step,
+ *          so waiting threads spin (yielding the core) instead of sleeping on a condition variable.
+ *
+ */
+
+ #ifndef SPINBARRIER_H
+ #define SPINBARRIER_H
+ #include <atomic>
+
+ using namespace std;
+
+ class SpinBarrier {
+     public:
+         // Constructor
+         SpinBarrier(int count);
+
+         // Wait until all count threads have called wait; the barrier can be used again right away
+         void wait();
+
+     private:
+         int count;
+         atomic<int> waiting; // Threads that have arrived in the current phase
+         atomic<int> phase;   // Bumped by the last thread to arrive, which releases the others
+ };
+
+ #endif // SPINBARRIER_H
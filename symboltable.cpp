@@ -0,0 +1,62 @@
+/* File: symboltable.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the SymbolTable class.
+ *
+ */
+
+ #include "symboltable.h"
+
+ // Constructor
+ SymbolTable::SymbolTable() {}
+
+ // Copying rebuilds the index so its views point into the new copy's names
+ SymbolTable::SymbolTable(const SymbolTable& other) : names(other.names) {
+     rebuildIndex();
+ }
+
+ SymbolTable& SymbolTable::operator=(const SymbolTable& other) {
+     if (this != &other) {
+         names = other.names;
+         rebuildIndex();
+     }
+     return *this;
+ }
+
+ // Get the ID of a name, assigning the next free ID if it is new
+ VertexId SymbolTable::intern(const string& name) {
+     unordered_map<string_view, VertexId>::const_iterator it = index.find(name);
+     if (it != index.end()) {
+         return it->second;
+     }
+
+     VertexId id = names.size();
+     names.push_back(name);
+     index[string_view(names.back())] = id;
+     return id;
+ }
+
+ // Look up the ID of a name without adding it (INVALID_VERTEX if unknown)
+ VertexId SymbolTable::lookup(string_view name) const {
+     unordered_map<string_view, VertexId>::const_iterator it = index.find(name);
+     return (it != index.end()) ? it->second : INVALID_VERTEX;
+ }
+
+ // Get the name for an ID
+ const string& SymbolTable::getName(VertexId id) const {
+     return names[id];
+ }
+
+ // Get the number of interned names (one past the largest ID)
+ int SymbolTable::size() const {
+     return names.size();
+ }
+
+ // Helper to rebuild the index from names
+ void SymbolTable::rebuildIndex() {
+     index.clear();
+     index.reserve(names.size());
+     for (size_t i = 0; i < names.size(); i++) {
+         index[string_view(names[i])] = i;
+     }
+ }
@@ -0,0 +1,56 @@
+/* File: symboltable.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the SymbolTable class, which interns location names and maps
+ *          each one to a dense 32-bit vertex ID at load time.
+ *
+ */
+
+ #ifndef SYMBOLTABLE_H
+ #define SYMBOLTABLE_H
+ #include <string>
+ #include <string_view>
+ #include <deque>
+ #include <unordered_map>
+ #include <limits>
+ #include <cstdint>
+
+ using namespace std;
+
+ // Dense vertex and edge identifiers shared by Graph, CompactGraph and PathFinder
+ typedef uint32_t VertexId;
+ typedef uint32_t EdgeId;
+
+ // Sentinel for "no vertex" (unknown name, missing predecessor)
+ const VertexId INVALID_VERTEX = numeric_limits<VertexId>::max();
+
+ class SymbolTable {
+     public:
+         // Constructor
+         SymbolTable();
+
+         // Copying rebuilds the index so its views point into the new copy's names
+         SymbolTable(const SymbolTable& other);
+         SymbolTable& operator=(const SymbolTable& other);
+
+         // Get the ID of a name, assigning the next free ID if it is new
+         VertexId intern(const string& name);
+
+         // Look up the ID of a name without adding it (INVALID_VERTEX if unknown)
+         VertexId lookup(string_view name) const;
+
+         // Get the name for an ID
+         const string& getName(VertexId id) const;
+
+         // Get the number of interned names (one past the largest ID)
+         int size() const;
+
+     private:
+         // Helper to rebuild the index from names
+         void rebuildIndex();
+
+         deque<string> names; // Each name is stored exactly once; a deque never moves its elements
+         unordered_map<string_view, VertexId> index; // Views into names, so keys are not copied
+ };
+
+ #endif // SYMBOLTABLE_H
@@ -0,0 +1,120 @@
+/* File: versionmanager.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the VersionManager class.
+ *
+ */
+
+ #include "versionmanager.h"
+ #include <climits>
+ #include <thread>
+
+ // Epoch announced by a reader slot that holds no version; higher than any real epoch
+ const unsigned long long IDLE_EPOCH = ULLONG_MAX;
+
+ // Constructor
+ VersionManager::VersionManager(int maxReaders)
+     : numSlots(maxReaders > 0 ? maxReaders : 1), globalEpoch(1), published(nullptr) {
+     slots = new ReaderSlot[numSlots];
+     for (int i = 0; i < numSlots; i++) {
+         slots[i].epoch.store(IDLE_EPOCH);
+         slots[i].used.store(false);
+     }
+ }
+
+ // Destructor; frees every version, so no reader may still be registered
+ VersionManager::~VersionManager() {
+     delete published.load();
+     for (size_t i = 0; i < retired.size(); i++) {
+         delete retired[i].version;
+     }
+     delete[] slots;
+ }
+
+ // Claim a reader slot for the calling thread (-1 if all are taken)
+ int VersionManager::registerReader() {
+     for (int i = 0; i < numSlots; i++) {
+         bool expected = false;
+         if (slots[i].used.compare_exchange_strong(expected, true)) {
+             slots[i].epoch.store(IDLE_EPOCH);
+             return i;
+         }
+     }
+     cerr << "Error: All " << numSlots << " reader slots are taken" << endl;
+     return -1;
+ }
+
+ // Give a reader slot back
+ void VersionManager::unregisterReader(int slot) {
+     slots[slot].epoch.store(IDLE_EPOCH);
+     slots[slot].used.store(false);
+ }
+
+ // Get the current version for the reader in slot and keep it alive until unpin. The epoch is announced
+ // before the pointer is read: a writer that retires a version after this reader announced sees the
+ // announcement and keeps the version, and one whose scan came first has already swapped the pointer,
+ // so the load below cannot return what it frees
+ const GraphVersion* VersionManager::pin(int slot) {
+     slots[slot].epoch.store(globalEpoch.load());
+     return published.load();
+ }
+
+ // Let the writer free what this reader pinned
+ void VersionManager::unpin(int slot) {
+     slots[slot].epoch.store(IDLE_EPOCH);
+ }
+
+ // Make version the one new pins see, taking ownership of it
+ void VersionManager::publish(GraphVersion* version) {
+     GraphVersion* old = published.exchange(version);
+
+     // Readers that announce the new epoch read the pointer after the swap, so only readers announcing
+     // an older one can hold the old version
+     unsigned long long epoch = globalEpoch.fetch_add(1) + 1;
+     if (old) {
+         Retired entry;
+         entry.version = old;
+         entry.epoch = epoch;
+         retired.push_back(entry);
+     }
+     reclaim();
+ }
+
+ // Get the version new pins see
+ const GraphVersion* VersionManager::current() const {
+     return published.load();
+ }
+
+ // Free the retired versions no reader can still hold, and get how many are left waiting
+ size_t VersionManager::reclaim() {
+     unsigned long long oldest = oldestPinned();
+     size_t kept = 0;
+     for (size_t i = 0; i < retired.size(); i++) {
+         if (retired[i].epoch <= oldest) {
+             delete retired[i].version;
+         } else {
+             retired[kept++] = retired[i];
+         }
+     }
+     retired.resize(kept);
+     return kept;
+ }
+
+ // Wait until every retired version is freed
+ void VersionManager::synchronize() {
+     while (reclaim() > 0) {
+         this_thread::yield();
+     }
+ }
+
+ // Helper to get the oldest epoch any reader has announced
+ unsigned long long VersionManager::oldestPinned() const {
+     unsigned long long oldest = IDLE_EPOCH;
+     for (int i = 0; i < numSlots; i++) {
+         unsigned long long epoch = slots[i].epoch.load();
+         if (epoch < oldest) {
+             oldest = epoch;
+         }
+     }
+     return oldest;
+ }
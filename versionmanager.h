@@ -0,0 +1,95 @@
+/* File: versionmanager.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the VersionManager class, which lets query threads search the map while
+ *          a writer changes it. Readers never touch the Graph, whose nodes move and die under updates;
+ *          they search an immutable GraphVersion that the writer builds on the side and publishes with
+ *          one atomic pointer swap. A replaced version is retired and freed once every reader that could
+ *          have seen it has moved on (epoch-based reclamation), so readers take no locks and never wait.
+ *
+ */
+
+ #ifndef VERSIONMANAGER_H
+ #define VERSIONMANAGER_H
+ #include <iostream>
+ #include <vector>
+ #include <atomic>
+ #include "compactgraph.h"
+ #include "landmarks.h"
+ #include "contractionhierarchy.h"
+
+ using namespace std;
+
+ // One published state of the map: the compact view searches run on and the preprocessing built for it.
+ // Nothing in it changes once it is published. Names are read from the graph's symbol table, so the
+ // writer may change weights while versions are out but must not rename or renumber locations
+ struct GraphVersion {
+     CompactGraph compact;
+     Landmarks landmarks;
+     ContractionHierarchy hierarchy;
+     unsigned long long number; // Graph version the view was built from; route cache entries are keyed by it
+ };
+
+ // Number of reader slots a manager has unless asked for more
+ const int DEFAULT_MAX_READERS = 64;
+
+ class VersionManager {
+     public:
+         // Constructor; at most maxReaders threads can be registered at once
+         VersionManager(int maxReaders);
+
+         // Destructor; frees every version, so no reader may still be registered
+         ~VersionManager();
+
+         // Claim a reader slot for the calling thread (-1 if all are taken), and give it back
+         int registerReader();
+         void unregisterReader(int slot);
+
+         // Get the current version for the reader in slot and keep it alive until unpin (nullptr if
+         // nothing is published). Pinning costs two atomic loads and a store, unpinning one store
+         const GraphVersion* pin(int slot);
+         void unpin(int slot);
+
+         // Make version the one new pins see, taking ownership of it. The version it replaces is freed
+         // now if no reader can hold it, otherwise once the last such reader unpins and the writer calls
+         // publish or reclaim again. Only one thread may publish or reclaim at a time
+         void publish(GraphVersion* version);
+
+         // Get the version new pins see; for the writer, which needs no pin
+         const GraphVersion* current() const;
+
+         // Free the retired versions no reader can still hold, and get how many are left waiting
+         size_t reclaim();
+
+         // Wait until every retired version is freed; returns at once if no reader is pinned
+         void synchronize();
+
+     private:
+         // A reader's announced epoch, IDLE_EPOCH while it holds nothing. Slots are padded to a cache
+         // line each, so readers pinning at once do not bounce one line between cores
+         struct alignas(64) ReaderSlot {
+             atomic<unsigned long long> epoch;
+             atomic<bool> used;
+         };
+
+         // A replaced version and the epoch from which no newly pinned reader can see it
+         struct Retired {
+             GraphVersion* version;
+             unsigned long long epoch;
+         };
+
+         int numSlots;
+         ReaderSlot* slots;
+         atomic<unsigned long long> globalEpoch; // Bumped by every publish
+         atomic<GraphVersion*> published;
+         vector<Retired> retired; // Touched only by the writer
+
+         // Helper to get the oldest epoch any reader has announced (IDLE_EPOCH if none is pinned)
+         unsigned long long oldestPinned() const;
+
+         // Readers hold pointers into the manager's slots, so managers are not copied
+         VersionManager(const VersionManager& other);
+         VersionManager& operator=(const VersionManager& other);
+ };
+
+ #endif // VERSIONMANAGER_H
@@ -0,0 +1,240 @@
+/* File: vertexorder.cpp
+ * Course: CS316
+ * Program 3
+ * Purpose: the implementation of member functions for the VertexOrder class.
+ *
+ */
+
+ #include "vertexorder.h"
+ #include <algorithm>
+
+ // Orders vertices by degree, then by ID so the result does not depend on the sort
+ struct DegreeLess {
+     const CompactGraph* graph;
+
+     bool operator()(VertexId a, VertexId b) const {
+         EdgeId degreeA = graph->edgeEnd(a) - graph->edgeBegin(a);
+         EdgeId degreeB = graph->edgeEnd(b) - graph->edgeBegin(b);
+         return degreeA != degreeB ? degreeA < degreeB : a < b;
+     }
+ };
+
+ // Map a name to its ordering; false if it is not one
+ bool VertexOrder::parse(const string& name, VertexOrdering& ordering) {
+     if (name == "bfs") {
+         ordering = ORDERING_BFS;
+     } else if (name == "rcm") {
+         ordering = ORDERING_RCM;
+     } else if (name == "hilbert") {
+         ordering = ORDERING_HILBERT;
+     } else {
+         return false;
+     }
+     return true;
+ }
+
+ // Compute an ordering of the live vertices of g
+ bool VertexOrder::compute(const CompactGraph& g, VertexOrdering ordering, vector<VertexId>& order) {
+     order.clear();
+     if (ordering == ORDERING_HILBERT) {
+         if (!g.hasCoordinates()) {
+             cerr << "Error: Hilbert order needs coordinates for every location" << endl;
+             return false;
+         }
+         hilbert(g, order);
+     } else if (ordering == ORDERING_RCM) {
+         reverseCuthillMcKee(g, order);
+     } else {
+         breadthFirst(g, order);
+     }
+     return true;
+ }
+
+ // Breadth-first order from the lowest unnumbered ID of each component
+ void VertexOrder::breadthFirst(const CompactGraph& g, vector<VertexId>& order) {
+     int n = g.getNumVertices();
+     vector<unsigned char> placed(n, 0);
+     for (VertexId v = 0; v < (VertexId)n; v++) {
+         if (placed[v] || !g.isLive(v)) {
+             continue;
+         }
+
+         // The order itself is the BFS queue
+         size_t head = order.size();
+         order.push_back(v);
+         placed[v] = 1;
+         while (head < order.size()) {
+             VertexId current = order[head++];
+             for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+                 VertexId neighbor = g.edgeTarget(e);
+                 if (!placed[neighbor]) {
+                     placed[neighbor] = 1;
+                     order.push_back(neighbor);
+                 }
+             }
+         }
+     }
+ }
+
+ // Reverse Cuthill-McKee: each component is searched breadth first from a peripheral vertex, children
+ // taken in increasing degree, and the whole order is reversed. Neighbors end up within a narrow band
+ // of IDs, and reversing keeps the band from filling in towards the high-degree end
+ void VertexOrder::reverseCuthillMcKee(const CompactGraph& g, vector<VertexId>& order) {
+     int n = g.getNumVertices();
+     DegreeLess byDegree;
+     byDegree.graph = &g;
+
+     // Components are started from their lowest-degree vertex, which is usually near the rim
+     vector<VertexId> starts;
+     for (VertexId v = 0; v < (VertexId)n; v++) {
+         if (g.isLive(v)) {
+             starts.push_back(v);
+         }
+     }
+     sort(starts.begin(), starts.end(), byDegree);
+
+     vector<unsigned char> placed(n, 0);
+     vector<uint32_t> seen(n, 0);
+     uint32_t stamp = 0;
+     vector<VertexId> queue;
+     vector<VertexId> children;
+     for (size_t i = 0; i < starts.size(); i++) {
+         if (placed[starts[i]]) {
+             continue;
+         }
+         VertexId root = peripheralVertex(g, starts[i], seen, stamp, queue);
+
+         size_t head = order.size();
+         order.push_back(root);
+         placed[root] = 1;
+         while (head < order.size()) {
+             VertexId current = order[head++];
+             children.clear();
+             for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+                 VertexId neighbor = g.edgeTarget(e);
+                 if (!placed[neighbor]) {
+                     placed[neighbor] = 1;
+                     children.push_back(neighbor);
+                 }
+             }
+             sort(children.begin(), children.end(), byDegree);
+             order.insert(order.end(), children.begin(), children.end());
+         }
+     }
+     reverse(order.begin(), order.end());
+ }
+
+ // Helper to find a vertex of high eccentricity in the component of start: search breadth first,
+ // move to the lowest-degree vertex of the last level, and stop once the depth no longer grows
+ VertexId VertexOrder::peripheralVertex(const CompactGraph& g, VertexId start, vector<uint32_t>& seen,
+                                        uint32_t& stamp, vector<VertexId>& queue) {
+     DegreeLess byDegree;
+     byDegree.graph = &g;
+     VertexId root = start;
+     int eccentricity = -1;
+     while (true) {
+         // Search level by level; a new stamp unmarks every vertex of earlier searches
+         stamp++;
+         queue.clear();
+         queue.push_back(root);
+         seen[root] = stamp;
+         int depth = 0;
+         size_t levelStart = 0;
+         size_t lastLevel = 0;
+         while (levelStart < queue.size()) {
+             lastLevel = levelStart;
+             size_t levelEnd = queue.size();
+             for (size_t i = levelStart; i < levelEnd; i++) {
+                 VertexId current = queue[i];
+                 for (EdgeId e = g.edgeBegin(current); e < g.edgeEnd(current); e++) {
+                     VertexId neighbor = g.edgeTarget(e);
+                     if (seen[neighbor] != stamp) {
+                         seen[neighbor] = stamp;
+                         queue.push_back(neighbor);
+                     }
+                 }
+             }
+             levelStart = levelEnd;
+             if (levelStart < queue.size()) {
+                 depth++;
+             }
+         }
+         if (depth <= eccentricity) {
+             return root;
+         }
+         eccentricity = depth;
+
+         // The next try starts from the farthest vertex with the fewest neighbors
+         VertexId candidate = *min_element(queue.begin() + lastLevel, queue.end(), byDegree);
+         if (candidate == root) {
+             return root;
+         }
+         root = candidate;
+     }
+ }
+
+ // Order by position along a Hilbert curve through the coordinates, which keeps vertices that are
+ // close in the plane close in the order without looking at the edges
+ void VertexOrder::hilbert(const CompactGraph& g, vector<VertexId>& order) {
+     int n = g.getNumVertices();
+     double minX = 0.0;
+     double maxX = 0.0;
+     double minY = 0.0;
+     double maxY = 0.0;
+     bool first = true;
+     for (VertexId v = 0; v < (VertexId)n; v++) {
+         if (!g.isLive(v)) {
+             continue;
+         }
+         if (first || g.getX(v) < minX) {
+             minX = g.getX(v);
+         }
+         if (first || g.getX(v) > maxX) {
+             maxX = g.getX(v);
+         }
+         if (first || g.getY(v) < minY) {
+             minY = g.getY(v);
+         }
+         if (first || g.getY(v) > maxY) {
+             maxY = g.getY(v);
+         }
+         first = false;
+     }
+
+     // Snap the coordinates to the curve's grid
+     double cells = (double)((1u << HILBERT_BITS) - 1);
+     double scaleX = (maxX > minX) ? cells / (maxX - minX) : 0.0;
+     double scaleY = (maxY > minY) ? cells / (maxY - minY) : 0.0;
+     vector<pair<uint64_t, VertexId> > keyed;
+     for (VertexId v = 0; v < (VertexId)n; v++) {
+         if (g.isLive(v)) {
+             uint32_t x = (uint32_t)((g.getX(v) - minX) * scaleX);
+             uint32_t y = (uint32_t)((g.getY(v) - minY) * scaleY);
+             keyed.push_back(make_pair(hilbertIndex(x, y), v));
+         }
+     }
+     sort(keyed.begin(), keyed.end());
+     for (size_t i = 0; i < keyed.size(); i++) {
+         order.push_back(keyed[i].second);
+     }
+ }
+
+ // Helper to get the distance along the Hilbert curve of a point on the 2^HILBERT_BITS grid: each
+ // level picks one of four quadrants, then rotates the point into that quadrant's frame
+ uint64_t VertexOrder::hilbertIndex(uint32_t x, uint32_t y) {
+     uint32_t side = 1u << HILBERT_BITS;
+     uint64_t index = 0;
+     for (uint32_t s = side / 2; s > 0; s /= 2) {
+         uint32_t rx = (x & s) ? 1 : 0;
+         uint32_t ry = (y & s) ? 1 : 0;
+         index += (uint64_t)s * s * ((3 * rx) ^ ry);
+         if (ry == 0) {
+             if (rx == 1) {
+                 x = side - 1 - x;
+                 y = side - 1 - y;
+             }
+             swap(x, y);
+         }
+     }
+     return index;
+ }
@@ -0,0 +1,53 @@
+/* File: vertexorder.h
+ * Course: CS316
+ * Program 3
+ * Purpose: the declaration for the VertexOrder class, which computes locality-preserving vertex
+ *          numberings of a compact graph. Vertex IDs follow load order, which says nothing about
+ *          where a vertex sits in the graph; renumbering so that neighbors get nearby IDs puts their
+ *          labels and arc lists close together in memory, so searches miss the cache less often.
+ *
+ */
+
+ #ifndef VERTEXORDER_H
+ #define VERTEXORDER_H
+ #include <iostream>
+ #include <vector>
+ #include <string>
+ #include "compactgraph.h"
+
+ using namespace std;
+
+ // Numberings VertexOrder can compute
+ enum VertexOrdering {
+     ORDERING_BFS,     // Breadth-first order, one component after another
+     ORDERING_RCM,     // Reverse Cuthill-McKee: BFS from a peripheral vertex, low degrees first, reversed
+     ORDERING_HILBERT  // Position along a Hilbert curve through the coordinates
+ };
+
+ // Bits per axis of the grid that coordinates are snapped to for the Hilbert curve
+ const int HILBERT_BITS = 16;
+
+ class VertexOrder {
+     public:
+         // Map a name (bfs, rcm or hilbert) to its ordering; false if it is not one
+         static bool parse(const string& name, VertexOrdering& ordering);
+
+         // Compute an ordering of the live vertices of g: order[i] is the vertex that should get ID i.
+         // False if the ordering needs coordinates the graph does not have
+         static bool compute(const CompactGraph& g, VertexOrdering ordering, vector<VertexId>& order);
+
+     private:
+         // Helpers for each ordering
+         static void breadthFirst(const CompactGraph& g, vector<VertexId>& order);
+         static void reverseCuthillMcKee(const CompactGraph& g, vector<VertexId>& order);
+         static void hilbert(const CompactGraph& g, vector<VertexId>& order);
+
+         // Helper to find a vertex of high eccentricity in the component of start (George and Liu)
+         static VertexId peripheralVertex(const CompactGraph& g, VertexId start, vector<uint32_t>& seen,
+                                          uint32_t& stamp, vector<VertexId>& queue);
+
+         // Helper to get the distance along the Hilbert curve of a point on the 2^HILBERT_BITS grid
+         static uint64_t hilbertIndex(uint32_t x, uint32_t y);
+ };
+
+ #endif // VERTEXORDER_H